@@ -0,0 +1,54 @@
+/**
+ * @file adcin.c
+ * @brief ADC1 scan of all analog inputs into RAM by DMA, started from TIM6.
+ *
+ * None of the F030 ADC trigger sources is TIM6, so the scan is started in
+ * software from the modulation ISR. A scan of seven channels at 1.5 cycles
+ * sampling takes 7 x 14 = 98 ADC clocks (7 us at 14 MHz), far inside the
+ * 200 us sample period, so the results of the previous scan are always
+ * complete when the ISR reads them.
+ */
+
+#include "adcin.h"
+#include "adc.h"
+#include "stm32f0xx_hal.h"
+
+volatile uint16_t adcin_raw[ADCIN_COUNT];
+
+void AdcIn_Init(void)
+{
+    // calibration needs the ADC disabled
+    if (ADC1->CR & ADC_CR_ADEN)
+    {
+        ADC1->CR |= ADC_CR_ADDIS;
+        while (ADC1->CR & ADC_CR_ADEN)
+            ;
+    }
+    ADC1->CR |= ADC_CR_ADCAL;
+    while (ADC1->CR & ADC_CR_ADCAL)
+        ;
+
+    // DMA1 channel 1: ADC1->DR -> adcin_raw[], 16 bit, circular
+    __HAL_RCC_DMA1_CLK_ENABLE();
+    DMA1_Channel1->CCR   = 0;
+    DMA1_Channel1->CPAR  = (uint32_t)&ADC1->DR;
+    DMA1_Channel1->CMAR  = (uint32_t)adcin_raw;
+    DMA1_Channel1->CNDTR = ADCIN_COUNT;
+    DMA1_Channel1->CCR   = DMA_CCR_MINC | DMA_CCR_CIRC |
+                           DMA_CCR_PSIZE_0 | DMA_CCR_MSIZE_0 | DMA_CCR_EN;
+
+    // DMA requests in circular mode, one scan per start
+    ADC1->CFGR1 |= ADC_CFGR1_DMAEN | ADC_CFGR1_DMACFG;
+
+    ADC1->ISR = ADC_ISR_ADRDY;
+    ADC1->CR |= ADC_CR_ADEN;
+    while (!(ADC1->ISR & ADC_ISR_ADRDY))
+        ;
+}
+
+void AdcIn_Trigger(void)
+{
+    // a scan still running means the sample period is badly overrun; skip
+    if (!(ADC1->CR & ADC_CR_ADSTART))
+        ADC1->CR |= ADC_CR_ADSTART;
+}
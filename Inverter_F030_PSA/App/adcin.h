@@ -0,0 +1,46 @@
+#ifndef ADCIN_H
+#define ADCIN_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Analog inputs, one scan of all channels per modulation sample.
+//
+// The TIM6 ISR starts a scan (AdcIn_Trigger); DMA1 channel 1 copies the seven
+// results into adcin_raw[] in circular mode, so the ISR reads the values of
+// the previous scan, 200 us old, without waiting for the ADC. The order is
+// the ascending channel order set up by MX_ADC_Init().
+
+typedef enum {
+    ADCIN_BAT_V = 0,    // IN0  PA0
+    ADCIN_BAT_GND,      // IN1  PA1
+    ADCIN_BAT_TEMP,     // IN2  PA2
+    ADCIN_U_IN,         // IN3  PA3
+    ADCIN_30V,          // IN6  PA6
+    ADCIN_BAT_LOAD,     // IN7  PA7
+    ADCIN_U_OUT,        // IN9  PB1
+    ADCIN_COUNT
+} AdcIn_Channel_t;
+
+extern volatile uint16_t adcin_raw[ADCIN_COUNT];
+
+// Calibrate and enable ADC1, set up the DMA; call after MX_ADC_Init()
+void AdcIn_Init(void);
+
+// Start one scan (TIM6 ISR)
+void AdcIn_Trigger(void);
+
+// Latest 12-bit result of a channel
+static inline uint16_t AdcIn_Get(AdcIn_Channel_t ch)
+{
+    return adcin_raw[ch];
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ADCIN_H
@@ -0,0 +1,276 @@
+/**
+ * @file battery.c
+ * @brief Differential, load-compensated battery voltage; UVLO and early warning.
+ *
+ * The TIM6 ISR adds every scan into sums; Battery_Poll() takes them every
+ * BATTERY_PERIOD_MS, five whole mains periods, so the 100 Hz ripple of the
+ * battery current averages out. While TIM6 is stopped there are no ISR
+ * scans and the poll starts one itself, as Thermal_Poll() does.
+ *
+ * Internal resistance: when the mean current of two successive polls
+ * differs by at least BATTERY_STEP_MA, -dV/dI of the two is a resistance
+ * sample; plausible samples are filtered 1/4 into the estimate. The trend
+ * of the compensated voltage is its drop over BATTERY_TREND_S, filtered;
+ * time left is the margin to BATTERY_UVLO_MV over that rate.
+ */
+
+#include "battery.h"
+#include "adcin.h"
+#include "sinegen.h"
+#include "telemetry.h"
+#include "stm32f0xx_hal.h"
+
+#define SUM_MAX     4096            // samples per sum (keeps sum << 4 in 32 bit)
+#define VF_SHIFT    3               // compensated voltage filter, 2^n polls
+
+static volatile uint32_t sum_v, sum_i, sum_n;
+
+static uint32_t       last_poll;
+static uint32_t       last_status;
+static uint32_t       polls;
+static int32_t        v_mv;         // terminal voltage
+static int32_t        i_ma;
+static int32_t        vc_mv;        // compensated voltage
+static int32_t        vf;           // compensated, filtered << VF_SHIFT
+static int32_t        r_int = BATTERY_R_DEFAULT;
+static int32_t        trend_ref;    // vf BATTERY_TREND_S ago, mV
+static int32_t        drop;         // filtered drop per BATTERY_TREND_S, mV
+static uint16_t       time_left = BATTERY_TIME_UNKNOWN;
+static uint8_t        low_count;
+static uint8_t        have_prev;
+static BatteryState_t bstate;
+
+void Battery_Sample(uint16_t v, uint16_t gnd, uint16_t i)
+{
+    if (sum_n >= SUM_MAX)
+        return;
+    sum_v += (v > gnd) ? (uint32_t)(v - gnd) : 0;
+    sum_i += i;
+    sum_n++;
+}
+
+static void Send_Event(BatteryEvent_t ev)
+{
+    uint8_t p[TELEMETRY_PAYLOAD];
+    p[0] = (uint8_t)ev;
+    p[1] = (uint8_t)bstate;
+    Telemetry_Put16(&p[2], (uint16_t)v_mv);
+    Telemetry_Put16(&p[4], (uint16_t)vc_mv);
+    Telemetry_Put16(&p[6], time_left);
+    Telemetry_Send(TELEMETRY_BATTERY_EVENT, p);
+}
+
+static void Send_Status(void)
+{
+    uint8_t p[TELEMETRY_PAYLOAD];
+    Telemetry_Put16(&p[0], (uint16_t)vc_mv);
+    Telemetry_Put16(&p[2], (uint16_t)i_ma);
+    Telemetry_Put16(&p[4], (uint16_t)r_int);
+    // time left in 10 s, 255 = unknown or longer
+    p[6] = (time_left >= 2550) ? 255 : (uint8_t)(time_left / 10);
+    p[7] = (uint8_t)bstate;
+    Telemetry_Send(TELEMETRY_BATTERY, p);
+}
+
+// Mean codes << 4 of the sums since the last poll, or of one fresh scan
+static void Read(uint32_t *v_q4, uint32_t *i_q4)
+{
+    __disable_irq();
+    uint32_t sv = sum_v, si = sum_i, n = sum_n;
+    sum_v = sum_i = sum_n = 0;
+    __enable_irq();
+
+    if (n == 0)
+    {
+        // no ISR scans: read the last one, start the next
+        uint16_t v = AdcIn_Get(ADCIN_BAT_V), gnd = AdcIn_Get(ADCIN_BAT_GND);
+        sv = (v > gnd) ? (uint32_t)(v - gnd) : 0;
+        si = AdcIn_Get(ADCIN_BAT_LOAD);
+        n  = 1;
+        AdcIn_Trigger();
+    }
+    *v_q4 = (sv << 4) / n;
+    *i_q4 = (si << 4) / n;
+}
+
+static void Measure(void)
+{
+    uint32_t v_q4, i_q4;
+    Read(&v_q4, &i_q4);
+
+    int32_t v = (int32_t)((v_q4 * BATTERY_MV_FULL) >> 16);
+    int32_t i = (int32_t)((i_q4 * BATTERY_MA_FULL) >> 16);
+
+    if (have_prev)
+    {
+        int32_t di = i - i_ma;
+        if (di >= BATTERY_STEP_MA || di <= -BATTERY_STEP_MA)
+        {
+            int32_t r = -(v - v_mv) * 10000 / di;
+            if (r > 0 && r <= BATTERY_R_MAX)
+                r_int += (r - r_int) / 4;
+        }
+    }
+    have_prev = 1;
+
+    v_mv  = v;
+    i_ma  = i;
+    vc_mv = v + i * r_int / 10000;
+}
+
+static void Trend(void)
+{
+    vf += vc_mv - (vf >> VF_SHIFT);
+    if (++polls < (BATTERY_TREND_S * 1000u) / BATTERY_PERIOD_MS)
+        return;
+    polls = 0;
+
+    int32_t now = vf >> VF_SHIFT;
+    drop += (trend_ref - now - drop) / 4;
+    trend_ref = now;
+
+    if (now <= BATTERY_UVLO_MV)
+    {
+        time_left = 0;
+    }
+    else if (drop <= 0)
+    {
+        time_left = BATTERY_TIME_UNKNOWN;
+    }
+    else
+    {
+        uint32_t t = (uint32_t)(now - BATTERY_UVLO_MV) * BATTERY_TREND_S / (uint32_t)drop;
+        time_left = (uint16_t)(t >= BATTERY_TIME_UNKNOWN ? BATTERY_TIME_UNKNOWN - 1 : t);
+    }
+}
+
+static void Lockout(BatteryEvent_t ev)
+{
+    bstate    = BATTERY_LOCKOUT;
+    low_count = 0;
+    SineGen_Stop();
+    Send_Event(ev);
+}
+
+void Battery_Init(void)
+{
+    __disable_irq();
+    sum_v = sum_i = sum_n = 0;
+    __enable_irq();
+
+    // first reading from a scan of our own
+    AdcIn_Trigger();
+    HAL_Delay(1);
+    have_prev = 0;
+    Measure();
+
+    vf          = vc_mv << VF_SHIFT;
+    trend_ref   = vc_mv;
+    drop        = 0;
+    polls       = 0;
+    time_left   = BATTERY_TIME_UNKNOWN;
+    low_count   = 0;
+    last_poll   = HAL_GetTick();
+    last_status = last_poll;
+
+    bstate = BATTERY_OK;
+    if (vc_mv < BATTERY_UVLO_MV)
+        Lockout(BATTERY_EV_UVLO);
+}
+
+void Battery_Poll(void)
+{
+    uint32_t now = HAL_GetTick();
+    if (now - last_poll < BATTERY_PERIOD_MS)
+        return;
+    last_poll = now;
+
+    Measure();
+    Trend();
+
+    switch (bstate)
+    {
+    case BATTERY_OK:
+    case BATTERY_WARN:
+        if (v_mv < BATTERY_CUTOFF_MV)
+        {
+            Lockout(BATTERY_EV_CUTOFF);
+            break;
+        }
+        if (vc_mv < BATTERY_UVLO_MV)
+        {
+            if (++low_count >= BATTERY_UVLO_POLLS)
+            {
+                Lockout(BATTERY_EV_UVLO);
+                break;
+            }
+        }
+        else
+        {
+            low_count = 0;
+        }
+
+        if (bstate == BATTERY_OK &&
+            (vc_mv < BATTERY_WARN_MV || time_left < BATTERY_WARN_S))
+        {
+            bstate = BATTERY_WARN;
+            Send_Event(BATTERY_EV_WARN);
+        }
+        else if (bstate == BATTERY_WARN &&
+                 vc_mv >= BATTERY_WARN_MV + BATTERY_WARN_HYST_MV && time_left >= 2 * BATTERY_WARN_S)
+        {
+            bstate = BATTERY_OK;
+            Send_Event(BATTERY_EV_CLEAR);
+        }
+        break;
+
+    case BATTERY_LOCKOUT:
+        if (vc_mv >= BATTERY_RESTART_MV)
+        {
+            bstate = BATTERY_OK;
+            Send_Event(BATTERY_EV_CLEAR);
+        }
+        break;
+    }
+
+    if (now - last_status >= BATTERY_STATUS_MS)
+    {
+        last_status = now;
+        Send_Status();
+    }
+}
+
+uint16_t Battery_GetVoltage(void)
+{
+    return (uint16_t)v_mv;
+}
+
+uint16_t Battery_GetCompensated(void)
+{
+    return (uint16_t)vc_mv;
+}
+
+uint16_t Battery_GetCurrent(void)
+{
+    return (uint16_t)i_ma;
+}
+
+uint16_t Battery_GetResistance(void)
+{
+    return (uint16_t)r_int;
+}
+
+uint16_t Battery_GetTimeLeft(void)
+{
+    return time_left;
+}
+
+BatteryState_t Battery_GetState(void)
+{
+    return bstate;
+}
+
+uint8_t Battery_Lockout(void)
+{
+    return bstate == BATTERY_LOCKOUT;
+}
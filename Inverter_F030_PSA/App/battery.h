@@ -0,0 +1,109 @@
+#ifndef BATTERY_H
+#define BATTERY_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Battery supervisor: undervoltage lockout with a warning ahead of it.
+//
+// The battery voltage is read differentially (ADC_BAT_V - ADC_BAT_GND), so
+// the drop in the negative lead does not count, and averaged over whole
+// mains periods together with ADC_BAT_LOAD. The internal resistance is
+// estimated from the voltage change across load steps; the voltage plus
+// I * R (the load-compensated or rest voltage) is what the thresholds see,
+// so a load surge does not trip the lockout and a light load does not hide
+// a flat battery. From the trend of that voltage the time left until
+// BATTERY_UVLO_MV is predicted.
+//
+// BATTERY_WARN: compensated voltage below BATTERY_WARN_MV, or the lockout
+// predicted within BATTERY_WARN_S; sent as a telemetry event so the
+// display side can announce the coming stop.
+// BATTERY_LOCKOUT: compensated voltage below BATTERY_UVLO_MV for
+// BATTERY_UVLO_POLLS polls, or the terminal voltage below
+// BATTERY_CUTOFF_MV once: soft stop, SineGen_Start() refused until the
+// voltage is back above BATTERY_RESTART_MV (charged, not just recovered).
+//
+// Thresholds are placeholders for a 12 V lead-acid battery.
+
+// Battery_Poll() works at this interval (ms, a whole number of periods)
+#define BATTERY_PERIOD_MS       100
+// Battery voltage for a full-scale ADC_BAT_V - ADC_BAT_GND reading (mV,
+// placeholder until matched to the divider)
+#define BATTERY_MV_FULL         20000
+// Battery current for a full-scale ADC_BAT_LOAD reading (mA, 0.1 V/A)
+#define BATTERY_MA_FULL         33000
+
+// Internal resistance (0.1 mOhm): start value, plausible range, and the
+// smallest load step (mA) between two polls that updates the estimate
+#define BATTERY_R_DEFAULT       200
+#define BATTERY_R_MAX           2000
+#define BATTERY_STEP_MA         2000
+
+// Thresholds on the compensated voltage (mV)
+#define BATTERY_WARN_MV         11200
+#define BATTERY_WARN_HYST_MV    200
+#define BATTERY_UVLO_MV         10500
+#define BATTERY_RESTART_MV      12200
+#define BATTERY_UVLO_POLLS      5
+// Terminal voltage at which to stop at once, whatever the load (mV)
+#define BATTERY_CUTOFF_MV       9500
+
+// Warning when the lockout is predicted within this time (s); the trend
+// is taken over BATTERY_TREND_S
+#define BATTERY_WARN_S          120
+#define BATTERY_TREND_S         10
+
+// Telemetry status frame interval (ms)
+#define BATTERY_STATUS_MS       500
+
+typedef enum {
+    BATTERY_OK = 0,
+    BATTERY_WARN,
+    BATTERY_LOCKOUT,
+} BatteryState_t;
+
+// Event byte of a TELEMETRY_BATTERY_EVENT frame
+typedef enum {
+    BATTERY_EV_CLEAR = 0,           // back to BATTERY_OK
+    BATTERY_EV_WARN,                // soft stop ahead
+    BATTERY_EV_UVLO,                // stopped, compensated voltage
+    BATTERY_EV_CUTOFF,              // stopped, terminal voltage
+} BatteryEvent_t;
+
+// Time left unknown (no falling trend)
+#define BATTERY_TIME_UNKNOWN    0xFFFF
+
+// Takes a first reading, locked out if already below BATTERY_UVLO_MV;
+// call after AdcIn_Init() and Telemetry_Init(), before SineGen_Start()
+void Battery_Init(void);
+
+// Called from SineGen_Update() with the readings of each scan
+void Battery_Sample(uint16_t v, uint16_t gnd, uint16_t i);
+
+// Main loop: every BATTERY_PERIOD_MS updates the estimate and the state
+void Battery_Poll(void);
+
+// Terminal and compensated voltage (mV), current (mA)
+uint16_t Battery_GetVoltage(void);
+uint16_t Battery_GetCompensated(void);
+uint16_t Battery_GetCurrent(void);
+
+// Internal resistance estimate, 0.1 mOhm
+uint16_t Battery_GetResistance(void);
+
+// Predicted time to BATTERY_UVLO_MV (s), BATTERY_TIME_UNKNOWN if not falling
+uint16_t Battery_GetTimeLeft(void);
+
+BatteryState_t Battery_GetState(void);
+
+// Non-zero while SineGen_Start() is refused
+uint8_t Battery_Lockout(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BATTERY_H
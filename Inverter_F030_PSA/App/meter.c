@@ -0,0 +1,255 @@
+/**
+ * @file meter.c
+ * @brief Per-period output power, power factor and energy from ADC_U_OUT and
+ *        ADC_BAT_LOAD.
+ *
+ * Per sample the ISR adds (u - METER_U_BIAS) and its square, the current,
+ * and the current times sin and cos of 2 theta (table index
+ * 2 * (idx - METER_I_DELAY)), the products >> 4 so a period fits 32 bits.
+ * At the last index of a period the sums are copied out for Meter_Poll();
+ * a period that started part way through is dropped.
+ *
+ * Meter_Poll() does the rest in 64-bit arithmetic: the magnitude of the
+ * 2 theta component by integer square root, cos phi from its phase, and
+ * the clipping correction from two 17-point tables over cos phi:
+ *
+ *     g1   = ((pi - a) + cos phi sin a) / pi     2 theta amplitude / b
+ *     clip = (cos phi (pi - a) + sin a) / pi - cos phi
+ *                                                missing mean / b
+ *
+ * with a = acos(cos phi) the angle over which the sense reads 0. Against
+ * the host plant (host/f030/test/test_meter.cpp), P as against the power
+ * taken from the battery: +2.3 % at 10 ohm, -0.1 % at 3 ohm, +0.8 % on a
+ * 5 ohm lamp; +9.5 % on 10 ohm / 20 mH and -8.7 % on a 10 ohm rectifier
+ * load, +20 % at 20 ohm (harmonics outside the model). U_rms within 0.1 %.
+ * The plain mean reads 15 % high at 10 ohm, 42 % on the R-L load.
+ */
+
+#include "meter.h"
+#include "sinegen.h"
+#include "battery.h"
+#include "telemetry.h"
+#include "stm32f0xx_hal.h"
+
+#include <string.h>
+
+typedef struct {
+    int32_t  su;                    // sum of u - METER_U_BIAS
+    uint32_t suu;                   // sum of its square
+    uint32_t si;                    // sum of i
+    int32_t  ss, sc;                // sum of i sin / cos 2 theta, >> 4
+    uint32_t n;
+} MeterSums_t;
+
+// g1 and clip (Q15) at cos phi = 0, 1/16 ... 1
+static const uint16_t g1_table[] = {
+    16384, 17686, 18984, 20272, 21544, 22795, 24019, 25210, 26361,
+    27465, 28514, 29497, 30403, 31216, 31914, 32463, 32767,
+};
+static const uint16_t clip_table[] = {
+    10430,  9426,  8464,  7542,  6662,  5824,  5029,  4277,  3572,
+     2913,  2303,  1746,  1245,   806,   437,   154,     0,
+};
+
+static const MeterSums_t zero;
+static int16_t           ref_sin[SINE_SAMPLES];
+static MeterSums_t       acc;
+static MeterSums_t       done;
+static volatile uint8_t  ready;
+
+static Meter_t  res;
+static uint64_t energy_uj;
+static uint32_t last_cycle;
+static uint32_t last_energy;
+static uint32_t last_status;
+
+void Meter_Init(void)
+{
+    SineGen_BuildShape(ref_sin, SINE_SHAPE_SINE, 0);
+
+    __disable_irq();
+    acc   = zero;
+    ready = 0;
+    __enable_irq();
+
+    memset(&res, 0, sizeof(res));
+    last_cycle  = HAL_GetTick();
+    last_energy = last_cycle;
+    last_status = last_cycle;
+}
+
+void Meter_Sample(uint16_t u_out, uint16_t i_bat, uint32_t idx)
+{
+    int32_t u = (int32_t)u_out - METER_U_BIAS;
+    acc.su  += u;
+    acc.suu += (uint32_t)(u * u);
+    acc.si  += i_bat;
+
+    // 2 theta of the duty behind this reading
+    uint32_t k = (idx >= METER_I_DELAY) ? idx - METER_I_DELAY : idx + SINE_SAMPLES - METER_I_DELAY;
+    uint32_t s = 2 * k;
+    if (s >= SINE_SAMPLES)
+        s -= SINE_SAMPLES;
+    uint32_t c = s + SINE_SAMPLES / 4;
+    if (c >= SINE_SAMPLES)
+        c -= SINE_SAMPLES;
+    acc.ss += ((int32_t)i_bat * ref_sin[s]) >> 4;
+    acc.sc += ((int32_t)i_bat * ref_sin[c]) >> 4;
+    acc.n++;
+
+    if (idx == SINE_SAMPLES - 1)
+    {
+        if (acc.n == SINE_SAMPLES)
+        {
+            done  = acc;
+            ready = 1;
+        }
+        acc = zero;
+    }
+}
+
+static uint32_t Isqrt64(uint64_t x)
+{
+    uint64_t r = 0;
+    for (uint64_t bit = 1ull << 62; bit != 0; bit >>= 2)
+    {
+        if (x >= r + bit)
+        {
+            x -= r + bit;
+            r = (r >> 1) + bit;
+        }
+        else
+        {
+            r >>= 1;
+        }
+    }
+    return (uint32_t)r;
+}
+
+// Linear interpolation in a 17-point table over cos phi (Q15)
+static uint32_t Table16(const uint16_t *t, uint32_t cos_q15)
+{
+    uint32_t i = cos_q15 >> 11;
+    if (i >= 16)
+        return t[16];
+    uint32_t f = cos_q15 & 0x7FF;
+    return (uint32_t)(((int32_t)t[i] * 2048 + ((int32_t)t[i + 1] - t[i]) * (int32_t)f) >> 11);
+}
+
+static void Evaluate(const MeterSums_t *m)
+{
+    // output voltage: variance about the period mean, in codes^2 << 8
+    int64_t  mean = ((int64_t)m->su << 8) / SINE_SAMPLES;
+    uint64_t var  = (((uint64_t)m->suu << 8) - (uint64_t)((m->su * mean))) / SINE_SAMPLES;
+    uint32_t u_q4 = Isqrt64(var);                           // RMS code << 4
+    uint32_t u_mv = (uint32_t)(((uint64_t)u_q4 * METER_U_FULL_MV) >> 16);
+
+    // 2 theta component: |(sc, ss)| = b * g1 * SINE_SAMPLES * 1024
+    uint32_t mag = Isqrt64((uint64_t)((int64_t)m->sc * m->sc) + (uint64_t)((int64_t)m->ss * m->ss));
+    uint32_t v   = Battery_GetVoltage();
+
+    memset(&res, 0, sizeof(res));
+    res.u_rms = (uint16_t)(u_mv / 10);
+    if (mag == 0)
+        return;
+
+    uint32_t cos_q15 = (m->sc < 0) ? (uint32_t)(((uint64_t)(-m->sc) << 15) / mag) : 0;
+    if (cos_q15 > 32767)
+        cos_q15 = 32767;
+
+    // b and the real power current, codes << 4
+    uint64_t b_q4 = ((uint64_t)mag << 9) / ((uint64_t)SINE_SAMPLES * Table16(g1_table, cos_q15));
+    int64_t  a_q4 = ((int64_t)m->si << 4) / SINE_SAMPLES - (int64_t)((b_q4 * Table16(clip_table, cos_q15)) >> 15);
+    if (a_q4 < 0)
+        a_q4 = 0;
+
+    // mW and mVA: mV * (codes << 4) * BATTERY_MA_FULL / 65536 / 1000
+    res.p = (uint32_t)(((uint64_t)v * (uint64_t)a_q4 * BATTERY_MA_FULL >> 16) / 1000u);
+    res.s = (uint32_t)(((uint64_t)v * b_q4 * BATTERY_MA_FULL >> 16) / 1000u);
+    if (res.p > res.s)
+        res.p = res.s;
+    if (res.s != 0)
+    {
+        int32_t pf = (int32_t)(((uint64_t)res.p << 15) / res.s);
+        if (pf > 32767)
+            pf = 32767;
+        // sin phi = -ss / mag: current lagging for ss < 0
+        res.pf = (int16_t)(m->ss > 0 ? -pf : pf);
+    }
+    if (u_mv != 0)
+    {
+        uint32_t i = (uint32_t)(((uint64_t)res.s * 1000u) / u_mv);
+        res.i_rms = (uint16_t)(i > 0xFFFF ? 0xFFFF : i);
+    }
+}
+
+static void Send_Status(void)
+{
+    uint8_t p[TELEMETRY_PAYLOAD];
+    // 0.1 W, 0.1 VA, 10 mV, PF in 1/100
+    uint32_t pw = res.p / 100, sva = res.s / 100;
+    Telemetry_Put16(&p[0], (uint16_t)(pw > 0xFFFF ? 0xFFFF : pw));
+    Telemetry_Put16(&p[2], (uint16_t)(sva > 0xFFFF ? 0xFFFF : sva));
+    Telemetry_Put16(&p[4], res.u_rms);
+    p[6] = (uint8_t)(int8_t)((res.pf * 100) / 32767);
+    p[7] = 0;
+    Telemetry_Send(TELEMETRY_METER, p);
+
+    // energy in 0.1 Wh, output current
+    uint64_t dwh = energy_uj / 360000000ull;
+    Telemetry_Put32(&p[0], (uint32_t)(dwh > 0xFFFFFFFFull ? 0xFFFFFFFFull : dwh));
+    Telemetry_Put16(&p[4], res.i_rms);
+    p[6] = 0;
+    p[7] = 0;
+    Telemetry_Send(TELEMETRY_ENERGY, p);
+}
+
+void Meter_Poll(void)
+{
+    uint32_t now = HAL_GetTick();
+
+    if (ready)
+    {
+        MeterSums_t m;
+        __disable_irq();
+        m     = done;
+        ready = 0;
+        __enable_irq();
+        Evaluate(&m);
+        last_cycle = now;
+    }
+    else if (now - last_cycle > METER_STALE_MS)
+    {
+        memset(&res, 0, sizeof(res));
+    }
+
+    // mW * ms = uJ
+    energy_uj  += (uint64_t)res.p * (now - last_energy);
+    last_energy = now;
+
+    if (now - last_status >= METER_STATUS_MS)
+    {
+        last_status = now;
+        Send_Status();
+    }
+}
+
+void Meter_Get(Meter_t *m)
+{
+    *m = res;
+}
+
+uint32_t Meter_GetEnergyWh(void)
+{
+    return (uint32_t)(energy_uj / 3600000000ull);
+}
+
+uint64_t Meter_GetEnergyMj(void)
+{
+    return energy_uj / 1000u;
+}
+
+void Meter_ResetEnergy(void)
+{
+    energy_uj = 0;
+}
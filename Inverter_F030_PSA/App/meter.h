@@ -0,0 +1,75 @@
+#ifndef METER_H
+#define METER_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Output metering: RMS voltage, real and apparent power, power factor and
+// energy, once per sine period.
+//
+// The board has no output current sensor; ADC_BAT_LOAD sees the battery
+// side of the bridge, i_bat = d * i_out with d the duty of the table index.
+// For i_out = I sin(theta - phi) that is
+//
+//     i_bat = b (cos phi - cos(2 theta - phi)),    b = m I / 2
+//
+// so its mean is the real power current and its 2 theta component, found
+// by correlation with the sine table at twice the index, carries b and
+// phi. The sense is unipolar: the parts of i_bat below zero (reactive
+// current flowing back) read 0. The phase of the 2 theta component is not
+// affected by that, and from cos phi the clipped area is estimated and
+// taken off the mean. P = Vbat * mean, S = Vbat * b, PF = P / S, all on the
+// battery side (bridge and filter losses included); ADC_U_OUT gives the
+// RMS output voltage and S / U_rms the output current.
+//
+// The ISR part (Meter_Sample()) has a fixed cost: five accumulators, two
+// table reads, no division and no loop; everything else, square roots and
+// divisions, runs in Meter_Poll().
+
+// Updates from a CCR write to its effect on the ADC_BAT_LOAD reading (one
+// for the scan, one for the CCR preload), as RC_DELAY for ADC_U_OUT
+#define METER_I_DELAY       2
+// ADC_U_OUT code for 0 V output, and output voltage for a full-scale code
+// span (mV; 0.05 V/V placeholder until matched to the divider)
+#define METER_U_BIAS        2048
+#define METER_U_FULL_MV     66000
+// Without a finished period for this long the bridge is off: all zero (ms)
+#define METER_STALE_MS      100
+// Telemetry interval (ms)
+#define METER_STATUS_MS     1000
+
+typedef struct {
+    uint16_t u_rms;             // output voltage, 10 mV
+    uint16_t i_rms;             // output current, S / u_rms, mA
+    uint32_t p;                 // real power, mW
+    uint32_t s;                 // apparent power, mVA
+    int16_t  pf;                // P / S, Q15; negative when the current leads
+} Meter_t;
+
+// Builds the reference table; call before the first SineGen_Update()
+void Meter_Init(void);
+
+// Called from SineGen_Update() with the scan readings and the table index
+// about to be written
+void Meter_Sample(uint16_t u_out, uint16_t i_bat, uint32_t idx);
+
+// Main loop: evaluates a finished period, integrates the energy, sends
+// TELEMETRY_METER frames
+void Meter_Poll(void);
+
+// Results of the last period
+void Meter_Get(Meter_t *m);
+
+// Energy since Meter_ResetEnergy() (Wh, and the full count in mJ)
+uint32_t Meter_GetEnergyWh(void);
+uint64_t Meter_GetEnergyMj(void);
+void     Meter_ResetEnergy(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // METER_H
@@ -0,0 +1,119 @@
+/**
+ * @file overload.c
+ * @brief I^2t overload model with derating ahead of the trip.
+ *
+ * ADC_BAT_LOAD is squared and summed every update; once per period the
+ * mean square, scaled so that 1.0 is the trip level, is filtered into theta
+ * (Q24). All scaling is prepared by Overload_SetCurve(), the period step
+ * needs a division by SINE_SAMPLES and one for the derating slope only.
+ * theta runs on while the bridge is off as long as TIM6 does (mains
+ * tracking or load search), so the model cools; with TIM6 stopped it holds,
+ * which errs on the safe side.
+ */
+
+#include "overload.h"
+#include "sinegen.h"
+#include "stm32f0xx_hal.h"
+
+#define THETA_TRIP  (1l << 24)      // theta at the trip level
+
+// Mean square ADC_BAT_LOAD at the trip level: rated^2 * OVERLOAD_TRIP
+#define TRIP2(i)    ((uint32_t)(((uint64_t)(i) * (i) * OVERLOAD_TRIP) >> 16))
+
+static uint32_t ms_max = 64u * TRIP2(OVERLOAD_I_RATED);       // clamp, 8 x trip current
+static uint32_t gain   = (1ul << 24) / TRIP2(OVERLOAD_I_RATED);
+static uint32_t k_q24  = (1ul << 24) / (SINE_FREQ_HZ * OVERLOAD_TAU_S);   // period / tau
+static uint32_t sum;
+static uint32_t count;
+static int32_t  theta;              // Q24 of the trip level
+static uint16_t limit = 32767;
+static OverloadLog_t ov;
+
+int Overload_SetCurve(uint16_t i_rated, uint16_t tau_s)
+{
+    if (i_rated == 0 || i_rated > 4095 || tau_s == 0)
+        return -1;
+
+    uint32_t trip2 = TRIP2(i_rated);
+    if (trip2 == 0)
+        return -1;
+
+    __disable_irq();
+    gain   = (1ul << 24) / trip2;
+    ms_max = 64u * trip2;
+    k_q24  = (1ul << 24) / ((uint32_t)SINE_FREQ_HZ * tau_s);
+    __enable_irq();
+    return 0;
+}
+
+// Once per period, ms = mean square ADC_BAT_LOAD
+static void Overload_Period(uint32_t ms)
+{
+    // x: mean square relative to the trip level, Q16 (<= 64)
+    uint32_t x = ((ms > ms_max ? ms_max : ms) * gain) >> 8;
+    theta += (int32_t)(((int64_t)((int32_t)(x << 8) - theta) * k_q24) >> 24);
+    if (theta < 0)
+        theta = 0;
+
+    uint32_t lvl = (uint32_t)theta >> 9;
+    ov.level = (uint16_t)(lvl > 32767 ? 32767 : lvl);
+    if (ov.level > ov.peak)
+        ov.peak = ov.level;
+
+    // derate between OVERLOAD_DERATE_AT and the trip level
+    uint16_t lim = 32767;
+    if (ov.level > OVERLOAD_DERATE_AT)
+    {
+        lim = (uint16_t)(32767 - ((uint32_t)(32767 - OVERLOAD_DERATE_MIN) * (ov.level - OVERLOAD_DERATE_AT))
+                                 / (32767 - OVERLOAD_DERATE_AT));
+        ov.derate_periods++;
+    }
+    if (lim != limit)
+    {
+        limit = lim;
+        SineGen_SetAmpLimit(SINE_LIMIT_OVERLOAD, lim);
+    }
+
+    if (theta >= THETA_TRIP && !ov.tripped)
+    {
+        ov.tripped = 1;
+        ov.trips++;
+        SineGen_Stop();
+    }
+    else if (ov.tripped && ov.level < OVERLOAD_RESET)
+    {
+        ov.tripped = 0;
+    }
+}
+
+void Overload_Sample(uint16_t i_bat)
+{
+    sum += (uint32_t)i_bat * i_bat;
+    if (++count < SINE_SAMPLES)
+        return;
+
+    Overload_Period(sum / SINE_SAMPLES);
+    sum   = 0;
+    count = 0;
+}
+
+uint8_t Overload_Tripped(void)
+{
+    return ov.tripped;
+}
+
+void Overload_GetLog(OverloadLog_t *log)
+{
+    __disable_irq();
+    *log = ov;
+    __enable_irq();
+}
+
+void Overload_ClearLog(void)
+{
+    __disable_irq();
+    ov.peak           = ov.level;
+    ov.trips          = 0;
+    ov.derate_periods = 0;
+    __enable_irq();
+}
@@ -0,0 +1,64 @@
+#ifndef OVERLOAD_H
+#define OVERLOAD_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Inverse-time (I^2t) overload model on ADC_BAT_LOAD.
+//
+// A first-order thermal image of the power stage: every period the mean
+// square current, relative to the rated current squared, is filtered with
+// the time constant tau into the heat level theta (1.0 = steady state at
+// rated current). Sustained current k times rated trips after
+//
+//     t = tau * ln(k^2 / (k^2 - OVERLOAD_TRIP))
+//
+// and never below sqrt(OVERLOAD_TRIP) times rated, so short surges (motor
+// start, compressor) ride through. Above OVERLOAD_DERATE_AT of the trip
+// level the output amplitude is reduced step by step, which lowers the
+// current before the trip is reached.
+
+// Rated current, ADC_BAT_LOAD counts (placeholder, ~1.2 A)
+#define OVERLOAD_I_RATED        150
+// Thermal time constant (s)
+#define OVERLOAD_TAU_S          60
+// Trip level, theta in Q16 (1.44 = 1.2 x rated forever)
+#define OVERLOAD_TRIP           94372
+// Derating from this fraction of the trip level (Q15, 0.7) down to
+// OVERLOAD_DERATE_MIN (Q15 amplitude, 0.6) at the trip level
+#define OVERLOAD_DERATE_AT      22938
+#define OVERLOAD_DERATE_MIN     19661
+// After a trip SineGen_Start() is refused until theta has cooled below
+// this fraction of the trip level (Q15, 0.5)
+#define OVERLOAD_RESET          16384
+
+typedef struct {
+    uint16_t level;             // theta / trip level now, Q15 (32767 = trip)
+    uint16_t peak;              // highest level since Overload_ClearLog(), Q15
+    uint16_t trips;
+    uint32_t derate_periods;    // periods spent derating
+    uint8_t  tripped;           // latched until cooled to OVERLOAD_RESET
+} OverloadLog_t;
+
+// Rated current (ADC_BAT_LOAD counts) and time constant (s); -1 if out of range
+int Overload_SetCurve(uint16_t i_rated, uint16_t tau_s);
+
+// TIM6 ISR, every update (bridge off too, so the model cools)
+void Overload_Sample(uint16_t i_bat);
+
+// Non-zero while a trip is latched
+uint8_t Overload_Tripped(void);
+
+void Overload_GetLog(OverloadLog_t *log);
+
+// Clear peak, trip count and derating time
+void Overload_ClearLog(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // OVERLOAD_H
@@ -0,0 +1,189 @@
+/**
+ * @file pll.c
+ * @brief SOGI-PLL on ADC_U_IN; the controlled oscillator is the TIM6 period.
+ *
+ * The second-order generalised integrator turns the mains sample into an
+ * in-phase (a) and a quadrature (b = -A cos) component. With the sample
+ * rate locked to the mains, w*Ts is 2*pi/SINE_SAMPLES whatever the mains
+ * frequency, so its coefficients are constants. The phase detector is
+ * a*cos(theta) + b*sin(theta) = A sin(phi - theta), theta from a pure sine
+ * table at the modulator index, normalised by 1/A computed once per period
+ * (the only division; the M0 has no divide instruction). A PI filter turns
+ * it into a TIM6 period in 1/256 ticks, dithered onto whole ticks.
+ */
+
+#include "pll.h"
+#include "sinegen.h"
+
+// Nominal period and its limits, Q8 ticks
+#define PLL_P_NOM   ((int32_t)(PLL_TIM_HZ / (SINE_FREQ_HZ * SINE_SAMPLES)) << 8)
+#define PLL_P_MIN   ((int32_t)(((uint64_t)PLL_TIM_HZ * 100u * 256u) / ((uint64_t)PLL_F_MAX_CHZ * SINE_SAMPLES)))
+#define PLL_P_MAX   ((int32_t)(((uint64_t)PLL_TIM_HZ * 100u * 256u) / ((uint64_t)PLL_F_MIN_CHZ * SINE_SAMPLES)))
+// w*Ts = 2*pi / SINE_SAMPLES in Q15, and k*w*Ts
+#define SOGI_X      ((int32_t)(6.2831853 * 32768.0 / SINE_SAMPLES + 0.5))
+#define SOGI_KX     ((SOGI_X * PLL_SOGI_K) >> 12)
+
+static int16_t  pll_sin[SINE_SAMPLES];
+static uint8_t  table_ok;
+
+static uint32_t off;                // ADC_U_IN mean, code << 12
+static int32_t  a, b;               // SOGI outputs, code << 3
+static uint32_t sum_aa;             // sum of (a^2 + b^2) >> 8 over the period
+static uint32_t gain;               // 2^26 / A, 0 = no mains
+static int32_t  integ;              // integral part, Q16 ticks
+static int32_t  period;             // Q8 ticks
+static uint32_t frac;               // dither remainder, Q8
+static uint16_t amp_codes;
+static uint16_t freq = SINE_FREQ_HZ * 100;
+static uint8_t  lock_count;
+static uint8_t  locked;
+static int32_t  worst;              // largest |phase error| this period, Q15 rad
+
+static uint32_t Isqrt(uint32_t x)
+{
+    uint32_t r = 0;
+    for (uint32_t bit = 1ul << 30; bit != 0; bit >>= 2)
+    {
+        if (x >= r + bit)
+        {
+            x -= r + bit;
+            r = (r >> 1) + bit;
+        }
+        else
+        {
+            r >>= 1;
+        }
+    }
+    return r;
+}
+
+void Pll_Reset(void)
+{
+    if (!table_ok)
+    {
+        SineGen_BuildShape(pll_sin, SINE_SHAPE_SINE, 0);
+        table_ok = 1;
+    }
+
+    off        = 2048ul << 12;
+    a = b      = 0;
+    sum_aa     = 0;
+    gain       = 0;
+    integ      = 0;
+    period     = PLL_P_NOM;
+    frac       = 0;
+    amp_codes  = 0;
+    freq       = SINE_FREQ_HZ * 100;
+    lock_count = 0;
+    locked     = 0;
+    worst      = 0;
+}
+
+// Once per period: amplitude, normaliser, lock state, frequency
+static void Pll_Period(void)
+{
+    uint32_t amp = Isqrt((sum_aa / SINE_SAMPLES) << 8);
+    sum_aa    = 0;
+    amp_codes = (uint16_t)(amp >> 3);
+
+    if (amp_codes < PLL_A_MIN)
+    {
+        // no mains: forget the phase, drift back to nominal
+        gain       = 0;
+        integ      = 0;
+        lock_count = 0;
+        locked     = 0;
+    }
+    else
+    {
+        gain = (1ul << 26) / amp;
+        if (worst < PLL_LOCK_ERR)
+        {
+            if (lock_count < PLL_LOCK_CYCLES)
+                lock_count++;
+            else
+                locked = 1;
+        }
+        else
+        {
+            lock_count = 0;
+            if (worst > PLL_UNLOCK_ERR)
+                locked = 0;
+        }
+    }
+    worst = 0;
+
+    freq = (uint16_t)(((PLL_TIM_HZ * 100u / SINE_SAMPLES) << 8) / (uint32_t)period);
+}
+
+uint16_t Pll_Update(uint16_t u_in, uint32_t idx)
+{
+    // remove the divider bias (0.8 s mean)
+    off += u_in - (off >> 12);
+    int32_t v = ((int32_t)u_in << 3) - (int32_t)(off >> 9);
+
+    // SOGI, semi-implicit Euler: a from the error, b integrates the new a
+    int32_t e = v - a;
+    a += (SOGI_KX * e - SOGI_X * b) >> 15;
+    b += (SOGI_X * a) >> 15;
+    sum_aa += (uint32_t)(a * a + b * b) >> 8;
+
+    // phase detector against the table index
+    int32_t pe = 0;
+    if (gain != 0)
+    {
+        uint32_t ic = idx + SINE_SAMPLES / 4;
+        if (ic >= SINE_SAMPLES)
+            ic -= SINE_SAMPLES;
+        int32_t pd = (a * pll_sin[ic] + b * pll_sin[idx]) >> 15;
+        if (pd > 32767)
+            pd = 32767;
+        else if (pd < -32767)
+            pd = -32767;
+        pe = (pd * (int32_t)gain) >> 11;
+        if (pe > 32767)
+            pe = 32767;
+        else if (pe < -32767)
+            pe = -32767;
+        int32_t m = (pe < 0) ? -pe : pe;
+        if (m > worst)
+            worst = m;
+    }
+
+    // PI: input ahead (pe > 0) means a shorter period
+    integ -= (pe * PLL_KI) >> 7;
+    if (integ > (PLL_P_MAX - PLL_P_NOM) * 256)
+        integ = (PLL_P_MAX - PLL_P_NOM) * 256;
+    else if (integ < (PLL_P_MIN - PLL_P_NOM) * 256)
+        integ = (PLL_P_MIN - PLL_P_NOM) * 256;
+    int32_t p = PLL_P_NOM + (integ >> 8) - ((pe * PLL_KP) >> 15);
+    if (p < PLL_P_MIN)
+        p = PLL_P_MIN;
+    else if (p > PLL_P_MAX)
+        p = PLL_P_MAX;
+    period = p;
+
+    if (idx == SINE_SAMPLES - 1)
+        Pll_Period();
+
+    // whole ticks, the fraction carried to the next update
+    frac += (uint32_t)p;
+    uint16_t ticks = (uint16_t)(frac >> 8);
+    frac &= 0xFF;
+    return ticks;
+}
+
+uint8_t Pll_Locked(void)
+{
+    return locked;
+}
+
+uint16_t Pll_GetFreq(void)
+{
+    return freq;
+}
+
+uint16_t Pll_GetAmplitude(void)
+{
+    return amp_codes;
+}
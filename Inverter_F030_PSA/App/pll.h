@@ -0,0 +1,57 @@
+#ifndef PLL_H
+#define PLL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Mains phase tracking on ADC_U_IN (SOGI-PLL, fixed point).
+//
+// The oscillator being locked is the modulator itself: one step per TIM6
+// update, phase = sine table index. Pll_Update() returns the TIM6 period
+// that moves the index onto the mains phase, so once locked the table runs
+// at the mains frequency and every per-index quantity in the sine generator
+// (shape, RC correction, dead-time lag) keeps its meaning.
+
+// TIM6 counter clock (PSC = 47 at 48 MHz)
+#define PLL_TIM_HZ          1000000u
+// Tracking range, 0.01 Hz
+#define PLL_F_MIN_CHZ       4700u
+#define PLL_F_MAX_CHZ       5300u
+// Below this ADC_U_IN amplitude (peak, codes) there is no mains
+#define PLL_A_MIN           200
+// SOGI damping k, Q12 (1.41)
+#define PLL_SOGI_K          5793
+// Loop filter: period change per rad of phase error, Q8 ticks; integral
+// gain in the same units per update
+#define PLL_KP              3000
+#define PLL_KI              5
+// Locked after this many periods within PLL_LOCK_ERR (Q15 rad, ~3 deg);
+// lost at PLL_UNLOCK_ERR (~9 deg)
+#define PLL_LOCK_CYCLES     10
+#define PLL_LOCK_ERR        1638
+#define PLL_UNLOCK_ERR      4915
+
+// Clear the filter state, back to the nominal period
+void Pll_Reset(void);
+
+// One update: u_in is the ADC_U_IN code sampled at table index idx (0 at
+// the positive-going zero crossing of the output). Returns the period for
+// the next TIM6 update, in ticks (ARR + 1).
+uint16_t Pll_Update(uint16_t u_in, uint32_t idx);
+
+uint8_t Pll_Locked(void);
+
+// Tracked mains frequency, 0.01 Hz (nominal while there is no mains)
+uint16_t Pll_GetFreq(void);
+
+// Mains amplitude, ADC_U_IN codes peak
+uint16_t Pll_GetAmplitude(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PLL_H
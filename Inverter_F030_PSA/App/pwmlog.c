@@ -0,0 +1,131 @@
+/**
+ * @file pwmlog.c
+ * @brief Modulation recorder: CCR writes and bridge on/off with timestamps.
+ *
+ * Timestamps are built from a count of TIM6 updates (one per modulation
+ * sample, 200 us) plus the TIM6 counter, which runs at 1 MHz (PSC = 47).
+ * Recording stops when the buffer is full or the bridge is switched off;
+ * PwmLog_Poll() then prints the capture once on USART1.
+ */
+
+#ifdef PWMLOG_ENABLE
+
+#include "pwmlog.h"
+#include "tim.h"
+#include "usart.h"
+#include "stm32f0xx_hal.h"
+
+#include <stdio.h>
+
+#define PWMLOG_BRIDGE_TAG   0xFFFFu // in .b: bridge event (a CCR never reaches it)
+#define PWMLOG_CARRIER_TAG  0xFFFEu // in .b: new ARR in .a
+#define PWMLOG_UART_TIMEOUT 50      // ms per line
+
+typedef struct {
+    uint32_t t_us;
+    uint16_t a;                     // TIM16 CCR1, bridge state or ARR
+    uint16_t b;                     // TIM17 CCR1, or a PWMLOG_*_TAG
+} PwmLogEvent_t;
+
+static PwmLogEvent_t     events[PWMLOG_DEPTH];
+static volatile uint16_t count;
+static volatile uint8_t  armed;
+static volatile uint8_t  done;
+static uint16_t          decim = 1;
+static uint16_t          skip;
+static uint32_t          samples;   // TIM6 updates since Arm
+
+static uint32_t Now(void)
+{
+    return samples * (TIM6->ARR + 1) + TIM6->CNT;
+}
+
+static void Put(uint16_t a, uint16_t b)
+{
+    if (!armed)
+        return;
+
+    events[count].t_us = Now();
+    events[count].a    = a;
+    events[count].b    = b;
+    if (++count >= PWMLOG_DEPTH)
+    {
+        armed = 0;
+        done  = 1;
+    }
+}
+
+void PwmLog_Arm(uint16_t decimation)
+{
+    __disable_irq();
+    decim   = decimation ? decimation : 1;
+    skip    = 0;
+    samples = 0;
+    count   = 0;
+    done    = 0;
+    armed   = 1;
+    __enable_irq();
+}
+
+void PwmLog_Sample(uint16_t ccr16, uint16_t ccr17)
+{
+    samples++;
+
+    if (skip == 0)
+        Put(ccr16, ccr17);
+    if (++skip >= decim)
+        skip = 0;
+}
+
+void PwmLog_Bridge(uint8_t on)
+{
+    Put(on ? 1 : 0, PWMLOG_BRIDGE_TAG);
+
+    // nothing more to see once the bridge is off
+    if (!on && armed)
+    {
+        armed = 0;
+        done  = 1;
+    }
+}
+
+void PwmLog_Carrier(uint16_t arr)
+{
+    Put(arr, PWMLOG_CARRIER_TAG);
+}
+
+static void Send(const char *line, int len)
+{
+    HAL_UART_Transmit(&huart1, (uint8_t *)line, (uint16_t)len, PWMLOG_UART_TIMEOUT);
+}
+
+void PwmLog_Poll(void)
+{
+    char line[48];
+    int  n;
+
+    if (!done)
+        return;
+    done = 0;
+
+    n = snprintf(line, sizeof(line), "# pwmlog arr=%lu deadtime=%lu fs=%lu decim=%u\r\n",
+                 (unsigned long)TIM16->ARR, (unsigned long)(TIM16->BDTR & TIM_BDTR_DTG),
+                 (unsigned long)(1000000u / (TIM6->ARR + 1)), decim);
+    Send(line, n);
+
+    for (uint16_t i = 0; i < count; i++)
+    {
+        const PwmLogEvent_t *e = &events[i];
+        if (e->b == PWMLOG_BRIDGE_TAG)
+            n = snprintf(line, sizeof(line), "%lu,B,%u\r\n", (unsigned long)e->t_us, e->a);
+        else if (e->b == PWMLOG_CARRIER_TAG)
+            n = snprintf(line, sizeof(line), "%lu,A,%u\r\n", (unsigned long)e->t_us, e->a);
+        else
+            n = snprintf(line, sizeof(line), "%lu,C,%u,%u\r\n", (unsigned long)e->t_us, e->a, e->b);
+        Send(line, n);
+    }
+
+    Send("# end\r\n", 7);
+}
+
+#endif // PWMLOG_ENABLE
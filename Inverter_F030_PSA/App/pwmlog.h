@@ -0,0 +1,60 @@
+#ifndef PWMLOG_H
+#define PWMLOG_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Modulation recorder (debug builds only, define PWMLOG_ENABLE).
+//
+// Records every CCR write of the sine generator and every bridge on/off with
+// a microsecond timestamp taken from TIM6, then prints the capture on USART1
+// as CSV for offline analysis (waveform, ramp and shutdown behaviour):
+//
+//   # pwmlog arr=2999 deadtime=75 fs=5000 decim=1
+//   <t_us>,C,<TIM16 CCR1>,<TIM17 CCR1>
+//   <t_us>,B,<1 on | 0 off>
+//   <t_us>,A,<ARR>                 (carrier change, from the next update event)
+//   # end
+
+// Captured events; each costs 8 bytes of RAM
+#define PWMLOG_DEPTH        160
+
+// Record every Nth CCR write (1 = full resolution, ~1.6 sine periods;
+// 32 covers the whole 1 s soft-start)
+#define PWMLOG_DECIMATION   1
+
+#ifdef PWMLOG_ENABLE
+
+// Clear the buffer and record from the next event on
+void PwmLog_Arm(uint16_t decimation);
+
+// Called from SineGen_Update() after the CCRs are written
+void PwmLog_Sample(uint16_t ccr16, uint16_t ccr17);
+
+// Called when the bridge outputs are enabled/disabled
+void PwmLog_Bridge(uint8_t on);
+
+// Called when a new ARR is written to TIM16/TIM17
+void PwmLog_Carrier(uint16_t arr);
+
+// Main loop: prints a finished capture once
+void PwmLog_Poll(void);
+
+#else
+
+#define PwmLog_Arm(decimation)       ((void)0)
+#define PwmLog_Sample(ccr16, ccr17)  ((void)0)
+#define PwmLog_Bridge(on)            ((void)0)
+#define PwmLog_Carrier(arr)          ((void)0)
+#define PwmLog_Poll()                ((void)0)
+
+#endif // PWMLOG_ENABLE
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // PWMLOG_H
@@ -9,32 +9,162 @@
  *   used to modulate TIM16/TIM17 duty cycle according to sine lookup table.
  *
  * Features:
- * - Soft-start ramp: duty amplitude increases smoothly from 0 to 100% over SOFT_MS ms.
- * - Soft-stop ramp: duty amplitude decreases back to 0 over SOFT_MS ms, then disables bridge.
+ * - Waveform shape held as a signed Q15 table, double-buffered: a new shape is
+ *   loaded into the standby table in the background and the TIM6 ISR swaps the
+ *   table pointer at the next positive-going zero crossing.
+ * - Soft-start ramp: duty amplitude follows a linear or S-shaped profile from 0 to
+ *   100% in SOFT_MS ms (SineGen_SetRamp()). While the filtered ADC_BAT_LOAD is near
+ *   the current limit the ramp slows down, above it the ramp holds, so inrush
+ *   loads stretch the start instead of tripping the bridge.
+ * - Soft-stop ramp: duty amplitude decreases back to 0 along the same profile, then
+ *   disables the bridge at the next half-cycle boundary.
+ * - Carrier selectable at run time, optionally dithered (spread spectrum) by an
+ *   LFSR once per sample; the CCRs are scaled to the period they are latched
+ *   with, so the duty cycle and the fundamental are unaffected.
+ * - Dead-time compensation: each CCR is moved by the dead time towards the
+ *   expected load-current polarity, taken from the reference DTCOMP_LAG
+ *   samples back. Around the current zero crossings the filter ripple
+ *   commutates the legs and there is nothing to correct; the width of that
+ *   band follows the load measured on ADC_BAT_LOAD.
+ * - DC trim: the mean of ADC_U_OUT over each period is integrated into a gain
+ *   difference between the positive and negative half-cycles, so the
+ *   transformer sees no net volt-seconds.
+ * - Repetitive controller: one Q15 correction per table index, learnt from
+ *   the ADC_U_OUT error of the previous periods (rectifier loads flatten the
+ *   top of the sine). The output is normalised to the reference by its
+ *   fundamental, so only the distortion is learnt, not the amplitude.
+ * - Derating: the amplitude is limited to the lowest of the thermal and I^2t
+ *   overload limits (SineGen_SetAmpLimit()); the overload model also stops
+ *   the output at its trip level.
+ * - Battery undervoltage lockout (battery.c): SineGen_Start() is refused
+ *   while the battery is locked out; the ISR feeds it the battery readings,
+ *   and ADC_BAT_LOAD to the charge counter (soc.c).
+ * - Metering (meter.c): ADC_U_OUT and ADC_BAT_LOAD with the table index,
+ *   evaluated per period in the main loop.
+ * - Load search: with no load for a while the bridge sleeps and wakes for a
+ *   short burst every few seconds, staying on once a burst sees a load.
+ * - Mains sync: a SOGI-PLL on ADC_U_IN (pll.c) sets the TIM6 period so the
+ *   table index follows the mains phase; TIM6 then runs while idle too. The
+ *   bypass relay is switched so its contacts move at a zero crossing, the
+ *   bridge handing over to the mains in phase and taking back at full
+ *   amplitude.
  * - All HAL TIM6 start/stop handled inside module; main() calls only SineGen_Init(),
- *   SineGen_Start(), and SineGen_Stop().
+ *   SineGen_Start(), SineGen_Stop() and, in the loop, SineGen_Poll() (the
+ *   completion callbacks).
  */
 
 #include "tim.h"              // for timer externals
 #include "gpio.h"             // for debug LEDs
 #include "sinegen.h"
+#include "adcin.h"
+#include "pwmlog.h"
+#include "pll.h"
+#include "overload.h"
+#include "battery.h"
+#include "soc.h"
+#include "meter.h"
 #include "stm32f0xx_hal.h"    // device register definitions
 
 #include <math.h>
+#include <string.h>
 
-// Internal sine lookup table
-static uint16_t sine_table[SINE_SAMPLES];
+// Amplitude is kept in Q24 so the per-sample ramp step stays exact enough
+#define AMP_FULL        (1ul << 24)
+#define AMP_STEP        (AMP_FULL / RAMP_TICKS)
+
+#define RAMP_STALL_TICKS ((UPDATE_FREQ_HZ * RAMP_STALL_MS) / 1000)
+
+// Relay times in updates, rounded up
+#define BYPASS_SAMPLES(us)  ((uint16_t)(((us) * (uint32_t)UPDATE_FREQ_HZ + 999999u) / 1000000u))
+// The same within a half-cycle, for Zero_In()
+#define BYPASS_PHASE(us)    ((uint16_t)(BYPASS_SAMPLES(us) % (SINE_SAMPLES / 2)))
+
+// Waveform shape tables, Q15 (+-32767 = full modulation). The ISR reads
+// shape_active only; a loaded table waits in shape_pending for the swap.
+static int16_t                  shape_buf[2][SINE_SAMPLES];
+static const int16_t * volatile shape_active = shape_buf[0];
+static const int16_t * volatile shape_pending;
 
 // Soft-ramp state
+static volatile SineGenState_t state = SINEGEN_IDLE;
+static SineGenCallback_t on_run;       // ramp-up reached full amplitude
+static SineGenCallback_t on_idle;      // ramp-down done, bridge off
+static volatile uint8_t  run_event;    // set by the ISR, for SineGen_Poll()
+static volatile uint8_t  idle_event;
 static volatile uint32_t sine_idx;
-static volatile float    amplitude;
-static float             amp_step_up;
-static float             amp_step_down;
+static volatile int32_t  amplitude;         // Q24, 0..AMP_FULL
+static uint16_t          ccr_period;        // ARR + 1 for the CCRs being written
+
+// Load search, counted in periods; search_idle = 0: off
+static uint32_t          search_idle  = SEARCH_DEFAULT_ON ? (SEARCH_IDLE_MS * SINE_FREQ_HZ) / 1000 : 0;
+static uint32_t          search_every = (SEARCH_EVERY_MS * SINE_FREQ_HZ) / 1000;
+static uint32_t          search_cnt;
+static uint32_t          search_sum;        // ADC_BAT_LOAD over the current period
+
+// Mains sync and bypass transfer
+typedef enum {
+    BYPASS_OFF = 0,                 // relay open, output from the bridge (or off)
+    BYPASS_CLOSING,                 // relay driven, bridge still on until the contacts close
+    BYPASS_ON,
+    BYPASS_OPENING,                 // relay released, bridge takes over at a zero crossing
+} BypassState_t;
+
+static volatile uint8_t  sync_on;
+static volatile uint8_t  bypass_req;
+static volatile BypassState_t bypass_state = BYPASS_OFF;
+static uint16_t          bypass_wait;       // updates until the contacts have moved
+
+// Ramp profile
+static SineRamp_t        ramp_curve   = RAMP_DEFAULT_CURVE;
+static uint32_t          ramp_step    = AMP_STEP;   // Q24 progress per update, unloaded
+static uint16_t          ramp_i_limit = RAMP_I_LIMIT;
+static int32_t           ramp_pos;          // Q24 progress along the profile, 0..AMP_FULL
+static uint32_t          ramp_hold;         // updates held at the current limit in a row
+
+// Amplitude limit (derating), Q15: the lowest of the sources; amp_lim
+// follows amp_lim_set by one LSB per update, full range in ~6.5 s
+static uint16_t          amp_lims[SINE_LIMIT_COUNT] = { 32767, 32767 };
+static volatile uint16_t amp_lim_set = 32767;
+static uint16_t          amp_lim     = 32767;
+
+// Dead-time compensation state
+static uint8_t           dtcomp_on = DTCOMP_DEFAULT_ON;
+static uint16_t          dt_ticks;          // programmed dead time, timer ticks
+static volatile int32_t  dt_band;           // |reference| below which the ripple commutates
+static int32_t           load_f;            // filtered ADC_BAT_LOAD
+
+// Carrier state
+static volatile uint16_t carrier_arr;       // ARR waiting for the ISR, 0 = none
+static uint16_t          arr_base;          // selected carrier (dither centre)
+static volatile uint16_t dither_mask;       // dither span - 1, 0 = off
+static volatile uint16_t carrier_mask;      // widest dither_mask at carrier_arr
+static uint16_t          lfsr = 0xACE1u;
+
+// DC trim state
+static int32_t           dc_sum;            // ADC_U_OUT summed over the running period
+static uint16_t          dc_count;          // samples in dc_sum
+static int32_t           dc_zero;           // the same sum at zero output
+static uint8_t           dc_zero_valid;
+static uint8_t           dc_quiet;          // amplitude 0 throughout the running period
+static volatile int32_t  dc_trim;           // Q15, + widens the positive half-cycle
+static uint8_t           dc_pinned;         // periods at DCTRIM_MAX pushing further
+static uint8_t           dc_probe;          // trim backed off for the running period
+static uint8_t           dc_probed;         // backed off once this run already
+static int32_t           dc_err_pin;        // error and trim before backing off
+static int32_t           dc_trim_pin;
+static volatile uint8_t  dc_trim_off;       // diverged: DCTRIM_UOUT_POLARITY is wrong
+
+// Repetitive controller state
+static uint8_t           rc_on = RC_DEFAULT_ON;
+static int16_t           rc_corr[SINE_SAMPLES]; // Q15 correction per table index
+static int32_t           rc_zero;           // ADC_U_OUT at zero output
+static int32_t           rc_scale;          // ADC_U_OUT -> Q15 reference, Q4; 0 = not learning
+static int32_t           rc_quad;           // quadrature fundamental in the output, Q15
+static int32_t           rc_mr, rc_mq, rc_rr;   // correlation sums of the running period
 
 // Forward declarations
 static void Bridge_Start(void);
 static void Bridge_Stop(void);
-static void Build_Sine_Table(void);
 
 //-------------------------------------------------------------------------
 // Functions controlling the bridge hardware.
@@ -71,6 +201,8 @@ static void Bridge_Start(void)
     TIM17->CR1 |= TIM_CR1_CEN;
 
     __enable_irq();
+
+    PwmLog_Bridge(1);
 }
 
 void Bridge_Stop(void)
@@ -94,6 +226,131 @@ void Bridge_Stop(void)
     TIM17->CNT = 0;
 
     __enable_irq();
+
+    PwmLog_Bridge(0);
+}
+
+//-------------------------------------------------------------------------
+// Carrier frequency
+//-------------------------------------------------------------------------
+
+// Dither mask for span ticks at a period of arr + 1: span rounded down to a
+// power of two, at most 1/8 of the period; 0 = off
+static uint16_t Dither_Mask(uint16_t span, uint16_t arr)
+{
+    if (span > (arr + 1u) / 8)
+        span = (uint16_t)((arr + 1u) / 8);
+
+    uint16_t pow2 = 1;
+    while ((uint16_t)(pow2 << 1) != 0 && (uint16_t)(pow2 << 1) <= span)
+        pow2 <<= 1;
+
+    return (span < 2) ? 0 : pow2 - 1;
+}
+
+// Select the PWM carrier. Dead time is set in timer ticks (BDTR.DTG) and stays
+// the same 1.56 us at any period; the range keeps it under 5% of the period.
+// While the bridge runs the change is made by the TIM6 ISR together with the
+// CCRs of the new scale, so both take effect at the same update event.
+// Returns -1 for a frequency outside CARRIER_MIN_HZ..CARRIER_MAX_HZ.
+int Bridge_SetCarrier(uint32_t hz)
+{
+    if (hz < CARRIER_MIN_HZ || hz > CARRIER_MAX_HZ)
+        return -1;
+
+    // TIM16/17 run from PCLK (APB prescaler 1) with PSC = 0
+    uint16_t arr = (uint16_t)((SystemCoreClock + hz / 2) / hz - 1);
+
+    if (state == SINEGEN_IDLE) {
+        arr_base    = arr;              // SineGen_Start() loads it into the timers
+        dither_mask = Dither_Mask(dither_mask + 1u, arr);
+        PwmLog_Carrier(arr);
+    } else {
+        carrier_mask = Dither_Mask(0xFFFFu, arr);
+        carrier_arr  = arr;
+    }
+    return 0;
+}
+
+uint32_t Bridge_GetCarrier(void)
+{
+    return SystemCoreClock / (arr_base + 1u);
+}
+
+// Spread-spectrum mode: every sample the period is moved to a pseudo-random
+// point in arr_base +- span/2 ticks. span is rounded down to a power of two
+// and limited to 1/8 of the period (+-6%), also when the carrier changes
+// later; 0 turns dithering off.
+void Bridge_SetDither(uint16_t span)
+{
+    uint16_t mask = Dither_Mask(span, arr_base);
+
+    dither_mask = mask;
+    if (mask == 0 && state != SINEGEN_IDLE) {
+        carrier_mask = Dither_Mask(0xFFFFu, arr_base);
+        carrier_arr  = arr_base;        // back to the plain carrier
+    }
+}
+
+// ARR and CCR1 are preloaded: what is written takes effect at the next update
+// event of each timer. The new period and the CCRs scaled for it must land in
+// the same period on both timers, or a CCR meets the ARR of the other scale
+// and the legs drift apart; hence the wait when an update event is closer
+// than the stores take (CARRIER_GUARD_TICKS). The wait gives up after
+// CARRIER_GUARD_POLLS reads, so a stopped TIM16 or an ARR below the guard
+// cannot hold the ISR. arr = 0: CCRs only.
+static void Bridge_Write(uint16_t arr, uint32_t ccr)
+{
+    uint32_t polls = CARRIER_GUARD_POLLS;
+
+    __disable_irq();
+    while (TIM16->CNT > TIM16->ARR - CARRIER_GUARD_TICKS && --polls != 0)
+        ;
+    if (arr != 0) {
+        TIM16->ARR = arr;
+        TIM17->ARR = arr;
+    }
+    TIM16->CCR1 = ccr;
+    TIM17->CCR1 = ccr;
+    __enable_irq();
+}
+
+// Dead time in timer ticks from BDTR.DTG (tDTS = tCK_INT, CKD = 0)
+static uint16_t Deadtime_Ticks(void)
+{
+    uint32_t dtg = TIM16->BDTR & TIM_BDTR_DTG;
+
+    if ((dtg & 0x80u) == 0)
+        return (uint16_t)dtg;
+    if ((dtg & 0xC0u) == 0x80u)
+        return (uint16_t)((64u + (dtg & 0x3Fu)) * 2u);
+    if ((dtg & 0xE0u) == 0xC0u)
+        return (uint16_t)((32u + (dtg & 0x1Fu)) * 8u);
+    return (uint16_t)((32u + (dtg & 0x1Fu)) * 16u);
+}
+
+// ISR side of Bridge_SetCarrier(): the ARR for Bridge_Write(). A dither
+// span set for a longer period is cut down to 1/8 of this one.
+static uint16_t Carrier_Apply(uint16_t arr)
+{
+    arr_base    = arr;
+    carrier_arr = 0;
+    if (dither_mask > carrier_mask)
+        dither_mask = carrier_mask;
+    ccr_period  = arr + 1;
+    PwmLog_Carrier(arr);
+    return arr;
+}
+
+// Next dithered period: 16-bit Galois LFSR (x^16 + x^14 + x^13 + x^11 + 1)
+static uint16_t Carrier_Dither(void)
+{
+    lfsr = (lfsr >> 1) ^ ((0u - (lfsr & 1u)) & 0xB400u);
+
+    int32_t  offset = (int32_t)(lfsr & dither_mask) - (int32_t)((dither_mask + 1u) / 2);
+    uint16_t arr    = (uint16_t)(arr_base + offset);
+    ccr_period = arr + 1;
+    return arr;
 }
 
 //-------------------------------------------------------------------------
@@ -111,34 +368,90 @@ void Bridge_Stop(void)
 #define SOFTSTART_STEPS   100    // How many discrete steps in our ramp
 #define SOFTSTART_TIME_MS 1000   // Total ramp time in milliseconds
 
-static inline void delay_ms(uint32_t ms)
+// The ramp runs from Bridge_SoftPoll() in the main loop, one step per
+// SOFTSTART_TIME_MS / SOFTSTART_STEPS ms of HAL_GetTick(), so nothing blocks.
+typedef enum {
+    SOFT_IDLE = 0,
+    SOFT_UP,
+    SOFT_ON,                    // at 50%, bridge running
+    SOFT_DOWN,
+} SoftState_t;
+
+static SoftState_t   soft_state = SOFT_IDLE;
+static uint32_t      soft_step;         // 0..SOFTSTART_STEPS
+static uint32_t      soft_last;         // HAL_GetTick() of the last step
+static BridgeDone_t  soft_done;
+
+static void Soft_Write(void)
 {
-    // assuming SysTick is ticking 1ms or you can implement your own busy-wait here
-    extern void HAL_Delay(uint32_t);
-    HAL_Delay(ms);
+    // target CCR: 50% duty = (ARR + 1) / 2
+    uint32_t ccr = ((TIM16->ARR + 1) / 2) * soft_step / SOFTSTART_STEPS;
+    TIM16->CCR1 = ccr;
+    TIM17->CCR1 = ccr;
 }
 
-void Bridge_SoftStart(void)
+int Bridge_SoftStart(BridgeDone_t done)
 {
+    if (soft_state != SOFT_IDLE || state != SINEGEN_IDLE || bypass_state != BYPASS_OFF)
+        return -1;
+
     // 1) Make sure compare is zero so we start from 0% duty
-    TIM16->CCR1 = 0;
-    TIM17->CCR1 = 0;
+    soft_step = 0;
+    Soft_Write();
 
     // 2) Fire up the timers and outputs synchronously
     Bridge_Start();
 
-    // 3) Compute our target CCR (here: 50% duty = ARR/2)
-    uint32_t target = (TIM16->ARR + 1) / 2;
+    // 3) Bridge_SoftPoll() does the rest
+    soft_done  = done;
+    soft_last  = HAL_GetTick();
+    soft_state = SOFT_UP;
+    return 0;
+}
+
+int Bridge_SoftStop(BridgeDone_t done)
+{
+    if (soft_state != SOFT_UP && soft_state != SOFT_ON)
+        return -1;
+
+    // back down from wherever the ramp is
+    soft_done  = done;
+    soft_last  = HAL_GetTick();
+    soft_state = SOFT_DOWN;
+    return 0;
+}
+
+void Bridge_SoftPoll(void)
+{
+    if (soft_state != SOFT_UP && soft_state != SOFT_DOWN)
+        return;
 
-    // 4) Ramp in SOFTSTART_STEPS discrete increments
-    uint32_t delay_per_step = SOFTSTART_TIME_MS / SOFTSTART_STEPS;
-    for (uint32_t step = 1; step <= SOFTSTART_STEPS; ++step)
-    {
-        uint32_t ccr = target * step / SOFTSTART_STEPS;
-        TIM16->CCR1 = ccr;
-        TIM17->CCR1 = ccr;
-        delay_ms(delay_per_step);
+    // one step per poll at most: a late poll stretches the ramp, it never jumps
+    uint32_t now = HAL_GetTick();
+    if (now - soft_last < SOFTSTART_TIME_MS / SOFTSTART_STEPS)
+        return;
+    soft_last = now;
+
+    BridgeDone_t done = soft_done;
+    if (soft_state == SOFT_UP) {
+        soft_step++;
+        Soft_Write();
+        if (soft_step < SOFTSTART_STEPS)
+            return;
+        soft_state = SOFT_ON;
+    } else {
+        if (soft_step > 0) {
+            soft_step--;
+            Soft_Write();
+            return;
+        }
+        Bridge_Stop();
+        soft_state = SOFT_IDLE;
     }
+
+    soft_done = NULL;
+    if (done != NULL)
+        done();
 }
 
 //-------------------------------------------------------------------------
@@ -166,73 +479,792 @@ void Bridge_SoftStart(void)
 //
 //-------------------------------------------------------------------------
 
-// Build a 0..ARR sine table scaled to timer ARR
-static void Build_Sine_Table(void)
+// Fill a Q15 table with one period of the given shape, peak scaled to 32767.
+// A flat top clipped at 0 % would be an all-zero table: param must be 1..100.
+int SineGen_BuildShape(int16_t *dst, SineShape_t shape, uint16_t param)
 {
-    const uint32_t arr = TIM16->ARR + 1;
+    float v[SINE_SAMPLES];
+    float peak = 0.0f;
+
+    if (shape > SINE_SHAPE_FLAT_TOP)
+        return -1;
+    if (shape == SINE_SHAPE_FLAT_TOP && (param < 1 || param > 100))
+        return -1;
+
     for (int i = 0; i < SINE_SAMPLES; i++) {
         float theta = 2.0f * 3.14159265f * i / (float)SINE_SAMPLES;
-        float v = (sinf(theta) * 0.5f + 0.5f) * arr;
-        sine_table[i] = (uint16_t)(v + 0.5f);
+        float s = sinf(theta);
+
+        switch (shape) {
+        case SINE_SHAPE_THIRD_HARMONIC:
+            // param: 3rd harmonic in % of the fundamental (1/6 = 17% is optimal)
+            s += (float)param * 0.01f * sinf(3.0f * theta);
+            break;
+        case SINE_SHAPE_FLAT_TOP:
+            // param: clip level in % of the peak
+            {
+                float clip = (float)param * 0.01f;
+                if (s > clip)
+                    s = clip;
+                else if (s < -clip)
+                    s = -clip;
+            }
+            break;
+        default:
+            break;
+        }
+
+        v[i] = s;
+        if (fabsf(s) > peak)
+            peak = fabsf(s);
     }
+
+    float k = (peak > 0.0f) ? 32767.0f / peak : 0.0f;
+    for (int i = 0; i < SINE_SAMPLES; i++)
+        dst[i] = (int16_t)lrintf(v[i] * k);
+    return 0;
+}
+
+// Copy a shape into the standby table and hand it to the ISR, which switches
+// to it at the start of the next period. Returns -1 while an earlier shape is
+// still waiting for its swap.
+int SineGen_LoadShape(const int16_t *shape)
+{
+    if (shape_pending != NULL)
+        return -1;
+
+    // the ISR never swaps while nothing is pending, so standby is ours
+    int16_t *standby = (shape_active == shape_buf[0]) ? shape_buf[1] : shape_buf[0];
+    memcpy(standby, shape, sizeof(shape_buf[0]));
+
+    shape_pending = standby;                // single word store, atomic
+    return 0;
+}
+
+// True while a loaded shape has not been switched in yet
+int SineGen_ShapePending(void)
+{
+    return shape_pending != NULL;
 }
 
 void SineGen_Init(void)
 {
-    // Only build sine table; TIM6 is configured via CubeMX (code generated in main.c)
-    Build_Sine_Table();
+    arr_base = (uint16_t)TIM16->ARR;
+
+    // Pure sine to start with; TIM6 is configured via CubeMX (code generated in main.c)
+    SineGen_BuildShape(shape_buf[0], SINE_SHAPE_SINE, 0);
+    shape_active  = shape_buf[0];
+    shape_pending = NULL;
+
+    if (SYNC_DEFAULT_ON)
+        SineGen_SetSync(1);
 }
 
-// Start sine generation with soft-start ramp and enables TIM6 interrupt
-void SineGen_Start(void)
+// Bridge on, from zero amplitude with the soft-start ramp or, taking the
+// load over from the bypass relay, at full amplitude. Also called from the
+// TIM6 ISR (bypass), where the index is at a zero crossing already.
+static void Run_Setup(uint8_t full)
 {
-    // Reset state
-    sine_idx      = 0;
-    amplitude     = 0.0f;
-    amp_step_up   = 1.0f / (float)RAMP_TICKS;
-    amp_step_down = -amp_step_up;
+    // Reset state; dc_trim is kept, the offset it corrects is a property of the hardware
+    // (while tracking the mains the index is the mains phase: leave it)
+    if (!sync_on)
+        sine_idx  = 0;
+    amplitude     = full ? AMP_FULL : 0;
+    ramp_pos      = full ? AMP_FULL : 0;
+    ramp_hold     = 0;
+    load_f        = 0;
+    search_cnt    = 0;
+    search_sum    = 0;
+    ccr_period    = arr_base + 1;
+    dt_ticks      = Deadtime_Ticks();
+    dt_band       = DTCOMP_BAND_LIGHT;
+    dc_sum        = 0;
+    dc_count      = 0;
+    // a new zero needs a period at zero output; taking over from the bypass
+    // keeps the last one (there is none while the bridge never ran)
+    if (!full)
+        dc_zero_valid = 0;
+    dc_quiet      = 1;
+    dc_pinned     = 0;
+    dc_probe      = 0;
+    dc_probed     = 0;
+    rc_scale      = 0;
+    rc_quad       = 0;
+    rc_mr = rc_mq = rc_rr = 0;
+    amp_lim       = amp_lim_set;
+    // the correction belongs to the load of the last run
+    memset(rc_corr, 0, sizeof(rc_corr));
+    state         = full ? SINEGEN_RUN : SINEGEN_RAMP_UP;
 
-    // Ensure starting duty = 0 to avoid initial 50% pulses
-    TIM16->CCR1 = 0;
-    TIM17->CCR1 = 0;
+    // Selected carrier (a dithered ARR may be left over from the last run),
+    // 50% duty on both legs: zero bridge voltage
+    TIM16->ARR  = arr_base;
+    TIM17->ARR  = arr_base;
+    TIM16->CCR1 = ccr_period / 2;
+    TIM17->CCR1 = ccr_period / 2;
 
     // Start TIM16 and TIM17 and enable bridge gates PWM outputs
     Bridge_Start();
 
-    // Start TIM6 interrupts for modulation
-    HAL_TIM_Base_Start_IT(&htim6);
+    // first scan, so the first update already has ADC data
+    AdcIn_Trigger();
+
+    // Start TIM6 interrupts for modulation (running already while tracking)
+    if (!sync_on)
+        HAL_TIM_Base_Start_IT(&htim6);
+}
+
+// Bridge off at once; the ramp-down and the bypass transfer end here
+static void Run_Off(void)
+{
+    amplitude = 0;
+    ramp_pos  = 0;
+    state     = SINEGEN_IDLE;
+    // Stop TIM6 interrupt (unless it tracks the mains) and bridge
+    if (!sync_on)
+        HAL_TIM_Base_Stop_IT(&htim6);
+    Bridge_Stop();
+    idle_event = 1;
+}
+
+// Start sine generation with soft-start ramp and enables TIM6 interrupt
+void SineGen_Start(void)
+{
+    if (state != SINEGEN_IDLE || soft_state != SOFT_IDLE || bypass_state != BYPASS_OFF ||
+        Overload_Tripped() || Battery_Lockout())
+        return;
+
+    Run_Setup(0);
 }
 
 void SineGen_Stop(void)
 {
     // Switch to descending ramp; actual stop and timer disable happens in update
-    amp_step_up     = 0.0f;
-    amp_step_down   = -(1.0f / (float)RAMP_TICKS);
+    // (from the load search too, the bridge is off or at the start of a burst)
+    if (state == SINEGEN_RAMP_UP || state == SINEGEN_RUN ||
+        state == SINEGEN_SEARCH || state == SINEGEN_PROBE)
+        state = SINEGEN_RAMP_DOWN;
+}
+
+void SineGen_SetCallbacks(SineGenCallback_t run, SineGenCallback_t idle)
+{
+    __disable_irq();
+    on_run  = run;
+    on_idle = idle;
+    __enable_irq();
+}
+
+// The ISR only flags the events: the callbacks run here, in the main loop,
+// and take no time from the modulation
+void SineGen_Poll(void)
+{
+    __disable_irq();
+    uint8_t run  = run_event;
+    uint8_t idle = idle_event;
+    run_event  = 0;
+    idle_event = 0;
+    __enable_irq();
+
+    if (run && on_run != NULL)
+        on_run();
+    if (idle && on_idle != NULL)
+        on_idle();
+}
+
+int SineGen_SetRamp(SineRamp_t curve, uint16_t ms, uint16_t i_limit)
+{
+    uint32_t ticks = ((uint32_t)UPDATE_FREQ_HZ * ms) / 1000u;
+
+    if (curve > SINE_RAMP_SCURVE5 || ticks == 0)
+        return -1;
+
+    __disable_irq();
+    ramp_curve   = curve;
+    ramp_step    = AMP_FULL / ticks;
+    ramp_i_limit = i_limit;
+    __enable_irq();
+    return 0;
+}
+
+void SineGen_SetAmpLimit(SineLimit_t src, uint16_t q15)
+{
+    if (src >= SINE_LIMIT_COUNT)
+        return;
+
+    __disable_irq();
+    amp_lims[src] = (q15 > 32767) ? 32767 : q15;
+    uint16_t lim = 32767;
+    for (uint32_t i = 0; i < SINE_LIMIT_COUNT; i++)
+        if (amp_lims[i] < lim)
+            lim = amp_lims[i];
+    amp_lim_set = lim;
+    __enable_irq();
+}
+
+void SineGen_SetDtComp(uint8_t on)
+{
+    dtcomp_on = on;
+}
+
+void SineGen_SetRepetitive(uint8_t on)
+{
+    rc_on = on;
+}
+
+SineGenState_t SineGen_GetState(void)
+{
+    return state;
+}
+
+int32_t SineGen_GetDcTrim(void)
+{
+    return dc_trim;
+}
+
+uint8_t SineGen_DcTrimFailed(void)
+{
+    return dc_trim_off;
+}
+
+int SineGen_SetSearch(uint32_t idle_ms, uint32_t every_ms)
+{
+    uint32_t every = (every_ms * SINE_FREQ_HZ) / 1000;
+
+    if (idle_ms != 0 && every < SEARCH_BURST_CYCLES)
+        return -1;
+
+    __disable_irq();
+    search_idle  = (idle_ms * SINE_FREQ_HZ) / 1000;
+    if (idle_ms != 0 && search_idle == 0)
+        search_idle = 1;
+    search_every = every;
+    __enable_irq();
+    return 0;
+}
+
+int SineGen_SetSync(uint8_t on)
+{
+    if (bypass_state != BYPASS_OFF || bypass_req)
+        return -1;
+
+    if (on && !sync_on) {
+        Pll_Reset();
+        __disable_irq();
+        sync_on = 1;
+        if (state == SINEGEN_IDLE) {
+            // keep the index running with the bridge off
+            sine_idx = 0;
+            AdcIn_Trigger();
+            HAL_TIM_Base_Start_IT(&htim6);
+        }
+        __enable_irq();
+    } else if (!on && sync_on) {
+        __disable_irq();
+        sync_on    = 0;
+        TIM6->ARR  = (PLL_TIM_HZ / UPDATE_FREQ_HZ) - 1;
+        if (state == SINEGEN_IDLE)
+            HAL_TIM_Base_Stop_IT(&htim6);
+        __enable_irq();
+    }
+    return 0;
+}
+
+uint8_t SineGen_SyncLocked(void)
+{
+    return sync_on && Pll_Locked();
+}
+
+int SineGen_Bypass(uint8_t on)
+{
+    if (!sync_on)
+        return -1;
+    bypass_req = on;
+    return 0;
+}
+
+uint8_t SineGen_InBypass(void)
+{
+    return bypass_state != BYPASS_OFF;
+}
+
+// Dead band of the dead-time compensation. The dead time only costs
+// volt-seconds while the load current stays above half the ripple, so
+// the body diode of one leg side carries it through the whole dead time;
+// the heavier the load, the closer to the zero crossing that starts.
+static void DtComp_Load(uint16_t i_bat)
+{
+    load_f += ((int32_t)i_bat - load_f) >> DTCOMP_LOAD_SHIFT;
+
+    if (sine_idx == 0) {
+        int32_t lvl = (load_f < DTCOMP_LOAD_FULL) ? load_f : DTCOMP_LOAD_FULL;
+        if (lvl < 0)
+            lvl = 0;
+        dt_band = DTCOMP_BAND_LIGHT -
+                  ((DTCOMP_BAND_LIGHT - DTCOMP_BAND_FULL) * lvl) / DTCOMP_LOAD_FULL;
+    }
+}
+
+// Amplitude (Q24) at a point (Q24) of the ramp profile
+static int32_t Ramp_Curve(int32_t pos)
+{
+    uint32_t x = (uint32_t)pos >> 9;            // Q15, 0..32768
+    uint32_t x2, x3, y;
+
+    switch (ramp_curve) {
+    case SINE_RAMP_SCURVE:
+        // 3x^2 - 2x^3: no step in the slope at either end
+        x2 = (x * x) >> 15;
+        y  = (x2 * (3u * 32768u - 2u * x)) >> 15;
+        break;
+    case SINE_RAMP_SCURVE5:
+        // 6x^5 - 15x^4 + 10x^3 = x^3 (10 - 15x + 6x^2): no step in the curvature either
+        x2 = (x * x) >> 15;
+        x3 = (x2 * x) >> 15;
+        y  = (x3 * ((10u << 12) - 15u * (x >> 3) + 6u * (x2 >> 3))) >> 12;
+        break;
+    default:
+        y = x;
+        break;
+    }
+    return (int32_t)(y << 9);
+}
+
+// Ramp-up progress for this update out of step: all of it, half within a
+// quarter of the current limit, none above it
+static uint32_t Ramp_Rate(uint32_t step)
+{
+    if (ramp_i_limit == 0 || load_f < (int32_t)(ramp_i_limit - (ramp_i_limit >> 2))) {
+        ramp_hold = 0;
+        return step;
+    }
+    if (load_f < (int32_t)ramp_i_limit) {
+        ramp_hold = 0;
+        return step >> 1;
+    }
+    ramp_hold++;
+    return 0;
+}
+
+// Integrate the output DC once per period. u_out is the previous sample
+// period's reading; any SINE_SAMPLES consecutive samples cover one period.
+// The zero is only taken from a period the bridge spent at zero amplitude.
+// A trim held at DCTRIM_MAX by an error that keeps pushing it further is
+// either saturated or feeding the offset it should cancel (polarity wrong).
+// After DCTRIM_DIVERGE_PERIODS at full amplitude it is backed off to 0 for
+// one period, once per run: if the error moved against the trim step (by
+// more ADC counts than an eighth of the Q15 trim; a full trim step moves it
+// by thousands) the trim is switched off for good, else it goes back to the
+// limit.
+static void DcTrim_Update(uint16_t u_out)
+{
+    if (amplitude != 0)
+        dc_quiet = 0;
+    dc_sum += u_out;
+    if (++dc_count < SINE_SAMPLES)
+        return;
+
+    if (!dc_zero_valid) {
+        // the ramp waits for this (SineGen_Update()), take it as the zero
+        if (dc_quiet) {
+            dc_zero       = dc_sum;
+            dc_zero_valid = 1;
+            rc_zero       = dc_sum / SINE_SAMPLES;
+        }
+    } else if (!dc_trim_off) {
+        // DC in the direction of positive shape values, in summed ADC counts
+        int32_t err  = (dc_sum - dc_zero) * DCTRIM_UOUT_POLARITY;
+        int32_t trim = dc_trim - (err >> DCTRIM_SHIFT);
+        if (trim > DCTRIM_MAX)
+            trim = DCTRIM_MAX;
+        else if (trim < -DCTRIM_MAX)
+            trim = -DCTRIM_MAX;
+
+        if (dc_probe) {
+            // one period with the trim backed off to 0: a correct trim moves
+            // the error the way the trim moved, a wrong one the other way
+            int32_t d = err - dc_err_pin;
+            int32_t t = dc_trim_pin >> 3;
+            dc_probe  = 0;
+            if ((t > 0 && d > t) || (t < 0 && d < t)) {
+                dc_trim_off = 1;
+                trim        = 0;
+            } else {
+                trim = dc_trim_pin;
+            }
+        } else if ((trim == DCTRIM_MAX && err < 0) || (trim == -DCTRIM_MAX && err > 0)) {
+            // at the limit and pushing further: saturated, or diverging
+            if (++dc_pinned >= DCTRIM_DIVERGE_PERIODS && state == SINEGEN_RUN && !dc_probed) {
+                dc_probed   = 1;
+                dc_probe    = 1;
+                dc_err_pin  = err;
+                dc_trim_pin = trim;
+                trim        = 0;
+            }
+        } else {
+            dc_pinned = 0;
+        }
+        dc_trim = trim;
+    }
+    dc_sum   = 0;
+    dc_count = 0;
+    dc_quiet = 1;
+}
+
+// Repetitive controller, learning half. u_out was sampled while the CCRs
+// written RC_DELAY updates ago were in effect, so it is compared with the
+// reference of that index and corrects it for the next period.
+static void RC_Learn(uint16_t u_out, int32_t amp, uint8_t learn)
+{
+    uint32_t k  = (sine_idx >= RC_DELAY) ? sine_idx - RC_DELAY : sine_idx + SINE_SAMPLES - RC_DELAY;
+    uint32_t kq = (k < SINE_SAMPLES - SINE_SAMPLES / 4) ? k + SINE_SAMPLES / 4
+                                                        : k - (SINE_SAMPLES - SINE_SAMPLES / 4);
+    int32_t  r  = (shape_active[k] * (amp >> 9)) >> 15;
+    int32_t  q  = (shape_active[kq] * (amp >> 9)) >> 15;
+    int32_t  y  = ((int32_t)u_out - rc_zero) * DCTRIM_UOUT_POLARITY;
+
+    // fundamental of the output against the reference, in and out of phase
+    rc_mr += y * (r >> 4);
+    rc_mq += y * (q >> 4);
+    rc_rr += (r >> 4) * (r >> 4);
+
+    if (learn && rc_scale > 0) {
+        // what is left once the output is scaled to the reference and
+        // its phase error removed: the distortion
+        int32_t  e  = r - ((y * rc_scale) >> 4) + ((q * rc_quad) >> 15);
+        uint32_t kl = (k > 0) ? k - 1 : SINE_SAMPLES - 1;
+        uint32_t kr = (k < SINE_SAMPLES - 1) ? k + 1 : 0;
+
+        // smoothed over the neighbours and leaking, so nothing the loop
+        // cannot correct (noise, the carrier) builds up
+        int32_t c = (rc_corr[kl] + 2 * rc_corr[k] + rc_corr[kr]) >> 2;
+        c -= c >> RC_LEAK_SHIFT;
+        // at full modulation the tops cannot go higher: don't wind up there
+        if (!((r + c >= 32767 && e > 0) || (r + c <= -32767 && e < 0)))
+            c += e >> RC_GAIN_SHIFT;
+        if (c > RC_MAX)
+            c = RC_MAX;
+        else if (c < -RC_MAX)
+            c = -RC_MAX;
+        rc_corr[k] = (int16_t)c;
+    }
+
+    if (sine_idx == 0) {
+        // no learning until the output follows the reference
+        if ((rc_mr >> 15) > 0) {
+            rc_scale = rc_rr / (rc_mr >> 8);
+            rc_quad  = rc_mq / (rc_mr >> 15);
+            if (rc_scale > 0x7FFF)
+                rc_scale = 0x7FFF;
+            if (rc_quad > 32767)
+                rc_quad = 32767;
+            else if (rc_quad < -32767)
+                rc_quad = -32767;
+        } else {
+            rc_scale = 0;
+            rc_quad  = 0;
+        }
+        rc_mr = rc_mq = rc_rr = 0;
+    }
+}
+
+// One PLL step. The ADC_U_IN result is from the scan started one update
+// ago, i.e. it belongs to the previous index. TIM6 has no ARR preload; the
+// ISR runs a few ticks after the update event, far below any new ARR.
+static void Sync_Update(uint16_t u_in)
+{
+    uint32_t k = sine_idx + (SINE_SAMPLES - 1) + SYNC_PHASE_TRIM;
+    if (k >= SINE_SAMPLES)
+        k -= SINE_SAMPLES;
+    if (k >= SINE_SAMPLES)
+        k -= SINE_SAMPLES;
+
+    TIM6->ARR = Pll_Update(u_in, k) - 1u;
+}
+
+// True when the output crosses zero n updates from now, n < SINE_SAMPLES / 2
+// (BYPASS_PHASE()): k is below three half-cycles, two steps bring it down
+static uint8_t Zero_In(uint16_t n)
+{
+    uint32_t k = sine_idx + n;
+    if (k >= SINE_SAMPLES)
+        k -= SINE_SAMPLES;
+    if (k >= SINE_SAMPLES / 2)
+        k -= SINE_SAMPLES / 2;
+    return k == 0;
+}
+
+// Bypass relay sequencing, once per update. The relay is timed so that its
+// contacts move at a zero crossing of the output; with the bridge running
+// that needs the lock, or the two sources would meet out of phase.
+static void Bypass_Step(void)
+{
+    uint8_t locked = Pll_Locked();
+
+    switch (bypass_state) {
+    case BYPASS_OFF:
+        if (!bypass_req)
+            break;
+        if (state != SINEGEN_IDLE && !locked)
+            break;
+        if (locked && !Zero_In(BYPASS_PHASE(BYPASS_CLOSE_US)))
+            break;
+        HAL_GPIO_WritePin(BYPASS_ENABLE_GPIO_Port, BYPASS_ENABLE_Pin, GPIO_PIN_SET);
+        bypass_wait  = BYPASS_SAMPLES(BYPASS_CLOSE_US + BYPASS_OVERLAP_US);
+        bypass_state = BYPASS_CLOSING;
+        break;
+
+    case BYPASS_CLOSING:
+        if (bypass_wait > 0) {
+            bypass_wait--;
+            break;
+        }
+        // the mains holds the output now
+        if (state != SINEGEN_IDLE)
+            Run_Off();
+        bypass_state = BYPASS_ON;
+        break;
+
+    case BYPASS_ON:
+        if (bypass_req)
+            break;
+        // no mains left: there is no phase to wait for
+        if (locked && !Zero_In(BYPASS_PHASE(BYPASS_OPEN_US)))
+            break;
+        HAL_GPIO_WritePin(BYPASS_ENABLE_GPIO_Port, BYPASS_ENABLE_Pin, GPIO_PIN_RESET);
+        bypass_wait  = BYPASS_SAMPLES(BYPASS_OPEN_US);
+        bypass_state = BYPASS_OPENING;
+        break;
+
+    case BYPASS_OPENING:
+        // the contacts part during the update bypass_wait counts down to:
+        // that is the zero crossing, take over there, not half a period on
+        if (bypass_wait > 0 && --bypass_wait > 0)
+            break;
+        if (sine_idx != 0 && sine_idx != SINE_SAMPLES / 2)
+            break;
+        // contacts open: the load is the bridge's again, at full amplitude
+        if (state == SINEGEN_IDLE && soft_state == SOFT_IDLE && !Overload_Tripped() &&
+            !Battery_Lockout())
+            Run_Setup(1);
+        bypass_state = BYPASS_OFF;
+        break;
+    }
+}
+
+// Bridge off for the load search; the ISR keeps the index running
+static void Search_Sleep(void)
+{
+    Bridge_Stop();
+    amplitude  = 0;
+    ramp_pos   = 0;
+    search_cnt = 0;
+    state      = SINEGEN_SEARCH;
+}
+
+// Load search, one decision per period at index 0 on the mean ADC_BAT_LOAD
+// of the period before. Returns 1 while the bridge sleeps: nothing else to
+// do in this update.
+static uint8_t Search_Step(uint16_t i_bat)
+{
+    if (state == SINEGEN_RUN || state == SINEGEN_PROBE)
+        search_sum += i_bat;
+
+    if (sine_idx == 0) {
+        uint8_t loaded = search_sum >= (uint32_t)SEARCH_LOAD_MIN * SINE_SAMPLES;
+        search_sum = 0;
+
+        switch (state) {
+        case SINEGEN_RUN:
+            if (search_idle == 0 || loaded)
+                search_cnt = 0;
+            else if (++search_cnt >= search_idle)
+                Search_Sleep();
+            break;
+
+        case SINEGEN_SEARCH:
+            // search turned off: wake at once
+            if (search_idle == 0 || ++search_cnt >= search_every) {
+                search_cnt  = 0;
+                ramp_pos    = 0;
+                ramp_hold   = 0;
+                state       = SINEGEN_PROBE;
+                TIM16->CCR1 = ccr_period / 2;
+                TIM17->CCR1 = ccr_period / 2;
+                Bridge_Start();
+            }
+            break;
+
+        case SINEGEN_PROBE:
+            // the first period ramps up, the others are measured
+            if (++search_cnt < 2)
+                break;
+            if (loaded || search_idle == 0) {
+                // stay on, ramping on where the current limit held the probe;
+                // the DC trim restarts on whole periods
+                search_cnt = 0;
+                ramp_hold  = 0;
+                dc_sum     = 0;
+                dc_count   = 0;
+                state      = (ramp_pos < (int32_t)AMP_FULL) ? SINEGEN_RAMP_UP : SINEGEN_RUN;
+            } else if (search_cnt >= SEARCH_BURST_CYCLES) {
+                Search_Sleep();
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    if (state != SINEGEN_SEARCH)
+        return 0;
+    if (++sine_idx >= SINE_SAMPLES)
+        sine_idx = 0;
+    return 1;
 }
 
 void SineGen_Update(void)
 {
-    // advance amplitude
-    amplitude += (amp_step_up != 0.0f ? amp_step_up : amp_step_down);
-    if (amplitude >= 1.0f) {
-        amplitude = 1.0f;
-    } else if (amplitude <= 0.0f) {
-        amplitude = 0.0f;
-        // Stop TIM6 interrupt and bridge
-        HAL_TIM_Base_Stop_IT(&htim6);
-        Bridge_Stop();
+    // results of the scan started one sample ago, then start the next one
+    uint16_t u_out = AdcIn_Get(ADCIN_U_OUT);
+    uint16_t i_bat = AdcIn_Get(ADCIN_BAT_LOAD);
+    uint16_t u_in  = AdcIn_Get(ADCIN_U_IN);
+    AdcIn_Trigger();
+
+    Overload_Sample(i_bat);
+    Battery_Sample(AdcIn_Get(ADCIN_BAT_V), AdcIn_Get(ADCIN_BAT_GND), i_bat);
+    Soc_Sample(i_bat);
+    Meter_Sample(u_out, i_bat, sine_idx);
+
+    if (sync_on) {
+        Sync_Update(u_in);
+        Bypass_Step();
+        if (state == SINEGEN_IDLE) {
+            // tracking only: the phase runs on, the bridge stays off
+            if (++sine_idx >= SINE_SAMPLES)
+                sine_idx = 0;
+            return;
+        }
+    }
+
+    if (Search_Step(i_bat))
         return;
+
+    if (state != SINEGEN_PROBE)
+        DcTrim_Update(u_out);
+    DtComp_Load(i_bat);
+
+    // advance amplitude along the ramp profile
+    int32_t amp = amplitude;
+    if (state == SINEGEN_RAMP_UP) {
+        // nothing until the DC trim has its zero reference: the first period
+        // is measured at zero output (past zero there is no waiting for one)
+        if (dc_zero_valid || amplitude != 0)
+            ramp_pos += Ramp_Rate(ramp_step);
+        if (ramp_pos >= (int32_t)AMP_FULL) {
+            ramp_pos = AMP_FULL;
+            state     = SINEGEN_RUN;
+            run_event = 1;
+        } else if (ramp_hold >= RAMP_STALL_TICKS) {
+            // the load never lets go of the limit: give up and ramp down
+            state = SINEGEN_RAMP_DOWN;
+        }
+        amp = Ramp_Curve(ramp_pos);
+    } else if (state == SINEGEN_PROBE) {
+        // probe burst: up in one period, held back by the current limit like
+        // the soft start (a load pulling it down is found all the same)
+        ramp_pos += Ramp_Rate(AMP_FULL / SINE_SAMPLES);
+        if (ramp_pos > (int32_t)AMP_FULL)
+            ramp_pos = AMP_FULL;
+        amp = Ramp_Curve(ramp_pos);
+    } else if (state == SINEGEN_RAMP_DOWN) {
+        ramp_pos -= ramp_step;
+        if (ramp_pos < 0)
+            ramp_pos = 0;
+        amp = Ramp_Curve(ramp_pos);
+        if (amp <= 0) {
+            amp = 0;
+            // finish on a half-cycle boundary so both halves stay balanced
+            if (sine_idx == 0 || sine_idx == SINE_SAMPLES / 2) {
+                Run_Off();
+                return;
+            }
+        }
+    }
+    amplitude = amp;
+
+    // derating applies to the reference as a whole, RC and DC trim included
+    if (amp_lim < amp_lim_set)
+        amp_lim++;
+    else if (amp_lim > amp_lim_set)
+        amp_lim--;
+    if (amp_lim < 32767)
+        amp = (int32_t)(((uint32_t)amp >> 8) * amp_lim >> 7);
+
+    // new shape: switch tables at the positive-going zero crossing
+    if (sine_idx == 0 && shape_pending != NULL) {
+        shape_active  = shape_pending;
+        shape_pending = NULL;
     }
 
+    if (rc_on && dc_zero_valid)
+        RC_Learn(u_out, amp, state == SINEGEN_RUN);
+
+    // new or dithered carrier: rescale from this sample on
+    uint16_t arr = 0;
+    if (carrier_arr != 0)
+        arr = Carrier_Apply(carrier_arr);
+    else if (dither_mask != 0)
+        arr = Carrier_Dither();
+
     // get next sample
-    uint16_t raw = sine_table[sine_idx++];
-    if (sine_idx >= SINE_SAMPLES)
+    uint32_t idx = sine_idx;
+    int32_t  s   = shape_active[idx];
+    if (++sine_idx >= SINE_SAMPLES)
         sine_idx = 0;
 
-    // scale and write
-    uint16_t ccr = (uint16_t)(raw * amplitude);
-    TIM16->CCR1 = ccr;
-    TIM17->CCR1 = ccr;
+    // scale about 50% duty: Q15 * Q15 -> Q15, then to timer counts
+    s = (s * (amp >> 9)) >> 15;
+
+    // learnt correction, scaled with the amplitude for the ramps
+    if (rc_on)
+        s += (rc_corr[idx] * (amp >> 9)) >> 15;
+
+    // volt-second balance: widen one half-cycle, narrow the other
+    if (s > 0)
+        s += (s * dc_trim) >> 15;
+    else
+        s -= (s * dc_trim) >> 15;
+    if (s > 32767)
+        s = 32767;
+    else if (s < -32767)
+        s = -32767;
+    // duty = (1 + s) / 2 of the period these CCRs will be latched with
+    int32_t ccr = (int32_t)((ccr_period * (uint32_t)(s + 32768)) >> 16);
+
+    // dead-time compensation: current flowing out of a leg during the dead
+    // time holds it low (and high when flowing in), which costs dead-time
+    // ticks of bridge voltage against the current on each leg. Moving both
+    // CCRs by that amount towards the current polarity gives it back.
+    if (dtcomp_on) {
+        uint32_t j = (idx >= DTCOMP_LAG) ? idx - DTCOMP_LAG : idx + SINE_SAMPLES - DTCOMP_LAG;
+        int32_t  p = (shape_active[j] * (amp >> 9)) >> 15;
+        int32_t  m = ((p < 0) ? -p : p) - dt_band;
+        if (m > 0) {
+            if (m > (1 << DTCOMP_RAMP_SHIFT))
+                m = 1 << DTCOMP_RAMP_SHIFT;
+            m = (dt_ticks * m) >> DTCOMP_RAMP_SHIFT;
+            ccr += (p > 0) ? m : -m;
+            if (ccr < 0)
+                ccr = 0;
+            else if (ccr > ccr_period)
+                ccr = ccr_period;
+        }
+    }
+
+    Bridge_Write(arr, (uint32_t)ccr);
+
+    PwmLog_Sample((uint16_t)ccr, (uint16_t)ccr);
 }
 
 // Hook into HAL's period-elapsed callback
@@ -13,18 +13,153 @@ extern "C" {
 // Desired output frequency (Hz)
 #define SINE_FREQ_HZ     50
 
-// Total soft-ramp time (ms)
+// Soft-ramp time at light load (ms) after reset; the current limit stretches
+// it, SineGen_SetRamp() sets another
 #define SOFT_MS       1000
 
+// Ramp current limit: filtered ADC_BAT_LOAD reading above which the ramp
+// holds (slows down from 3/4 of it on); 0 = no limit (placeholder, ~2 A)
+#define RAMP_I_LIMIT   250
+// Held at the limit this long without progress: ramp down again (ms)
+#define RAMP_STALL_MS 2000
+// Profile after reset, see SineRamp_t
+#define RAMP_DEFAULT_CURVE  SINE_RAMP_SCURVE
+
+// DC trim (volt-second balance from ADC_U_OUT):
+// +1 if the ADC_U_OUT reading rises when the CCRs rise above 50% duty, -1 if
+// it falls (TIM16 in PWM2 and TIM17 in PWM1 make the bridge voltage fall)
+#define DCTRIM_UOUT_POLARITY  (-1)
+// Largest gain difference between the half-cycles, Q15 (1638 = 5%)
+#define DCTRIM_MAX            1638
+// Integral gain: trim changes by the per-period ADC sum >> DCTRIM_SHIFT
+#define DCTRIM_SHIFT          4
+// Periods at DCTRIM_MAX, still pushed further, before the trim is backed off
+// for a period to tell saturation from divergence (wrong polarity)
+#define DCTRIM_DIVERGE_PERIODS  10
+
+// Dead-time compensation; off until the band and lag are trimmed on the
+// bench: as set here it raises the plant's THD on R-L and rectifier loads
+#define DTCOMP_DEFAULT_ON     0
+// Samples the bridge current lags the reference (magnetising current, filter)
+#define DTCOMP_LAG            8
+// Dead band around the current zero crossings, as |reference| in Q15:
+// at no load and at DTCOMP_LOAD_FULL, interpolated in between
+#define DTCOMP_BAND_LIGHT     21300
+#define DTCOMP_BAND_FULL      9000
+// Past the dead band the correction ramps up to the full dead time over 2^n
+#define DTCOMP_RAMP_SHIFT     12
+// Filtered ADC_BAT_LOAD reading for DTCOMP_BAND_FULL (placeholder, ~1.5 A)
+#define DTCOMP_LOAD_FULL      200
+// ADC_BAT_LOAD filter: 2^n samples
+#define DTCOMP_LOAD_SHIFT     5
+
+// Repetitive controller (per-index correction learnt from ADC_U_OUT)
+#define RC_DEFAULT_ON         1
+// Updates from a CCR write to its effect on the ADC_U_OUT reading
+#define RC_DELAY              2
+// Learning gain 2^-n of the error; leak 2^-n of the correction per period
+#define RC_GAIN_SHIFT         3
+#define RC_LEAK_SHIFT         6
+// Largest correction, Q15 (6554 = 20%)
+#define RC_MAX                6554
+
+// Load search (sleep): once the mean ADC_BAT_LOAD of every period has stayed
+// below SEARCH_LOAD_MIN for the idle time, the bridge switches off and
+// probes every few seconds with a burst of SEARCH_BURST_CYCLES periods (one
+// ramping, within the RAMP_I_LIMIT current limit, the rest measured); a load
+// seen in a burst keeps the output on from there. See SineGen_SetSearch().
+#define SEARCH_DEFAULT_ON     0
+#define SEARCH_IDLE_MS        10000
+#define SEARCH_EVERY_MS       2000
+#define SEARCH_BURST_CYCLES   3
+// Placeholder above the no-load (magnetising) reading: ADC_BAT_LOAD counts,
+// ~0.34 A of battery current at BATTERY_MA_FULL (33 A full scale)
+#define SEARCH_LOAD_MIN       42
+
+// Mains sync (SineGen_SetSync()) after reset; off until SYNC_PHASE_TRIM and
+// the BYPASS_* times below are set for the board's U_IN divider and relay
+#define SYNC_DEFAULT_ON       0
+// Samples the output zero crossing lags table index 0, 0..SINE_SAMPLES-1.
+// The PLL aligns index 0 with the mains; trim on the bench until U_OUT and
+// U_IN cross zero together.
+#define SYNC_PHASE_TRIM       0
+
+// Bypass relay on BYPASS_ENABLE (high: output on the mains). Contact operate
+// and release times, and how long the bridge keeps driving once the
+// contacts have closed (us); placeholders until the relay is chosen
+#define BYPASS_CLOSE_US       8000
+#define BYPASS_OPEN_US        4000
+#define BYPASS_OVERLAP_US     1000
+
+// Carrier range for Bridge_SetCarrier() (default 16 kHz, ARR 2999). Every
+// TIM6 sample (200 us) needs an update event of its own, dithered periods
+// (+6%) included, or the ISR reads back an ARR that has not latched yet
+#define CARRIER_MIN_HZ     8000
+#define CARRIER_MAX_HZ    32000
+// Ticks before an update event in which the ISR holds off its ARR and CCR
+// stores: from the CNT read to the last of the four stores, ~40 cycles on
+// the M0 with one flash wait state, plus margin. The wait is part of the
+// ISR budget (every sample).
+#define CARRIER_GUARD_TICKS  64
+// Most reads of TIM16->CNT in that wait. A read and compare take more than
+// one tick (TIM16 at the core clock), so this covers the guard; it is the
+// Bridge_Write loop bound in Tools/isr_budget.args.
+#define CARRIER_GUARD_POLLS  CARRIER_GUARD_TICKS
+
 // Computed update rate (Hz)
 #define UPDATE_FREQ_HZ  (SINE_SAMPLES * SINE_FREQ_HZ)
 
 // Number of ticks for ramping = UPDATE_FREQ_HZ * (SOFT_MS/1000)
 #define RAMP_TICKS     ((UPDATE_FREQ_HZ * SOFT_MS) / 1000)
 
+typedef enum {
+    SINEGEN_IDLE = 0,               // bridge off
+    SINEGEN_RAMP_UP,
+    SINEGEN_RUN,
+    SINEGEN_RAMP_DOWN,              // ends at the next half-cycle boundary
+    SINEGEN_SEARCH,                 // load search: no load, bridge off between probes
+    SINEGEN_PROBE,                  // load search: test burst
+} SineGenState_t;
+
+// Waveform shapes for SineGen_BuildShape()
+typedef enum {
+    SINE_SHAPE_SINE = 0,            // pure sine
+    SINE_SHAPE_THIRD_HARMONIC,      // sine + param % 3rd harmonic, peak normalised
+    SINE_SHAPE_FLAT_TOP,            // sine clipped at param % of the peak
+} SineShape_t;
+
+// Soft-start / soft-stop amplitude profiles for SineGen_SetRamp()
+typedef enum {
+    SINE_RAMP_LINEAR = 0,
+    SINE_RAMP_SCURVE,               // 3x^2 - 2x^3
+    SINE_RAMP_SCURVE5,              // 6x^5 - 15x^4 + 10x^3
+} SineRamp_t;
+
+// Sources of SineGen_SetAmpLimit(); the lowest limit applies
+typedef enum {
+    SINE_LIMIT_THERMAL = 0,         // thermal.c
+    SINE_LIMIT_OVERLOAD,            // overload.c
+    SINE_LIMIT_COUNT,
+} SineLimit_t;
+
+// Completion callbacks for SineGen_SetCallbacks() / Bridge_SoftStart()
+typedef void (*SineGenCallback_t)(void);
+typedef void (*BridgeDone_t)(void);
+
 // Initialize sine generator (build table and configure TIM6)
 void SineGen_Init(void);
 
+// Fill dst[SINE_SAMPLES] with a Q15 shape (peak +-32767). Returns 0, or -1
+// (dst untouched) for an unknown shape or a flat top outside 1..100 %.
+int SineGen_BuildShape(int16_t *dst, SineShape_t shape, uint16_t param);
+
+// Queue a Q15 shape table; it takes effect at the next positive zero crossing.
+// Returns 0, or -1 while the previous shape is still pending.
+int SineGen_LoadShape(const int16_t *shape);
+
+// Non-zero while a loaded shape is waiting for its zero crossing
+int SineGen_ShapePending(void);
+
 // Start sine generation with soft-start ramp
 void SineGen_Start(void);
 
@@ -33,7 +168,81 @@ void SineGen_Stop(void);
 
 void SineGen_Update(void);
 
-void Bridge_SoftStart(void);
+// Completion callbacks, either may be NULL: run when the ramp-up reaches
+// full amplitude, idle when the ramp-down has switched the bridge off (also
+// after a stalled start). Both are called from SineGen_Poll(), in the main
+// loop, at the first poll after the event.
+void SineGen_SetCallbacks(SineGenCallback_t run, SineGenCallback_t idle);
+
+// Main loop: runs the completion callbacks the TIM6 ISR has flagged
+void SineGen_Poll(void);
+
+SineGenState_t SineGen_GetState(void);
+
+// Ramp profile, time at light load (ms) and ADC_BAT_LOAD limit (0 = none)
+// for the following starts and stops; -1 if out of range
+int SineGen_SetRamp(SineRamp_t curve, uint16_t ms, uint16_t i_limit);
+
+// Limit the output amplitude to q15 / 32768 of full for one source (thermal,
+// overload derating); a change is slewed over a few seconds while running
+void SineGen_SetAmpLimit(SineLimit_t src, uint16_t q15);
+
+// Enable/disable the dead-time compensation
+void SineGen_SetDtComp(uint8_t on);
+
+// Enable/disable the repetitive controller (the correction is cleared by
+// SineGen_Start())
+void SineGen_SetRepetitive(uint8_t on);
+
+// Load search: bridge off after idle_ms without load, probing every
+// every_ms; idle_ms = 0 turns it off (a sleeping output wakes at once).
+// -1 if every_ms is shorter than a burst.
+int SineGen_SetSearch(uint32_t idle_ms, uint32_t every_ms);
+
+// Track the ADC_U_IN mains phase and frequency with the modulator (TIM6
+// keeps running while idle, bridge off). -1 while on or switching bypass.
+int SineGen_SetSync(uint8_t on);
+
+// Non-zero while the modulator is phase-locked to the mains
+uint8_t SineGen_SyncLocked(void);
+
+// Bypass transfer, needs SineGen_SetSync(1), else -1. on: close the relay
+// at a zero crossing (in phase with the mains while the bridge runs) and
+// stop the bridge once the contacts have closed. off: open the relay and
+// take the load over at full amplitude at the next zero crossing.
+int SineGen_Bypass(uint8_t on);
+
+// Non-zero while the relay is closed or switching
+uint8_t SineGen_InBypass(void);
+
+// Current half-cycle gain trim, Q15
+int32_t SineGen_GetDcTrim(void);
+
+// Non-zero once the DC trim has diverged (DCTRIM_UOUT_POLARITY wrong for
+// the hardware) and been switched off; until reset
+uint8_t SineGen_DcTrimFailed(void);
+
+// Non-blocking open-loop duty ramp 0 -> 50% (debug); Bridge_SoftPoll() from
+// the main loop advances it and calls done (may be NULL) at the end.
+// -1 if a ramp or the sine generator is already running.
+int Bridge_SoftStart(BridgeDone_t done);
+
+// Ramp the duty back to 0, then stop the bridge and call done; -1 if the
+// bridge was not soft-started
+int Bridge_SoftStop(BridgeDone_t done);
+
+void Bridge_SoftPoll(void);
+
+// Change the PWM carrier, glitch-free while running; -1 if out of range
+int Bridge_SetCarrier(uint32_t hz);
+
+uint32_t Bridge_GetCarrier(void);
+
+// Spread-spectrum carrier: dither ARR over +-span/2 ticks each sample, 0 = off.
+// span is cut to 1/8 of the period, also for a later Bridge_SetCarrier(). At
+// 16 kHz (Tools/carrier_spectrum.py) the carrier and its 2nd/3rd harmonic
+// drop by ~0.5/1.0/2.3 dB with span 128 and ~2.9/5.0/6.0 dB with 256.
+void Bridge_SetDither(uint16_t span);
 
 // TIM6 interrupt handler (hook into TIM6_DAC_IRQHandler)
 //void TIM6_DAC_IRQHandler(void);
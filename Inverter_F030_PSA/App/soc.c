@@ -0,0 +1,195 @@
+/**
+ * @file soc.c
+ * @brief Coulomb-counting state of charge with rest-voltage correction.
+ *
+ * The ISR only adds the 12-bit ADC_BAT_LOAD code (5000 samples/s, at most
+ * 20.5 M/s, so the 32-bit sum lasts over 200 s without a poll). The poll
+ * scales it by BATTERY_MA_FULL / (4096 * UPDATE_FREQ_HZ) into whole mAs and
+ * keeps the remainder, so nothing is lost to rounding over hours of small
+ * currents. The remaining charge is held in mAs (100 Ah = 3.6e8).
+ *
+ * While TIM6 is stopped there are no samples; the bridge then draws
+ * nothing and only SOC_QUIESCENT_MA is counted.
+ */
+
+#include "soc.h"
+#include "battery.h"
+#include "thermal.h"
+#include "sinegen.h"
+#include "telemetry.h"
+#include "stm32f0xx_hal.h"
+
+#define CAP_MAS     ((uint32_t)SOC_CAPACITY_MAH * 3600u)
+#define SUM_DIV     ((uint64_t)4096u * UPDATE_FREQ_HZ)
+
+#define TF_T0       (-200)          // first SOC_TEMP_FACTOR entry, 0.1 degC
+#define TF_STEP     100
+
+static const uint16_t ocv_table[]   = { SOC_OCV_TABLE };
+static const uint16_t temp_factor[] = { SOC_TEMP_FACTOR };
+static const uint16_t peukert[]     = { SOC_PEUKERT };
+#define OCV_POINTS  (sizeof(ocv_table) / sizeof(ocv_table[0]))
+#define TF_POINTS   (sizeof(temp_factor) / sizeof(temp_factor[0]))
+#define PK_POINTS   (sizeof(peukert) / sizeof(peukert[0]))
+#define I20_MA      (SOC_CAPACITY_MAH / 20u)
+
+static volatile uint32_t acc;       // ADC_BAT_LOAD codes since the last poll
+
+static uint32_t last_poll;
+static uint64_t rem;                // unconverted part, mA * samples * 4096
+static uint32_t q;                  // remaining charge, mAs
+static uint32_t i_f;                // charge drawn, mA << SOC_LOAD_SHIFT
+static uint32_t rest_s;
+static uint16_t soc;
+static uint32_t avail;              // mAh
+static uint16_t runtime = SOC_RUNTIME_MAX;
+
+void Soc_Sample(uint16_t i)
+{
+    acc += i;
+}
+
+uint16_t Soc_FromOcv(uint16_t mv)
+{
+    if (mv <= ocv_table[0])
+        return 0;
+    if (mv >= ocv_table[OCV_POINTS - 1])
+        return 1000;
+
+    uint32_t i = 0;
+    while (mv >= ocv_table[i + 1])
+        i++;
+
+    // ocv_table[i] <= mv < ocv_table[i + 1]
+    uint32_t span = ocv_table[i + 1] - ocv_table[i];
+    return (uint16_t)(i * (1000 / (OCV_POINTS - 1)) +
+                      ((mv - ocv_table[i]) * (1000 / (OCV_POINTS - 1)) + span / 2) / span);
+}
+
+// Usable fraction of the capacity at t (0.1 degC), Q15
+static uint16_t Temp_Factor(int16_t t)
+{
+    if (t <= TF_T0)
+        return temp_factor[0];
+    if (t >= TF_T0 + (int32_t)(TF_POINTS - 1) * TF_STEP)
+        return temp_factor[TF_POINTS - 1];
+
+    uint32_t i = (uint32_t)(t - TF_T0) / TF_STEP;
+    int32_t  d = (t - TF_T0) - (int32_t)i * TF_STEP;
+    return (uint16_t)(temp_factor[i] + ((int32_t)(temp_factor[i + 1] - temp_factor[i]) * d) / TF_STEP);
+}
+
+// Peukert factor at ma, Q12; linear within each octave of I20_MA
+static uint32_t Peukert(uint32_t ma)
+{
+    if (ma <= I20_MA)
+        return peukert[0];
+
+    uint32_t i = 0, lo = I20_MA;
+    while (ma >= 2 * lo)
+    {
+        if (++i >= PK_POINTS - 1)
+            return peukert[PK_POINTS - 1];
+        lo *= 2;
+    }
+    return peukert[i] + (peukert[i + 1] - peukert[i]) * (ma - lo) / lo;
+}
+
+static void Send_Status(uint16_t factor)
+{
+    uint8_t p[TELEMETRY_PAYLOAD];
+    Telemetry_Put16(&p[0], soc);
+    Telemetry_Put16(&p[2], runtime);
+    // usable charge in 0.01 Ah
+    Telemetry_Put16(&p[4], (uint16_t)(avail / 10 > 0xFFFF ? 0xFFFF : avail / 10));
+    p[6] = (uint8_t)((factor * 100u) >> 15);
+    p[7] = (rest_s != 0);
+    Telemetry_Send(TELEMETRY_SOC, p);
+}
+
+void Soc_Init(void)
+{
+    __disable_irq();
+    acc = 0;
+    __enable_irq();
+
+    rem       = 0;
+    q         = (uint32_t)(((uint64_t)Soc_FromOcv(Battery_GetVoltage()) * CAP_MAS) / 1000u);
+    i_f       = 0;
+    rest_s    = 0;
+    last_poll = HAL_GetTick();
+}
+
+void Soc_Poll(void)
+{
+    uint32_t now = HAL_GetTick();
+    uint32_t dt  = now - last_poll;
+    if (dt < SOC_PERIOD_MS)
+        return;
+    last_poll = now;
+
+    __disable_irq();
+    uint32_t a = acc;
+    acc = 0;
+    __enable_irq();
+
+    // bridge current to whole mAs, the rest carried
+    rem += (uint64_t)a * BATTERY_MA_FULL;
+    uint32_t used = (uint32_t)(rem / SUM_DIV);
+    rem -= (uint64_t)used * SUM_DIV;
+
+    uint32_t load = used * 1000u / dt;                  // mean bridge current, mA
+    used  = (used * Peukert(load + SOC_QUIESCENT_MA)) >> 12;
+    used += SOC_QUIESCENT_MA * dt / 1000u;
+    q = (q > used) ? q - used : 0;
+
+    // the runtime goes by the charge drawn (Peukert included, so pulses
+    // count at their own rate) and holds the last load through a rest
+    if (load >= SOC_REST_MA || (i_f >> SOC_LOAD_SHIFT) < SOC_REST_MA + SOC_QUIESCENT_MA)
+        i_f += used * 1000u / dt - (i_f >> SOC_LOAD_SHIFT);
+
+    // at rest the terminal voltage is the open-circuit voltage
+    if (load < SOC_REST_MA)
+    {
+        rest_s += dt / 1000u;
+        if (rest_s >= SOC_REST_S)
+        {
+            int32_t q_ocv = (int32_t)(((uint64_t)Soc_FromOcv(Battery_GetVoltage()) * CAP_MAS) / 1000u);
+            q      = (uint32_t)((int32_t)q + (q_ocv - (int32_t)q) / 2);
+            rest_s = 1;             // again after another SOC_REST_S
+        }
+    }
+    else
+    {
+        rest_s = 0;
+    }
+
+    // charge that can be taken out at this temperature
+    uint16_t factor = Temp_Factor(Thermal_SensorFault() ? SOC_TEMP_FAULT : Thermal_GetTemp());
+    uint32_t lost   = CAP_MAS - (uint32_t)(((uint64_t)CAP_MAS * factor) >> 15);
+    uint32_t q_use  = (q > lost) ? q - lost : 0;
+
+    soc   = (uint16_t)(((uint64_t)q * 1000u) / CAP_MAS);
+    avail = q_use / 3600u;
+
+    uint32_t i_load = i_f >> SOC_LOAD_SHIFT;
+    uint32_t mins   = (i_load != 0) ? q_use / i_load / 60u : SOC_RUNTIME_MAX;
+    runtime = (uint16_t)(mins > SOC_RUNTIME_MAX ? SOC_RUNTIME_MAX : mins);
+
+    Send_Status(factor);
+}
+
+uint16_t Soc_Get(void)
+{
+    return soc;
+}
+
+uint32_t Soc_GetAvailable(void)
+{
+    return avail;
+}
+
+uint16_t Soc_GetRuntime(void)
+{
+    return runtime;
+}
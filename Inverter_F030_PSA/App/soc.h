@@ -0,0 +1,86 @@
+#ifndef SOC_H
+#define SOC_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Battery state of charge and runtime at the present load.
+//
+// Coulomb counting: the TIM6 ISR adds every ADC_BAT_LOAD reading
+// (Soc_Sample()); once a second the sum is converted to mAs, carrying the
+// remainder, and taken off the remaining charge together with the
+// inverter's own consumption, the bridge current weighted by the Peukert
+// factor (high currents take more charge than they deliver). After a rest (current below SOC_REST_MA for
+// SOC_REST_S) the count is pulled halfway towards the open-circuit voltage
+// table, which also catches recharging the current sense cannot see. Cold
+// reduces the charge that can be taken out (SOC_TEMP_FACTOR over
+// ADC_BAT_Temp); the runtime is that usable charge over the filtered rate
+// it is drawn at, which holds the last load through a rest.
+//
+// Capacity and tables are placeholders for a 12 V lead-acid battery.
+// host/f030/test/test_soc.cpp runs this file against synthetic discharge
+// profiles.
+
+// Nominal capacity (mAh) and the inverter's own draw, not seen by
+// ADC_BAT_LOAD (mA)
+#define SOC_CAPACITY_MAH        100000
+#define SOC_QUIESCENT_MA        60
+
+// Soc_Poll() works at this interval (ms)
+#define SOC_PERIOD_MS           1000
+// Drawn-charge filter for the runtime: 2^n polls (256 s, two cycles of a
+// 2 / 20 A load pulsed every minute)
+#define SOC_LOAD_SHIFT          8
+
+// Rest: below this current (mA) for this long (s) the terminal voltage is
+// taken as the open-circuit voltage
+#define SOC_REST_MA             300
+#define SOC_REST_S              600
+
+// Open-circuit voltage (mV) at 0, 10 ... 100 % state of charge
+#define SOC_OCV_TABLE   11360, 11510, 11660, 11810, 11960, 12100, \
+                        12240, 12370, 12500, 12620, 12730
+
+// Peukert factor (Q12, 4096 = 1.0) at 1, 2, 4, 8, 16 x the 20-hour current
+// (SOC_CAPACITY_MAH / 20), interpolated in between: (I / I20)^(k - 1), k 1.1
+#define SOC_PEUKERT     4096, 4390, 4705, 5043, 5405
+
+// Usable fraction of the capacity (Q15) at -20, -10 ... 30 degC
+#define SOC_TEMP_FACTOR 19661, 22938, 26214, 29491, 31785, 32767
+// Temperature the table is read at while the NTC is faulted (0.1 degC)
+#define SOC_TEMP_FAULT          250
+
+// Runtime unknown (no load) or longer than this (min)
+#define SOC_RUNTIME_MAX         0xFFFF
+
+// State of charge from the open-circuit voltage (call after Battery_Init())
+void Soc_Init(void);
+
+// Called from SineGen_Update() with each ADC_BAT_LOAD reading
+void Soc_Sample(uint16_t i);
+
+// Main loop: once a second counts the charge, checks for rest, sends a
+// TELEMETRY_SOC frame
+void Soc_Poll(void);
+
+// State of charge of the nominal capacity, 0.1 %
+uint16_t Soc_Get(void);
+
+// Charge that can still be taken at the present temperature (mAh)
+uint32_t Soc_GetAvailable(void);
+
+// Runtime at the filtered load, the last one before a rest (min),
+// SOC_RUNTIME_MAX if unknown
+uint16_t Soc_GetRuntime(void);
+
+// Open-circuit voltage (mV) to state of charge (0.1 %), from the table
+uint16_t Soc_FromOcv(uint16_t mv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // SOC_H
@@ -0,0 +1,58 @@
+/**
+ * @file telemetry.c
+ * @brief Checksummed 10-byte frames on USART1, sent without blocking.
+ *
+ * Frames are built whole into a ring of TELEMETRY_QUEUE slots; Telemetry_Poll()
+ * writes the next byte to TDR each time TXE is set (two bytes per call at
+ * most: one into the shift register, one into TDR). At 115200 baud a frame
+ * takes 0.87 ms on the wire.
+ */
+
+#include "telemetry.h"
+#include "usart.h"
+#include "stm32f0xx_hal.h"
+
+static uint8_t  queue[TELEMETRY_QUEUE][TELEMETRY_FRAME];
+static uint8_t  head;               // next slot to fill
+static uint8_t  tail;               // slot being sent
+static uint8_t  pos;                // next byte of queue[tail]
+
+void Telemetry_Init(void)
+{
+    head = 0;
+    tail = 0;
+    pos  = 0;
+}
+
+int Telemetry_Send(uint8_t type, const uint8_t payload[TELEMETRY_PAYLOAD])
+{
+    uint8_t next = (uint8_t)((head + 1) % TELEMETRY_QUEUE);
+    if (next == tail)
+        return -1;
+
+    uint8_t *f  = queue[head];
+    uint8_t  cs = 0x55 ^ type;
+    f[0] = type;
+    for (uint32_t i = 0; i < TELEMETRY_PAYLOAD; i++)
+    {
+        f[1 + i] = payload[i];
+        cs ^= payload[i];
+    }
+    f[TELEMETRY_FRAME - 1] = cs;
+
+    head = next;
+    return 0;
+}
+
+void Telemetry_Poll(void)
+{
+    while (tail != head && __HAL_UART_GET_FLAG(&huart1, UART_FLAG_TXE))
+    {
+        huart1.Instance->TDR = queue[tail][pos];
+        if (++pos >= TELEMETRY_FRAME)
+        {
+            pos  = 0;
+            tail = (uint8_t)((tail + 1) % TELEMETRY_QUEUE);
+        }
+    }
+}
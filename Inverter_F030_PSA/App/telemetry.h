@@ -0,0 +1,63 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Telemetry link on USART1 (115200 8N1) to the display/control board
+// (Inverter_F40G_EVAL: USART3 at 115200, App/comms.c).
+//
+// Fixed 10-byte frames, the framing of the receiver's TryParsePacket():
+//
+//   <type> <8 payload bytes> <checksum = 0x55 ^ all 9 bytes before it>
+//
+// The receiver hands on the 9 bytes before the checksum as one
+// sensorPacket_t (app.h): raw[0] is the type, raw[1..8] the payload.
+// Multi-byte fields are little-endian. A receiver that loses a byte slides
+// forward one byte at a time until a checksum matches again. Frames are
+// queued and sent from the main loop, one byte whenever TXE is set, so no
+// call waits for the UART. In PWMLOG_ENABLE builds the capture print shares
+// USART1 and may cut a frame; the receiver drops it by its checksum.
+
+#define TELEMETRY_FRAME     10
+#define TELEMETRY_PAYLOAD   8
+// Queued frames; Telemetry_Send() drops the frame when the queue is full
+#define TELEMETRY_QUEUE     6
+
+// Frame types (first byte)
+#define TELEMETRY_BATTERY       0x10    // battery status, see battery.c
+#define TELEMETRY_BATTERY_EVENT 0x11    // battery warning / lockout, see battery.h
+#define TELEMETRY_SOC           0x12    // state of charge and runtime, see soc.c
+#define TELEMETRY_METER         0x13    // power, voltage, PF, see meter.c
+#define TELEMETRY_ENERGY        0x14    // energy, output current, see meter.c
+
+// Empty the queue
+void Telemetry_Init(void);
+
+// Queue one frame (main loop only); -1 if the queue is full
+int Telemetry_Send(uint8_t type, const uint8_t payload[TELEMETRY_PAYLOAD]);
+
+// Main loop: moves queued bytes to USART1
+void Telemetry_Poll(void);
+
+// Little-endian helpers for building payloads
+static inline void Telemetry_Put16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static inline void Telemetry_Put32(uint8_t *p, uint32_t v)
+{
+    Telemetry_Put16(p, (uint16_t)v);
+    Telemetry_Put16(p + 2, (uint16_t)(v >> 16));
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TELEMETRY_H
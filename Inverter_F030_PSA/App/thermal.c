@@ -0,0 +1,163 @@
+/**
+ * @file thermal.c
+ * @brief NTC temperature, hysteretic fan steps and output derating.
+ *
+ * The NTC sits at the bottom of a divider from VDDA (10 k pull-up, 10 k
+ * B3950 NTC assumed; replace the table for other parts), so the ADC code
+ * falls as the temperature rises. The code is filtered over a few polls and
+ * converted by linear interpolation in a 10 degC table.
+ *
+ * The fan steps up at THERMAL_FAN_LOW/MID/HIGH and only steps down
+ * THERMAL_FAN_HYST below the threshold it came in at, so it does not hunt
+ * around a threshold and stays off at light load. Above THERMAL_DERATE_START
+ * the sine amplitude is limited; the sine generator slews to the new limit,
+ * so the output sags slowly rather than tripping.
+ *
+ * ADC_BAT_Temp comes from the scans the TIM6 ISR starts; while the sine
+ * generator is idle, Thermal_Poll() starts one itself.
+ */
+
+#include "thermal.h"
+#include "adcin.h"
+#include "sinegen.h"
+#include "main.h"
+#include "stm32f0xx_hal.h"
+
+#define NTC_T0      (-200)          // first table entry, 0.1 degC
+#define NTC_STEP    100             // between entries, 0.1 degC
+
+// ADC code at -20, -10 ... 120 degC (10 k / 10 k B3950 divider, 12 bit)
+static const uint16_t ntc_table[] = {
+    3740, 3495, 3156, 2738, 2278, 1825, 1419, 1081,
+     815,  613,  462,  350,  267,  206,  160,
+};
+#define NTC_POINTS  (sizeof(ntc_table) / sizeof(ntc_table[0]))
+
+static const int16_t fan_on[] = { THERMAL_FAN_LOW, THERMAL_FAN_MID, THERMAL_FAN_HIGH };
+
+static uint32_t   last_poll;
+static uint32_t   code_f;           // filtered code << THERMAL_FILTER_SHIFT
+static uint8_t    seeded;
+static int16_t    temp;
+static FanSpeed_t fan = FAN_OFF;
+static uint16_t   derate = 32767;
+static uint8_t    fault;
+
+int16_t Thermal_Convert(uint16_t code)
+{
+    if (code >= ntc_table[0])
+        return NTC_T0;
+    if (code <= ntc_table[NTC_POINTS - 1])
+        return NTC_T0 + (NTC_POINTS - 1) * NTC_STEP;
+
+    uint32_t i = 0;
+    while (code <= ntc_table[i + 1])
+        i++;
+
+    // ntc_table[i] > code > ntc_table[i + 1]
+    int32_t span = ntc_table[i] - ntc_table[i + 1];
+    return (int16_t)(NTC_T0 + (int32_t)i * NTC_STEP +
+                     ((int32_t)(ntc_table[i] - code) * NTC_STEP + span / 2) / span);
+}
+
+static void Fan_Write(FanSpeed_t speed)
+{
+    HAL_GPIO_WritePin(FAN_Speed_1_GPIO_Port, FAN_Speed_1_Pin,
+                      speed == FAN_MID ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(FAN_Speed_2_GPIO_Port, FAN_Speed_2_Pin,
+                      speed == FAN_HIGH ? GPIO_PIN_SET : GPIO_PIN_RESET);
+    HAL_GPIO_WritePin(FAN_Enable_GPIO_Port, FAN_Enable_Pin,
+                      speed != FAN_OFF ? GPIO_PIN_SET : GPIO_PIN_RESET);
+}
+
+static FanSpeed_t Fan_Step(FanSpeed_t cur, int16_t t)
+{
+    // up as far as the temperature goes, down one step at a time
+    while (cur < FAN_HIGH && t >= fan_on[cur])
+        cur++;
+    while (cur > FAN_OFF && t < fan_on[cur - 1] - THERMAL_FAN_HYST)
+        cur--;
+    return cur;
+}
+
+static uint16_t Derate(int16_t t)
+{
+    if (t <= THERMAL_DERATE_START)
+        return 32767;
+    if (t >= THERMAL_DERATE_END)
+        return THERMAL_DERATE_MIN;
+    return (uint16_t)(32767 - (int32_t)(32767 - THERMAL_DERATE_MIN) * (t - THERMAL_DERATE_START)
+                              / (THERMAL_DERATE_END - THERMAL_DERATE_START));
+}
+
+void Thermal_Init(void)
+{
+    last_poll = HAL_GetTick();
+    seeded    = 0;
+    fan       = FAN_OFF;
+    derate    = 32767;
+    fault     = 0;
+    Fan_Write(fan);
+    SineGen_SetAmpLimit(SINE_LIMIT_THERMAL, derate);
+}
+
+void Thermal_Poll(void)
+{
+    uint32_t now = HAL_GetTick();
+    if (now - last_poll < THERMAL_PERIOD_MS)
+        return;
+    last_poll = now;
+
+    // no ISR scans while idle; this one is read at the next poll
+    if (SineGen_GetState() == SINEGEN_IDLE)
+        AdcIn_Trigger();
+
+    uint16_t code = AdcIn_Get(ADCIN_BAT_TEMP);
+    if (!seeded)
+    {
+        code_f = (uint32_t)code << THERMAL_FILTER_SHIFT;
+        seeded = 1;
+    }
+    else
+    {
+        code_f += code - (code_f >> THERMAL_FILTER_SHIFT);
+    }
+    code = (uint16_t)(code_f >> THERMAL_FILTER_SHIFT);
+
+    fault = (code < THERMAL_CODE_MIN || code > THERMAL_CODE_MAX);
+    temp  = fault ? THERMAL_DERATE_END : Thermal_Convert(code);
+
+    FanSpeed_t next = Fan_Step(fan, temp);
+    if (next != fan)
+    {
+        fan = next;
+        Fan_Write(fan);
+    }
+
+    uint16_t d = Derate(temp);
+    if (d != derate)
+    {
+        derate = d;
+        SineGen_SetAmpLimit(SINE_LIMIT_THERMAL, derate);
+    }
+}
+
+int16_t Thermal_GetTemp(void)
+{
+    return temp;
+}
+
+FanSpeed_t Thermal_GetFan(void)
+{
+    return fan;
+}
+
+uint16_t Thermal_GetDerate(void)
+{
+    return derate;
+}
+
+uint8_t Thermal_SensorFault(void)
+{
+    return fault;
+}
@@ -0,0 +1,67 @@
+#ifndef THERMAL_H
+#define THERMAL_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Thermal management from the battery/heatsink NTC on ADC_BAT_Temp (PA2):
+// multi-speed fan on FAN_Enable / FAN_Speed_1 / FAN_Speed_2 (PC13-PC15) and
+// derating of the sine amplitude (SineGen_SetAmpLimit()) as it gets hot.
+// Temperatures are in 0.1 degC.
+
+// Thermal_Poll() works at this interval (ms)
+#define THERMAL_PERIOD_MS       100
+// ADC_BAT_Temp filter: 2^n polls (0.8 s)
+#define THERMAL_FILTER_SHIFT    3
+
+// Fan steps: switched up at these temperatures, back down HYST below them
+#define THERMAL_FAN_LOW         450
+#define THERMAL_FAN_MID         550
+#define THERMAL_FAN_HIGH        650
+#define THERMAL_FAN_HYST        50
+
+// Amplitude derating: full up to START, linear down to DERATE_MIN (Q15) at END
+#define THERMAL_DERATE_START    700
+#define THERMAL_DERATE_END      850
+#define THERMAL_DERATE_MIN      16384
+
+// Readings outside this code range mean an open or shorted NTC; the
+// module then runs as if at THERMAL_DERATE_END
+#define THERMAL_CODE_MIN        60
+#define THERMAL_CODE_MAX        4000
+
+typedef enum {
+    FAN_OFF = 0,
+    FAN_LOW,                        // FAN_Enable
+    FAN_MID,                        // FAN_Enable + FAN_Speed_1
+    FAN_HIGH,                       // FAN_Enable + FAN_Speed_2
+} FanSpeed_t;
+
+// Fan off, no derating; call after SineGen_Init()
+void Thermal_Init(void);
+
+// Main loop: every THERMAL_PERIOD_MS reads the NTC, sets fan and derating
+void Thermal_Poll(void);
+
+// 12-bit ADC_BAT_Temp code to 0.1 degC, from the NTC table
+int16_t Thermal_Convert(uint16_t code);
+
+// Filtered temperature, 0.1 degC
+int16_t Thermal_GetTemp(void);
+
+FanSpeed_t Thermal_GetFan(void);
+
+// Amplitude limit passed to the sine generator, Q15
+uint16_t Thermal_GetDerate(void);
+
+// Non-zero while the NTC reading is out of range
+uint8_t Thermal_SensorFault(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // THERMAL_H
@@ -28,6 +28,13 @@
 /* USER CODE BEGIN Includes */
 #include "gpio.h"
 #include "sinegen.h"
+#include "adcin.h"
+#include "pwmlog.h"
+#include "thermal.h"
+#include "battery.h"
+#include "telemetry.h"
+#include "soc.h"
+#include "meter.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -102,7 +109,7 @@ int main(void)
   MX_USART2_UART_Init();
   MX_TIM6_Init();
   /* USER CODE BEGIN 2 */
-
+  AdcIn_Init();
   /* USER CODE END 2 */
 
   /* Infinite loop */
@@ -112,8 +119,17 @@ int main(void)
   uint32_t prevB = prevA;
 
   SineGen_Init();
+  Thermal_Init();
+  Telemetry_Init();
+  Battery_Init();
+  Soc_Init();
+  Meter_Init();
+  // modulator phase following the mains on ADC_U_IN (SYNC_DEFAULT_ON 0):
+  // once the U_IN divider and the relay are trimmed for the board
+ // SineGen_SetSync(1);
+  PwmLog_Arm(PWMLOG_DECIMATION);
   SineGen_Start();
- // Bridge_SoftStart();
+ // Bridge_SoftStart(NULL);
 
   while (1)
   {
@@ -133,6 +149,30 @@ int main(void)
           HAL_GPIO_TogglePin(LED_B_GPIO_Port, LED_B_Pin);
       }
 
+      // Debug builds: print a finished modulation capture
+      PwmLog_Poll();
+
+      // Fan and output derating from the NTC
+      Thermal_Poll();
+
+      // Battery UVLO / low-battery warning, status frames
+      Battery_Poll();
+
+      // State of charge and runtime, once a second
+      Soc_Poll();
+
+      // Output power, PF and energy of the last period
+      Meter_Poll();
+
+      // Queued telemetry frames out on USART1
+      Telemetry_Poll();
+
+      // Modulator ramp-up / ramp-down completion callbacks
+      SineGen_Poll();
+
+      // Debug bridge ramp (no-op while idle)
+      Bridge_SoftPoll();
+
       // Здесь можно добавить другую логику — ни одна из «задач» не блокирует петлю
 
     /* USER CODE END WHILE */
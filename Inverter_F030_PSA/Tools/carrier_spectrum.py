@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+"""
+Spectrum of the bridge voltage around the carrier and its harmonics, with
+and without the spread-spectrum carrier (Bridge_SetDither()).
+
+The switching waveform is the firmware's own, the ARR and CCR writes of a
+plant_sim run (host/f030's f030_sim) once the ramp is done. Each
+leg is a train of rectangular pulses, so its Fourier transform is summed
+in closed form per pulse (dead time is left out: it moves edges by the
+same amount with or without dither). Levels are in dB relative to Vbus,
+as a receiver with the given resolution bandwidth would show them.
+
+    python3 Tools/carrier_spectrum.py
+    python3 Tools/carrier_spectrum.py --dither 0,64,128,256 --harmonics 4 --rbw 200
+
+At 16 kHz with RBW 200 Hz, the carrier and its 2nd/3rd harmonic come down by
+about 0.5/1.0/2.3 dB at span 128 and 2.9/5.0/6.0 dB at span 256 (the widest,
+1/8 of the period); span 64 changes next to nothing.
+
+The fundamental and THD columns (wave_analyze, ideal model) show that the
+CCR scaling keeps the 50 Hz output unchanged while ARR moves.
+"""
+
+import argparse
+import cmath
+import math
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import plant_sim as ps                                      # noqa: E402
+import wave_analyze as wa                                   # noqa: E402
+
+
+def pulses(mod, t_from):
+    """(t1, t2, sign) of every leg-high interval from t_from on, in ticks."""
+    out = []
+    wi = ci = 0
+    ccr, arr = (0, 0), ps.ARR
+    t = 0
+    while t < mod.end:
+        while wi < len(mod.writes) and mod.writes[wi][0] <= t:
+            ccr = mod.writes[wi][1:3]
+            wi += 1
+        while ci < len(mod.carrier) and mod.carrier[ci][0] <= t:
+            arr = mod.carrier[ci][1]
+            ci += 1
+        period = arr + 1
+        if t >= t_from:
+            a, b = min(ccr[0], period), min(ccr[1], period)
+            if a < period:
+                out.append((t + a, t + period, 1.0))      # leg A, PWM2: high from CCR
+            if b > 0:
+                out.append((t, t + b, -1.0))              # leg B, PWM1: high until CCR
+        t += period
+    return out
+
+
+def band_levels(pl, t_from, t_to, centre, half, rbw):
+    """Highest RBW-integrated level (dB re Vbus) in centre +- half Hz."""
+    T  = (t_to - t_from) / ps.F_TIM
+    df = 1.0 / T
+    k0 = int((centre - half) / df)
+    k1 = int((centre + half) / df) + 1
+
+    amp = []
+    for k in range(k0, k1 + 1):
+        w = -2j * math.pi * k * df / ps.F_TIM
+        s = 0j
+        for t1, t2, sign in pl:
+            if t2 > t_to:
+                break
+            s += sign * (cmath.exp(w * (t1 - t_from)) - cmath.exp(w * (t2 - t_from)))
+        # |X| * 2 / T, with X = s / (j 2 pi f)
+        amp.append(abs(s) / (2 * math.pi * k * df) * 2.0 / T)
+
+    width = max(1, int(round(rbw / df)))
+    best = 0.0
+    for i in range(len(amp) - width + 1):
+        best = max(best, math.sqrt(sum(a * a for a in amp[i:i + width])))
+    return 20.0 * math.log10(best) if best > 0 else -200.0
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Carrier-band spectrum with and without dithering.")
+    ap.add_argument("--dither", default="0,64,128,256", help="Bridge_SetDither() spans (ticks)")
+    ap.add_argument("--harmonics", type=int, default=3, help="carrier harmonics to check")
+    ap.add_argument("--rbw", type=float, default=200.0, help="resolution bandwidth (Hz)")
+    ap.add_argument("--window", type=float, default=40.0, help="analysis window (ms)")
+    args = ap.parse_args()
+
+    fc     = ps.F_TIM / (ps.ARR + 1)
+    settle = 400.0                                          # ms, past the soft start
+    t_from = int(settle * ps.F_TIM / 1000)
+    t_to   = t_from + int(args.window * ps.F_TIM / 1000)
+
+    print("carrier %.0f Hz, RBW %.0f Hz, %.0f ms window" % (fc, args.rbw, args.window))
+    print("%6s %10s  %s  %9s %7s" % ("span", "band kHz",
+                                     "  ".join("%7s" % ("H%d dB" % h) for h in range(1, args.harmonics + 1)),
+                                     "fund", "THD %"))
+    ref = None
+    for span in (int(v) for v in args.dither.split(",")):
+        mod = ps.run(settle + args.window + 1, dither=span or None).mod
+        spread = max(a for _, a in mod.carrier) - min(a for _, a in mod.carrier)
+        pl = pulses(mod, t_from)
+
+        half = fc * (spread / 2.0 + 50) / (ps.ARR + 1)
+        levels = [band_levels(pl, t_from, t_to, h * fc, h * half + 2 * args.rbw, args.rbw)
+                  for h in range(1, args.harmonics + 1)]
+        if ref is None:
+            ref = levels
+
+        lo = ps.F_TIM / (max(a for _, a in mod.carrier) + 1) / 1000
+        hi = ps.F_TIM / (min(a for _, a in mod.carrier) + 1) / 1000
+        steady = wa.analyse(wa.ideal_wave(mod), 2)
+        cells = "  ".join("%7.1f" % l for l in levels)
+        print("%6d %4.1f-%4.1f  %s  %9.5f %7.3f" % (span, lo, hi, cells,
+                                                   steady["fundamental"], steady["thd_pct"]))
+        if ref is not levels:
+            print("%6s %10s  %s" % ("", "change", "  ".join("%+7.1f" % (l - r) for l, r in zip(levels, ref))))
+
+
+if __name__ == "__main__":
+    main()
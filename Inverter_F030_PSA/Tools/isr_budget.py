@@ -0,0 +1,394 @@
+#!/usr/bin/env python3
+"""
+Worst-case cycle count of interrupt handlers in the F030 build, checked
+against a per-ISR budget.
+
+The ELF is disassembled with arm-none-eabi-objdump. From each handler the
+tool follows every direct call (HAL_TIM_IRQHandler, the period-elapsed
+callback, SineGen_Update, the soft-float helpers from libgcc ...) and
+takes the longest path through each function:
+
+  - Cortex-M0 timings (ARM DDI 0432C, single-cycle multiplier): ALU 1,
+    LDR/STR 2, LDM/STM/PUSH/POP 1+N, POP {pc} 4+N, B 3, B<cond> 3 taken,
+    BL 4, BX/BLX 3, MRS/MSR/barriers 4
+  - flash wait states (FLASH_LATENCY_1 at 48 MHz, prefetch on): +latency
+    for every jump, call or return (prefetch refill) and every literal
+    pool load; without prefetch every 32-bit fetch waits as well
+  - exception entry 16 and exit 12 cycles, plus the vector fetch
+  - conditional branches are costed as taken, loops as bound x the
+    longest trip through the body
+
+Loops need a bound (--loop-bound Func=N, or Func+0xOFF=N for one loop)
+and calls through a register need their targets (--indirect Func=A,B).
+--cost Func=N replaces the analysis of a function with a measured figure.
+Anything the tool cannot bound is an error, so a new loop or function
+pointer in an ISR path fails the check instead of slipping through.
+
+The bounds, targets and costs for this tree are kept in
+Tools/isr_budget.args (one option per line, # comments), read with @:
+
+    python3 Tools/isr_budget.py Debug/InverterPSA.elf @Tools/isr_budget.args
+    python3 Tools/isr_budget.py Debug/InverterPSA.elf @Tools/isr_budget.args -v
+
+It is not a post-build step: the switch statements on the TIM6 path
+(Ramp_Curve, Bypass_Step, Search_Step) compile to __gnu_thumb1_case jump
+tables, which need a --cost each from a run on the target. Once the check
+passes on a real ELF, add it under Project Properties > C/C++ Build >
+Settings > Build Steps:
+
+    python3 ../Tools/isr_budget.py ${ProjName}.elf @../Tools/isr_budget.args
+
+The default budget is one TIM6 period, 9600 cycles (200 us at 48 MHz), for
+TIM6_IRQHandler; the reported figure is an upper bound, not a measurement.
+"""
+
+import argparse
+import re
+import shutil
+import subprocess
+import sys
+
+CPU_HZ       = 48000000
+ENTRY_CYCLES = 16
+EXIT_CYCLES  = 12
+
+FUNC_RE = re.compile(r"^([0-9a-f]+) <([^>]+)>:\s*$")
+INSN_RE = re.compile(r"^\s*([0-9a-f]+):\s+((?:[0-9a-f]{4,8}\s)+)\s*(\S+)\s*(.*)$")
+TARGET_RE = re.compile(r"^([0-9a-f]+)\s+<([^>+]+)(?:\+0x([0-9a-f]+))?>")
+
+COND = ("eq", "ne", "cs", "cc", "hs", "lo", "mi", "pl", "vs", "vc",
+        "hi", "ls", "ge", "lt", "gt", "le")
+
+
+class Insn:
+    __slots__ = ("addr", "op", "args", "size")
+
+    def __init__(self, addr, op, args, size):
+        self.addr, self.op, self.args, self.size = addr, op, args, size
+
+
+class BudgetError(Exception):
+    pass
+
+
+def disassemble(elf, objdump):
+    tool = objdump or shutil.which("arm-none-eabi-objdump")
+    if not tool:
+        sys.exit("arm-none-eabi-objdump not found (use --objdump)")
+    return subprocess.run([tool, "-d", elf], capture_output=True, text=True, check=True).stdout
+
+
+def parse(text):
+    """{function: [Insn]} from objdump -d output; data words are dropped."""
+    funcs, cur = {}, None
+    for line in text.splitlines():
+        m = FUNC_RE.match(line)
+        if m:
+            cur = funcs.setdefault(m.group(2), [])
+            continue
+        m = INSN_RE.match(line)
+        if not m or cur is None:
+            continue
+        op = m.group(3)
+        if op.startswith("."):              # .word / .short literal data
+            continue
+        raw = m.group(2).split()
+        size = sum(len(h) // 2 for h in raw)
+        args = re.split(r"\s[;@]", m.group(4))[0].strip()
+        cur.append(Insn(int(m.group(1), 16), op.split(".")[0].lower(), args, size))
+    return funcs
+
+
+def reg_count(args):
+    m = re.search(r"\{([^}]*)\}", args)
+    if not m:
+        return 1
+    n = 0
+    for part in m.group(1).split(","):
+        part = part.strip()
+        r = re.match(r"r(\d+)-r(\d+)", part)
+        n += int(r.group(2)) - int(r.group(1)) + 1 if r else 1
+    return n
+
+
+def is_cond_branch(op):
+    return op.startswith("b") and op[1:] in COND
+
+
+def branch_target(args):
+    m = TARGET_RE.match(args)
+    if not m:
+        return None
+    return int(m.group(1), 16), m.group(2)
+
+
+class Analyzer:
+    def __init__(self, funcs, latency, prefetch, loop_bounds, indirect, costs):
+        self.funcs    = funcs
+        self.latency  = latency
+        self.prefetch = prefetch
+        self.bounds   = loop_bounds
+        self.indirect = indirect
+        self.costs    = costs
+        self.memo     = {}
+        self.stack    = []
+        self.calls    = {}          # function -> {callee}
+
+    #--- per instruction --------------------------------------------------
+
+    def insn_cycles(self, f, i):
+        op, a, lat = i.op, i.args, self.latency
+        refill = lat                            # prefetch buffer refill after a jump
+        fetch = 0 if self.prefetch else lat * i.size / 4.0
+
+        if op in ("bl",):
+            c = 4 + refill
+        elif op in ("blx", "bx"):
+            c = 3 + refill
+        elif op == "b" or is_cond_branch(op):
+            c = 3 + refill                      # conditional: taken is the worst case
+        elif op == "pop":
+            n = reg_count(a)
+            c = 1 + n + (3 + refill if "pc" in a else 0)
+        elif op in ("push", "ldm", "ldmia", "stm", "stmia"):
+            c = 1 + reg_count(a)
+        elif op.startswith("ldr") or op.startswith("str"):
+            c = 2 + (lat if "[pc" in a else 0)  # literal pool sits in flash
+        elif op in ("mrs", "msr", "dmb", "dsb", "isb"):
+            c = 4
+        elif op in ("add", "mov") and re.match(r"pc\b", a):
+            c = 3 + refill
+        elif op in ("wfi", "wfe", "svc", "bkpt", "udf"):
+            raise BudgetError("%s: '%s' at 0x%x in an ISR path" % (f, op, i.addr))
+        else:
+            c = 1
+        return c + fetch
+
+    #--- per function ----------------------------------------------------
+
+    def wcet(self, f):
+        if f in self.costs:
+            return self.costs[f]
+        if f in self.memo:
+            return self.memo[f]
+        if f in self.stack:
+            raise BudgetError("recursion: " + " -> ".join(self.stack + [f]))
+        if f not in self.funcs:
+            raise BudgetError("%s: no code in the ELF (give it a --cost)" % f)
+
+        self.stack.append(f)
+        try:
+            self.memo[f] = self._function(f)
+        finally:
+            self.stack.pop()
+        return self.memo[f]
+
+    def _callee(self, f, name):
+        if name.startswith("__gnu_thumb1_case"):
+            raise BudgetError("%s: switch jump table (%s), give %s a --cost" % (f, name, f))
+        self.calls.setdefault(f, set()).add(name)
+        return self.wcet(name)
+
+    def _function(self, f):
+        insns = self.funcs[f]
+        if not insns:
+            raise BudgetError("%s: empty function" % f)
+        start, end = insns[0].addr, insns[-1].addr + insns[-1].size
+        inside = lambda addr: start <= addr < end
+        index = {i.addr: k for k, i in enumerate(insns)}
+
+        # basic blocks: leaders are the entry, branch targets, and what follows a branch
+        leaders = {start}
+        for k, i in enumerate(insns):
+            if i.op == "b" or is_cond_branch(i.op) or self._ends(i):
+                t = branch_target(i.args)
+                if t and inside(t[0]):
+                    leaders.add(t[0])
+                if k + 1 < len(insns):
+                    leaders.add(insns[k + 1].addr)
+        order = sorted(leaders)
+
+        blocks = {}                         # addr -> [cost, [successors]]
+        for n, lead in enumerate(order):
+            stop = order[n + 1] if n + 1 < len(order) else end
+            cost, succ, k = 0.0, [], index[lead]
+            fall = True
+            while k < len(insns) and insns[k].addr < stop:
+                i = insns[k]
+                cost += self.insn_cycles(f, i)
+                if i.op == "bl":
+                    t = branch_target(i.args)
+                    if not t:
+                        raise BudgetError("%s: unresolved bl at 0x%x" % (f, i.addr))
+                    cost += self._callee(f, t[1])
+                elif i.op == "blx":
+                    targets = self.indirect.get(f)
+                    if not targets:
+                        raise BudgetError("%s: call through a register at 0x%x, "
+                                          "give --indirect %s=<targets>" % (f, i.addr, f))
+                    cost += max(self._callee(f, t) for t in targets)
+                elif i.op == "b" or is_cond_branch(i.op):
+                    t = branch_target(i.args)
+                    if not t:
+                        raise BudgetError("%s: unresolved branch at 0x%x" % (f, i.addr))
+                    if inside(t[0]):
+                        succ.append(t[0])
+                    else:
+                        cost += self._callee(f, t[1])   # tail call
+                    if i.op == "b":
+                        fall = False
+                elif self._ends(i):
+                    fall = False
+                k += 1
+            if fall and stop < end:
+                succ.append(stop)
+            blocks[lead] = [cost, succ]
+
+        return self._longest(f, blocks, start)
+
+    @staticmethod
+    def _ends(i):
+        """Return or computed jump: nothing after it in this block runs."""
+        if i.op == "bx":
+            return True
+        if i.op == "pop" and "pc" in i.args:
+            return True
+        if i.op in ("add", "mov") and re.match(r"pc\b", i.args):
+            return True
+        return False
+
+    def _bound(self, f, header, start):
+        key = "%s+0x%x" % (f, header - start)
+        if key in self.bounds:
+            return self.bounds[key]
+        if f in self.bounds:
+            return self.bounds[f]
+        raise BudgetError("%s: loop at 0x%x (%s) has no bound, give --loop-bound %s=N"
+                          % (f, header, key, key))
+
+    def _longest(self, f, blocks, start):
+        """Longest path; loops (back edges) are collapsed innermost first."""
+        nodes = {a: {"cost": c, "succ": set(s), "members": {a}} for a, (c, s) in blocks.items()}
+        owner = {a: a for a in blocks}      # block -> node containing it
+
+        # loops from back edges, grouped by header, smallest body first
+        loops = {}
+        for a, (_, succ) in blocks.items():
+            for t in succ:
+                if t <= a:
+                    loops[t] = max(loops.get(t, t), a)
+        for header, latch in sorted(loops.items(), key=lambda hl: hl[1] - hl[0]):
+            body = {owner[a] for a in blocks if header <= a <= latch}
+            members = set().union(*(nodes[n]["members"] for n in body))
+            hnode = owner[header]
+
+            # longest trip from the header through the body (back edges dropped)
+            dist = {}
+
+            def trip(n):
+                if n in dist:
+                    return dist[n]
+                best = 0.0
+                for s in nodes[n]["succ"]:
+                    sn = owner[s]
+                    if sn in body and sn != hnode and min(nodes[sn]["members"]) > min(nodes[n]["members"]):
+                        best = max(best, trip(sn))
+                dist[n] = nodes[n]["cost"] + best
+                return dist[n]
+
+            cost = self._bound(f, header, start) * trip(hnode)
+            succ = {s for n in body for s in nodes[n]["succ"] if s not in members}
+            for n in body:
+                del nodes[n]
+            nodes[header] = {"cost": cost, "succ": succ, "members": members}
+            for a in members:
+                owner[a] = header
+
+        memo = {}
+
+        def longest(n):
+            if n in memo:
+                return memo[n]
+            memo[n] = None
+            best = 0.0
+            for s in nodes[n]["succ"]:
+                sn = owner[s]
+                if sn == n:
+                    continue
+                if memo.get(sn, 0) is None:
+                    raise BudgetError("%s: irreducible control flow near 0x%x" % (f, s))
+                best = max(best, longest(sn))
+            memo[n] = nodes[n]["cost"] + best
+            return memo[n]
+
+        return longest(owner[start])
+
+
+class ArgsFile(argparse.ArgumentParser):
+    """@file arguments: whitespace separated, lines from # on ignored."""
+
+    def convert_arg_line_to_args(self, line):
+        return line.split("#", 1)[0].split()
+
+
+def kv(items, conv):
+    out = {}
+    for it in items or []:
+        k, _, v = it.partition("=")
+        if not v:
+            sys.exit("expected NAME=VALUE, got '%s'" % it)
+        out[k] = conv(v)
+    return out
+
+
+def tree(an, f, depth, seen):
+    print("  %s%-*s %8.0f" % ("  " * depth, 40 - 2 * depth, f, an.costs.get(f, an.memo.get(f, 0))))
+    if f in seen:
+        return
+    seen.add(f)
+    for c in sorted(an.calls.get(f, ())):
+        tree(an, c, depth + 1, seen)
+
+
+def main():
+    ap = ArgsFile(description="Worst-case ISR cycles for the Cortex-M0 build.", fromfile_prefix_chars="@")
+    ap.add_argument("elf", help="firmware ELF (or an objdump -d listing with --listing)")
+    ap.add_argument("--listing", action="store_true", help="the input is objdump -d text")
+    ap.add_argument("--objdump", help="objdump to use (default arm-none-eabi-objdump)")
+    ap.add_argument("--isr", action="append", help="Handler=budget_cycles (default TIM6_IRQHandler=9600)")
+    ap.add_argument("--latency", type=int, default=1, help="flash wait states (FLASH_LATENCY_x)")
+    ap.add_argument("--no-prefetch", action="store_true", help="prefetch buffer disabled")
+    ap.add_argument("--loop-bound", action="append", help="Func=N or Func+0xOFF=N")
+    ap.add_argument("--indirect", action="append", help="Func=Target1,Target2 for blx rN in Func")
+    ap.add_argument("--cost", action="append", help="Func=cycles, used instead of analysing Func")
+    ap.add_argument("-v", "--verbose", action="store_true", help="print the call tree")
+    args = ap.parse_args()
+
+    text = open(args.elf).read() if args.listing else disassemble(args.elf, args.objdump)
+    an = Analyzer(parse(text), args.latency, not args.no_prefetch,
+                  kv(args.loop_bound, int), kv(args.indirect, lambda v: v.split(",")),
+                  kv(args.cost, float))
+
+    isrs = kv(args.isr or ["TIM6_IRQHandler=9600"], int)
+    failed = False
+    for isr, budget in isrs.items():
+        try:
+            body = an.wcet(isr)
+        except BudgetError as e:
+            print("%-24s ERROR %s" % (isr, e))
+            failed = True
+            continue
+        total = body + ENTRY_CYCLES + EXIT_CYCLES + 2 * args.latency
+        over = total > budget
+        failed |= over
+        print("%-24s %6.0f cycles (%5.1f us) of %d, %5.1f %%%s"
+              % (isr, total, total * 1e6 / CPU_HZ, budget, 100.0 * total / budget,
+                 "  OVER BUDGET" if over else ""))
+        if args.verbose:
+            tree(an, isr, 0, set())
+
+    sys.exit(1 if failed else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,352 @@
+#!/usr/bin/env python3
+"""
+Virtual-time model of the power stage, for trying out modulation and
+regulator changes without a bridge on the bench.
+
+This is the front end of host/f030's f030_sim: the firmware itself (main(),
+SineGen in the TIM6 ISR, the main-loop polls) built for the host and run
+against a C++ model of the stage (host/f030/plant) that follows TIM16/TIM17
+at count level:
+
+    TIM16 CH1/CH1N  PWM mode 2   -> leg A (Q3H/Q4L)
+    TIM17 CH1/CH1N  PWM mode 1   -> leg B (Q1H/Q2L)
+    ARR, CCR and dead time as the firmware programs them, preloaded values
+    acting from the update event that latches them, outputs idle low while
+    the bridge is off (MOE = 0, OSSI = 1).
+
+During dead time and with the bridge off each leg node follows its body
+diodes. The stage behind the bridge is
+
+    battery (Vbat, Rbat) -> H-bridge (Ron) -> L (RL) -> C -> transformer
+    (ratio n, magnetising Lm) -> load: R, series R-L, a diode bridge
+    into a smoothed DC load (rectifier, capacitor input), or a filament
+    lamp whose resistance rises from cold as it heats (inrush).
+
+The model feeds ADC_U_OUT, ADC_BAT_LOAD and ADC_BAT_V back to the firmware,
+so the DC trim, repetitive controller, ramp current limit, load search and
+dead-time compensation run closed loop as compiled. The divider/shunt
+scalings are placeholders (host/f030/plant/plant.h), set them from the
+schematic before comparing codes with the board.
+
+    python3 Tools/plant_sim.py --ms 600
+    python3 Tools/plant_sim.py --ms 2500 --load rect:10:2e-3 --adc adc.csv
+    python3 Tools/plant_sim.py --ms 600 --load lamp:4:0.3 --ramp-ms 100 --i-limit 200 --adc start.csv
+    python3 Tools/plant_sim.py --ms 8000 --search 1000:1000 --load r:50 --load-from 5000
+    python3 Tools/plant_sim.py --sweep --load r:5,r:10,rect:20 --vbat 10.5,12.6,14.4
+    python3 Tools/plant_sim.py --pwmlog capture.txt --adc adc.csv
+
+With --pwmlog the model is driven from a capture of App/pwmlog.c
+(PWMLOG_ENABLE) instead of the firmware. Build the simulator first
+(F030_SIM in the environment points to another build):
+
+    cmake -S host -B host/build && cmake --build host/build
+
+Only the Python standard library is needed.
+"""
+
+import argparse
+import csv
+import multiprocessing
+import os
+import re
+import subprocess
+import sys
+import tempfile
+from dataclasses import dataclass, field
+
+# Timer setup (Core/Src/tim.c) and SineGen constants (App/sinegen.h)
+F_TIM         = 48000000
+ARR           = 2999
+DEADTIME      = 75                  # DTG < 128: 75 timer ticks
+TIM6_TICKS    = 48 * 200            # PSC 47, ARR 199 -> 200 us
+SINE_SAMPLES  = 100
+SOFT_MS       = 1000
+RAMP_I_LIMIT  = 250
+
+STATES = ("idle", "up", "run", "down", "search", "probe")
+LOADS  = ("r", "rl", "rect", "lamp", "open")
+
+REPO = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "..")
+
+
+@dataclass
+class Modulation:
+    """
+    CCR writes [(tick, ccr16, ccr17)], bridge events [(tick, on)] and ARR
+    writes [(tick, arr)], each in time order.
+    """
+    writes:  list = field(default_factory=list)
+    bridge:  list = field(default_factory=list)
+    carrier: list = field(default_factory=list)
+    end:     int  = 0
+
+
+@dataclass
+class Result:
+    """
+    One f030_sim run. mod is the modulation as written; samples one row per
+    ADC scan (t_s, v_out, i_l, i_bat, adc_u_out, adc_bat_load, ccr16, ccr17,
+    bridge, state) if asked for; wave (t_s, v_out, i_l) rows if asked for;
+    metrics the steady-state figures of the last 100 ms plus e_in/e_out;
+    states the SineGen state changes [(t_s, name)].
+    """
+    mod:     Modulation
+    samples: list
+    wave:    list
+    metrics: dict
+    states:  list
+    text:    str
+
+
+def sim_path():
+    path = os.environ.get("F030_SIM") or os.path.join(REPO, "host", "build", "f030", "f030_sim")
+    if not os.access(path, os.X_OK):
+        sys.exit("%s not found: cmake -S host -B host/build && cmake --build host/build" % path)
+    return path
+
+
+def parse_load(spec):
+    """'r:10', 'rl:10:0.02', 'rect:20', 'lamp:10:0.1', 'open' -> spec, or exit."""
+    if spec.split(":")[0] not in LOADS:
+        sys.exit("unknown load '%s' (r, rl, rect, lamp, open)" % spec)
+    return spec
+
+
+def run(ms=1500, load="r:10", vbat=12.6, n=1.0, step=48, stop_ms=None, curve=None, ramp_ms=None,
+        i_limit=None, dtcomp=None, rc=None, search=None, carrier=None, dither=None, load_from=None,
+        mains=None, wave_us=None, samples=False, replay=None):
+    """
+    Runs f030_sim. Firmware settings left at None keep the firmware's
+    defaults; search is (idle_ms, every_ms), mains (peak codes, Hz), wave_us
+    the waveform row spacing (no waveform if None). With replay (a capture
+    path) the model is driven from the capture instead of the firmware.
+    """
+    args = [sim_path(), "--ms", str(ms), "--load", parse_load(load), "--vbat", str(vbat),
+            "--n", str(n), "--step", str(step)]
+    opt = {
+        "--stop-ms":   stop_ms,
+        "--curve":     curve,
+        "--ramp-ms":   ramp_ms,
+        "--i-limit":   i_limit,
+        "--dtcomp":    None if dtcomp is None else int(dtcomp),
+        "--rc":        None if rc is None else int(rc),
+        "--search":    None if search is None else "%d:%d" % tuple(search),
+        "--carrier":   carrier,
+        "--dither":    dither,
+        "--load-from": load_from,
+        "--mains":     None if mains is None else "%g:%g" % tuple(mains),
+        "--replay":    replay,
+    }
+    for k, v in opt.items():
+        if v is not None:
+            args += [k, str(v)]
+
+    with tempfile.TemporaryDirectory() as tmp:
+        mod_path  = os.path.join(tmp, "mod.txt")
+        adc_path  = os.path.join(tmp, "adc.csv")
+        wave_path = os.path.join(tmp, "wave.csv")
+        if not replay:
+            args += ["--pwmlog", mod_path]
+        if samples:
+            args += ["--adc", adc_path]
+        if wave_us:
+            args += ["--wave", wave_path, "--wave-us", str(wave_us)]
+        out = subprocess.run(args, capture_output=True, text=True)
+        if out.returncode != 0:
+            sys.exit("f030_sim failed:\n" + out.stderr)
+        sys.stderr.write(out.stderr)
+
+        if replay:
+            mod = pwmlog(replay)
+        else:
+            mod = pwmlog(mod_path, tail_ms=0)
+            mod.end = int(ms * F_TIM / 1000)
+        rows, wave = [], []
+        if samples:
+            with open(adc_path) as f:
+                for r in list(csv.reader(f))[1:]:
+                    rows.append(tuple(float(x) for x in r[:4]) + tuple(int(x) for x in r[4:]))
+        if wave_us:
+            with open(wave_path) as f:
+                wave = [tuple(float(x) for x in r) for r in list(csv.reader(f))[1:]]
+
+    metrics = {k: float(v) for k, v in re.findall(r"^  (\w+) +(\S+)$", out.stdout, re.M)}
+    states  = []
+    m = re.search(r"^  states: (.*)$", out.stdout, re.M)
+    if m:
+        for item in m.group(1).split(", "):
+            t, name = item.split()
+            states.append((float(t), name))
+    return Result(mod, rows, wave, metrics, states, out.stdout)
+
+
+def pwmlog(path, tail_ms=20.0):
+    """Reads a PwmLog_Poll() capture (the last one if the file holds several)
+    or the same CSV from host/f030's f030_sim (clock= in the header, the
+    second leg's value after B and A)."""
+    text   = open(path, errors="replace").read()
+    blocks = re.findall(r"^# pwmlog(.*?)$(.*?)^# end", text, re.S | re.M)
+    if not blocks:
+        sys.exit("%s: no pwmlog capture found" % path)
+    header, body = blocks[-1]
+
+    hdr = dict(re.findall(r"(\w+)=(\d+)", header))
+    if int(hdr.get("deadtime", DEADTIME)) != DEADTIME:
+        print("note: capture has deadtime=%s, the model assumes %d"
+              % (hdr.get("deadtime"), DEADTIME), file=sys.stderr)
+    if int(hdr.get("decim", 1)) != 1:
+        print("note: decimated capture, CCRs are held between recorded samples", file=sys.stderr)
+
+    m  = Modulation(carrier=[(0, int(hdr.get("arr", ARR)))])
+    t0 = None
+    us = F_TIM // int(hdr.get("clock", 1000000))    # host/ captures count core clocks
+    for row in csv.reader(body.split()):
+        if len(row) < 3:
+            continue
+        t = int(row[0])
+        if t0 is None:
+            t0 = t
+        t = (t - t0) * us
+        if row[1] == "C":
+            m.writes.append((t, int(row[2]), int(row[3])))
+        elif row[1] == "B":
+            m.bridge.append((t, int(row[2])))
+        elif row[1] == "A":
+            m.carrier.append((t, int(row[2])))
+
+    last = max([w[0] for w in m.writes] + [b[0] for b in m.bridge] + [0])
+    m.end = last + int(tail_ms * F_TIM / 1000)
+    if not m.bridge or m.bridge[0][0] > 0:
+        m.bridge.insert(0, (0, 1))      # capture armed with the bridge already running
+    return m
+
+
+#-------------------------------------------------------------------------
+# Reports
+#-------------------------------------------------------------------------
+
+def _corner(kw):
+    return kw, run(**kw).metrics
+
+
+def sweep(loads, vbats, ms, **kw):
+    jobs = [dict(kw, ms=ms, load=parse_load(l), vbat=v) for l in loads for v in vbats]
+    with multiprocessing.Pool(os.cpu_count()) as pool:
+        results = pool.map(_corner, jobs)
+
+    print("%-10s %6s  %8s %8s %8s %8s %8s %8s %6s"
+          % ("load", "vbat", "Vout rms", "Vout dc", "Vout pk", "IL pk", "Ibat", "Vdc", "eff"))
+    for job, m in results:
+        if "v_out_rms" not in m:
+            print("%-10s %6.2f  (run shorter than the settle time)" % (job["load"], job["vbat"]))
+            continue
+        print("%-10s %6.2f  %8.2f %8.3f %8.2f %8.2f %8.2f %8.2f %6.3f"
+              % (job["load"], job["vbat"], m["v_out_rms"], m["v_out_dc"], m["v_out_pk"],
+                 m["i_l_pk"], m["i_bat_avg"], m["v_dc"], m["eff"]))
+
+
+def _search_run(kw):
+    r = run(**kw)
+    return r.states, r.metrics.get("e_in", 0.0)
+
+
+def search_report(ms, search, load_from, **kw):
+    """Battery energy with and without the load search, and when a load
+    connected at load_from (ms) got full output back."""
+    jobs = [dict(kw, ms=ms, load_from=load_from or None, search=s) for s in ((0, search[1]), search)]
+    with multiprocessing.Pool(2) as pool:
+        runs = dict(zip(("continuous", "search"), pool.map(_search_run, jobs)))
+
+    print("%.1f s simulated, load %s%s, Vbat %.2f V" %
+          (ms / 1000.0, kw["load"], " from %.2f s" % (load_from / 1000.0) if load_from else "",
+           kw["vbat"]))
+    e_cont = runs["continuous"][1]
+    for name, (states, e_in) in runs.items():
+        line = "  %-10s E_in %8.3f J" % (name, e_in)
+        if name == "search":
+            probes = sum(1 for _, s in states if s == "probe")
+            line += ", saved %.3f J (%.1f %%), %d probe(s)" % (
+                e_cont - e_in, 100.0 * (e_cont - e_in) / e_cont if e_cont > 0 else 0.0, probes)
+        print(line)
+
+    states = runs["search"][0]
+    if load_from:
+        t_load = load_from / 1000.0
+        wake = [t for t, s in states if s == "run" and t >= t_load]
+        if wake:
+            print("  load at %.3f s: full output from %.3f s (%.1f ms later)"
+                  % (t_load, wake[0], (wake[0] - t_load) * 1000.0))
+        else:
+            print("  load at %.3f s: not detected" % t_load)
+    print("  states: " + ", ".join("%.2f %s" % (t, s) for t, s in states))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Simulate the F030 inverter power stage.")
+    ap.add_argument("--pwmlog", help="drive the model from a PwmLog capture instead of the firmware")
+    ap.add_argument("--ms", type=float, default=1500, help="simulated time (ms)")
+    ap.add_argument("--stop-ms", type=float, help="SineGen_Stop() at this time (ms)")
+    ap.add_argument("--dtcomp", type=int, choices=(0, 1),
+                    help="SineGen_SetDtComp() (default: the firmware's DTCOMP_DEFAULT_ON)")
+    ap.add_argument("--rc", type=int, choices=(0, 1),
+                    help="SineGen_SetRepetitive() (default: the firmware's)")
+    ap.add_argument("--curve", choices=("linear", "s", "s5"), help="SineGen ramp profile")
+    ap.add_argument("--ramp-ms", type=int, help="SineGen ramp time at light load (ms)")
+    ap.add_argument("--i-limit", type=int, help="ramp current limit, ADC_BAT_LOAD counts (0 = none)")
+    ap.add_argument("--search", metavar="IDLE_MS:EVERY_MS",
+                    help="SineGen load search: energy with and without it")
+    ap.add_argument("--carrier", type=int, help="Bridge_SetCarrier() (Hz)")
+    ap.add_argument("--dither", type=int, help="Bridge_SetDither() span (ticks)")
+    ap.add_argument("--load-from", type=float, default=0.0,
+                    help="load disconnected until this time (ms)")
+    ap.add_argument("--load", default="r:10",
+                    help="r:R | rl:R:L | rect:R[:Cdc] | lamp:Rhot[:tau] | open, secondary side "
+                         "(comma list with --sweep)")
+    ap.add_argument("--vbat", default="12.6", help="battery voltage (comma list with --sweep)")
+    ap.add_argument("--n", type=float, default=1.0, help="transformer ratio")
+    ap.add_argument("--step", type=int, default=48, help="max integration step, timer ticks")
+    ap.add_argument("--adc", help="write per-sample CSV (ADC codes, states) here")
+    ap.add_argument("--wave", help="write the output waveform CSV here")
+    ap.add_argument("--wave-us", type=float, default=5.0, help="waveform row spacing (us)")
+    ap.add_argument("--sweep", action="store_true",
+                    help="run every load x vbat corner on all cores, figures after the ramp")
+    args = ap.parse_args()
+
+    fw = dict(n=args.n, step=args.step, stop_ms=args.stop_ms, curve=args.curve, ramp_ms=args.ramp_ms,
+              i_limit=args.i_limit, dtcomp=args.dtcomp, rc=args.rc, carrier=args.carrier,
+              dither=args.dither)
+
+    if args.sweep:
+        # the ramp is done by ~320 ms, the figures are of the last 100 ms
+        ms = max(args.ms if args.ms != 1500 else 500, 420)
+        sweep(args.load.split(","), [float(v) for v in args.vbat.split(",")], ms, **fw)
+        return
+
+    if args.search and not args.pwmlog:
+        search_report(args.ms, tuple(int(v) for v in args.search.split(":")), args.load_from,
+                      load=args.load, vbat=float(args.vbat), **fw)
+        return
+
+    r = run(args.ms, args.load, float(args.vbat), load_from=args.load_from or None,
+            wave_us=args.wave_us if args.wave else None, samples=bool(args.adc),
+            replay=args.pwmlog, **fw)
+
+    if args.adc:
+        with open(args.adc, "w", newline="") as f:
+            w = csv.writer(f)
+            w.writerow(["t_s", "v_out", "i_l", "i_bat", "adc_u_out", "adc_bat_load",
+                        "ccr16", "ccr17", "bridge", "state"])
+            w.writerows(("%.6f" % s[0], "%.3f" % s[1], "%.3f" % s[2], "%.3f" % s[3], *s[4:9],
+                         STATES[s[9]] if 0 <= s[9] < len(STATES) else "")
+                        for s in r.samples)
+    if args.wave:
+        with open(args.wave, "w", newline="") as f:
+            w = csv.writer(f)
+            w.writerow(["t_s", "v_out", "i_l"])
+            w.writerows(("%.7f" % t, "%.3f" % v, "%.3f" % i) for t, v, i in r.wave)
+
+    sys.stdout.write(r.text)
+
+
+if __name__ == "__main__":
+    main()
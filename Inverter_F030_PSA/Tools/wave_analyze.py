@@ -0,0 +1,249 @@
+#!/usr/bin/env python3
+"""
+Waveform quality report for the sine generator: harmonic spectrum, THD,
+RMS, DC offset and soft-start ramp linearity, judged from the compare
+values SineGen_Update() writes rather than by eye on a scope.
+
+Input is a PwmLog capture (App/pwmlog.c, PWMLOG_ENABLE) or, without one,
+a run of the firmware in plant_sim.py (host/f030's f030_sim), closed
+around the plant model's ADC codes. The output is reconstructed per
+carrier period (16 kHz, 320 points per 50 Hz cycle) in one of two ways:
+
+    ideal   carrier-averaged bridge voltage in units of Vbus, no dead
+            time: leg A (TIM16, PWM2) is high for ARR+1-CCR ticks, leg B
+            (TIM17, PWM1) for CCR ticks
+    plant   the output of the plant_sim.py power stage (dead time, LC
+            filter, transformer, load), in volts
+
+    python3 Tools/wave_analyze.py --pwmlog capture.txt
+    python3 Tools/wave_analyze.py --ms 1500 --model plant --load r:10
+    python3 Tools/wave_analyze.py --ms 1500 --model plant --dtcomp 0
+    python3 Tools/wave_analyze.py --ms 2500 --model plant --load rect:10:2e-3 --rc 0
+    python3 Tools/wave_analyze.py --ms 300 --json now.json --baseline ref.json
+
+The steady-state figures use the last --cycles whole fundamental periods.
+The ramp figure fits a line to the per-cycle fundamental amplitude between
+10 % and 90 % of its final value (a linearity check for --curve linear;
+the S profiles deviate from the line by design). With --baseline, the script exits with
+status 1 when THD, DC offset or fundamental drift past the tolerances, so
+it can gate a change of table size, sample rate or modulation scheme.
+"""
+
+import argparse
+import cmath
+import json
+import math
+import os
+import sys
+
+sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+import plant_sim as ps                                      # noqa: E402
+
+F0         = 50.0
+PERIOD     = ps.ARR + 1             # analysis grid: the default carrier period
+CARRIER_HZ = ps.F_TIM / PERIOD
+HARMONICS  = 40                     # highest harmonic in the spectrum / THD
+
+
+def ideal_wave(mod):
+    """
+    Carrier-averaged bridge voltage (units of Vbus) on a grid of PERIOD
+    ticks; with a changed or dithered carrier each grid point is the
+    time-weighted mean of the carrier periods it overlaps.
+    """
+    out = []
+    wi = bi = ci = 0
+    ccr, on, arr = (0, 0), 0, ps.ARR
+    t = mod.writes[0][0] if mod.writes else 0
+    cell, acc = t, 0.0              # current grid cell start, area in it
+    while t < mod.end:
+        while wi < len(mod.writes) and mod.writes[wi][0] <= t:
+            ccr = mod.writes[wi][1:3]
+            wi += 1
+        while bi < len(mod.bridge) and mod.bridge[bi][0] <= t:
+            on = mod.bridge[bi][1]
+            bi += 1
+        while ci < len(mod.carrier) and mod.carrier[ci][0] <= t:
+            arr = mod.carrier[ci][1]
+            ci += 1
+        period = arr + 1
+        v = 0.0
+        if on:
+            a = 1.0 - min(max(ccr[0], 0), period) / period
+            b = min(max(ccr[1], 0), period) / period
+            v = a - b
+        end = t + period
+        while end >= cell + PERIOD:
+            acc += v * (cell + PERIOD - t)
+            out.append(acc / PERIOD)
+            t, cell, acc = cell + PERIOD, cell + PERIOD, 0.0
+        acc += v * (end - t)
+        t = end
+    return out
+
+
+def spectrum(x, n_per_cycle):
+    """Harmonic amplitudes (peak) 0..HARMONICS over whole cycles of x; [0] is the mean."""
+    n = len(x)
+    amps = []
+    for k in range(HARMONICS + 1):
+        w = -2j * math.pi * k / n_per_cycle
+        s = sum(v * cmath.exp(w * i) for i, v in enumerate(x))
+        amps.append(abs(s) / n * (1 if k == 0 else 2))
+    amps[0] = sum(x) / n            # keep the sign of the offset
+    return amps
+
+
+def analyse(x, cycles):
+    """Steady-state figures over the last `cycles` whole periods of x."""
+    m = int(round(CARRIER_HZ / F0))
+    whole = len(x) // m
+    use = min(cycles, whole)
+    if use < 1:
+        return None
+    seg = x[(whole - use) * m: whole * m]
+    amps = spectrum(seg, m)
+    fund = amps[1]
+    harm = math.sqrt(sum(a * a for a in amps[2:]))
+    return {
+        "cycles":       use,
+        "rms":          math.sqrt(sum(v * v for v in seg) / len(seg)),
+        "dc":           amps[0],
+        "fundamental":  fund,
+        "thd_pct":      100.0 * harm / fund if fund > 0 else float("nan"),
+        "harmonics_pct": [round(100.0 * a / fund, 4) if fund > 0 else 0.0 for a in amps[2:]],
+    }
+
+
+def ramp(x):
+    """
+    Linearity of the per-cycle fundamental amplitude while it ramps up, and
+    the largest per-cycle DC offset on the way (relative to the final level).
+    """
+    m = int(round(CARRIER_HZ / F0))
+    amp, dc = [], []
+    for c in range(len(x) // m):
+        seg = x[c * m:(c + 1) * m]
+        s = sum(v * cmath.exp(-2j * math.pi * i / m) for i, v in enumerate(seg))
+        amp.append(2.0 * abs(s) / m)
+        dc.append(sum(seg) / m)
+    if len(amp) < 4:
+        return None
+
+    final = max(amp)
+    idx = [c for c, a in enumerate(amp) if 0.1 * final <= a <= 0.9 * final]
+    pts = [(c / F0, amp[c]) for c in idx]
+    if len(pts) < 3:
+        return None
+
+    n = len(pts)
+    mt = sum(t for t, _ in pts) / n
+    ma = sum(a for _, a in pts) / n
+    sxx = sum((t - mt) ** 2 for t, _ in pts)
+    sxy = sum((t - mt) * (a - ma) for t, a in pts)
+    slope = sxy / sxx
+    fit = [ma + slope * (t - mt) for t, _ in pts]
+    ss_res = sum((a - f) ** 2 for (_, a), f in zip(pts, fit))
+    ss_tot = sum((a - ma) ** 2 for _, a in pts)
+    return {
+        "cycles":         n,
+        "slope_per_s":    slope / final,                     # of final amplitude
+        "r2":             1.0 - ss_res / ss_tot if ss_tot > 0 else 1.0,
+        "max_dev_pct":    100.0 * max(abs(a - f) for (_, a), f in zip(pts, fit)) / final,
+        "max_dc_pct":     100.0 * max(abs(dc[c]) for c in range(idx[-1] + 1)) / final,
+    }
+
+
+def compare(rep, base, tol):
+    """Regressions of rep against base; empty when within tolerance."""
+    fails = []
+    s, b = rep.get("steady"), base.get("steady")
+    if not s or not b:
+        return fails
+    if s["thd_pct"] > b["thd_pct"] + tol["thd"]:
+        fails.append("THD %.3f %% > baseline %.3f %% + %.3f" % (s["thd_pct"], b["thd_pct"], tol["thd"]))
+    if abs(s["dc"]) > abs(b["dc"]) + tol["dc"] * b["fundamental"]:
+        fails.append("DC %.4f vs baseline %.4f" % (s["dc"], b["dc"]))
+    if abs(s["fundamental"] - b["fundamental"]) > tol["fund"] * b["fundamental"]:
+        fails.append("fundamental %.4f vs baseline %.4f" % (s["fundamental"], b["fundamental"]))
+    return fails
+
+
+def main():
+    ap = argparse.ArgumentParser(description="THD / spectrum / ramp report for SineGen output.")
+    ap.add_argument("--pwmlog", help="PwmLog capture (default: a firmware run in plant_sim)")
+    ap.add_argument("--ms", type=float, default=1500, help="firmware run length (ms)")
+    ap.add_argument("--dtcomp", type=int, choices=(0, 1), help="SineGen_SetDtComp() (firmware default)")
+    ap.add_argument("--rc", type=int, choices=(0, 1), help="SineGen_SetRepetitive() (firmware default)")
+    ap.add_argument("--model", choices=("ideal", "plant"), default="ideal")
+    ap.add_argument("--curve", choices=("linear", "s", "s5"), help="SineGen ramp profile")
+    ap.add_argument("--ramp-ms", type=int, help="SineGen ramp time at light load (ms)")
+    ap.add_argument("--load", default="r:10", help="plant load, see plant_sim.py")
+    ap.add_argument("--vbat", type=float, default=12.6)
+    ap.add_argument("--step", type=int, default=48, help="plant integration step (ticks)")
+    ap.add_argument("--cycles", type=int, default=4, help="steady-state window (fundamental periods)")
+    ap.add_argument("--json", help="write the report here")
+    ap.add_argument("--baseline", help="earlier --json report to compare against")
+    ap.add_argument("--tol-thd", type=float, default=0.2, help="allowed THD increase (points)")
+    ap.add_argument("--tol-dc", type=float, default=0.005, help="allowed DC increase (of fundamental)")
+    ap.add_argument("--tol-fund", type=float, default=0.01, help="allowed fundamental change (relative)")
+    args = ap.parse_args()
+
+    plant = args.model == "plant"
+    if args.pwmlog and not plant:
+        mod = ps.pwmlog(args.pwmlog, tail_ms=0)
+    else:
+        # plant waveform rows on the analysis grid
+        mod = ps.run(args.ms, args.load, args.vbat, step=args.step, curve=args.curve,
+                     ramp_ms=args.ramp_ms, dtcomp=args.dtcomp, rc=args.rc, replay=args.pwmlog,
+                     wave_us=PERIOD * 1e6 / ps.F_TIM if plant else None)
+        if plant:
+            x = [v for _, v, _ in mod.wave]
+        mod = mod.mod
+    if plant:
+        unit = "V"
+    else:
+        x, unit = ideal_wave(mod), "Vbus"
+
+    settings = "".join(" %s %s" % (k, v) for k, v in
+                       (("dtcomp", args.dtcomp), ("rc", args.rc)) if v is not None)
+    rep = {
+        "source": args.pwmlog or "firmware %g ms%s" % (args.ms, settings),
+        "model":  args.model,
+        "unit":   unit,
+        "steady": analyse(x, args.cycles),
+        "ramp":   ramp(x),
+    }
+
+    s = rep["steady"]
+    if s:
+        print("steady state, last %d cycle(s)" % s["cycles"])
+        print("  fundamental %.4f %s peak, RMS %.4f, DC %+.4f" % (s["fundamental"], unit, s["rms"], s["dc"]))
+        print("  THD %.3f %%" % s["thd_pct"])
+        worst = sorted(enumerate(s["harmonics_pct"], 2), key=lambda h: -h[1])[:5]
+        print("  largest: " + ", ".join("H%d %.3f %%" % h for h in worst))
+    else:
+        print("capture is shorter than one fundamental period")
+    r = rep["ramp"]
+    if r:
+        print("ramp, %d cycles between 10 and 90 %%" % r["cycles"])
+        print("  %.3f of final per s, R^2 %.5f, max deviation %.2f %%"
+              % (r["slope_per_s"], r["r2"], r["max_dev_pct"]))
+        print("  largest cycle DC offset on the way up %.2f %% of final" % r["max_dc_pct"])
+
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(rep, f, indent=1)
+
+    if args.baseline:
+        base = json.load(open(args.baseline))
+        fails = compare(rep, base, {"thd": args.tol_thd, "dc": args.tol_dc, "fund": args.tol_fund})
+        for msg in fails:
+            print("REGRESSION: " + msg)
+        if fails:
+            sys.exit(1)
+        print("within tolerance of %s" % args.baseline)
+
+
+if __name__ == "__main__":
+    main()
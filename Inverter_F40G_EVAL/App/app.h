@@ -3,7 +3,8 @@
 #include <stdint.h>
 
 typedef struct {
-    uint8_t raw[9];      // 9 data bytes from UART packet
+    uint8_t raw[9];      // frame from the F030 (its App/telemetry.h): raw[0] type,
+                         // raw[1..8] payload, little-endian fields
 } sensorPacket_t;
 
 typedef struct {
@@ -16,3 +17,4 @@ void SineGenTask(void *arg);
 void ControlTask(void *arg);
 void CommsTask(void *arg);
 void CommsInit(void);
+void LCD_DMA_Init(void);
@@ -3,6 +3,7 @@
 #include "FreeRTOS.h"
 #include "task.h"
 #include "stm324xg_eval_lcd.h"
+#include "crash.h"
 
 #include <stdio.h>
 #include <string.h>
@@ -11,6 +12,7 @@
 #define ASSERT_MSG_FONT       Font12
 #define ASSERT_BG_COLOR       LCD_COLOR_RED
 #define ASSERT_TEXT_COLOR     LCD_COLOR_WHITE
+#define ASSERT_REBOOT_BLINKS  2         // ~2 s to read the screen, then reset
 
 /**
  * @brief  Breaks a long path into wrapped lines, splitting at path separators
@@ -71,7 +73,8 @@ static int WrapText(const char *text, char lines[][32], int maxLines, int maxCha
 
 /**
  * @brief  Called on failed configASSERT or HAL assert.
- *         Displays the wrapped file path and line number centered.
+ *         Stores a post-mortem record, displays the wrapped file path and
+ *         line number centered, then reboots.
  */
 void vAssertCalled(const char *file, int line)
 {
@@ -79,6 +82,8 @@ void vAssertCalled(const char *file, int line)
     vTaskSuspendAll();
     __disable_irq();
 
+    Crash_CaptureAssert(file, line, (uint32_t)__builtin_return_address(0));
+
     // prepare LCD
     BSP_LCD_Clear(ASSERT_BG_COLOR);
     BSP_LCD_SetTextColor(ASSERT_TEXT_COLOR);
@@ -121,12 +126,14 @@ void vAssertCalled(const char *file, int line)
     int numPx = numLen * fontW;
     BSP_LCD_DisplayStringAt((screenW - numPx) / 2, yStart + fontH * (fileLines + 1), (uint8_t*)numBuf, LEFT_MODE);
 
-    // blink LED3 in infinite loop
-    while (1)
+    // blink LED3 while the message is up, then start over
+    for (int n = 0; n < ASSERT_REBOOT_BLINKS; n++)
     {
         BSP_LED_Off(LED3);
         for (volatile uint32_t i = 0; i < 20000000; ++i) { __NOP(); }
         BSP_LED_On(LED3);
         for (volatile uint32_t i = 0; i < 500000; ++i) { __NOP(); }
     }
+
+    Crash_Reboot();
 }
\ No newline at end of file
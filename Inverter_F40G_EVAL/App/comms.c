@@ -1,4 +1,5 @@
-/* HV MCU reading task */
+/* HV MCU reading task: telemetry frames of the F030 (Inverter_F030_PSA
+ * App/telemetry.h) on USART3, 115200 8N1 as on its USART1 */
 
 #include "app.h"
 #include "usart.h"
@@ -45,7 +46,7 @@ static bool TryParsePacket(uint8_t *out)
 
   if (cs == pkt_cs)
   {
-    // копируем полезные 9 байт
+    // копируем тип кадра и 8 байт данных
     for (int i = 0; i < 9; i++)
       out[i] = uart_buf[(uart_tail + i) % UART_BUF_SIZE];
     // продвигаем tail на 10
@@ -116,7 +117,7 @@ void CommsTask(void *p)
     // парсим пакеты
     while (TryParsePacket(packet))
     {
-      // сюда придут 9 измерений
+      // packet[0] — тип кадра (TELEMETRY_*), packet[1..8] — данные
       //ProcessIncomingData(packet);
     }
     // ждать до следующего чанка
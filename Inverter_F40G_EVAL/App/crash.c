@@ -0,0 +1,333 @@
+/* Post-mortem crash capture
+ *
+ * HardFault, failed asserts and Error_Handler() write a CrashRecord_t into
+ * the 4 KB backup SRAM (kept across resets, and across power cycles while
+ * VBAT is present) and reboot. On the next boot Crash_ReportPending() dumps
+ * the record over USART3 (the RS-232 connector) as hex lines that
+ * Tools/crash_decode.py turns into a report.
+ *
+ * The record holds the stacked registers, fault status registers, the
+ * running task, the last CRASH_TRACE_LEN trace events (task switches from
+ * the FreeRTOS trace hooks plus application events) and a stack snippet.
+ */
+
+#include "crash.h"
+#include "main.h"
+#include "usart.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define CRASH_UART_TIMEOUT  100             // ms per line
+
+// Live trace ring, also in backup SRAM so a hard lockup still leaves it
+typedef struct {
+    uint32_t     magic;
+    uint32_t     head;                      // next slot to write
+    uint32_t     count;
+    CrashTrace_t ev[CRASH_TRACE_LEN];
+} CrashTraceRing_t;
+
+#define CRASH_RECORD   ((CrashRecord_t *)BKPSRAM_BASE)
+#define CRASH_RING     ((CrashTraceRing_t *)(BKPSRAM_BASE + 0x800))
+
+_Static_assert(sizeof(CrashRecord_t) <= 0x800, "crash record overlaps the trace ring");
+_Static_assert(0x800 + sizeof(CrashTraceRing_t) <= 0x1000, "trace ring exceeds backup SRAM");
+
+static bool ready;
+
+//-------------------------------------------------------------------------
+// Helpers
+//-------------------------------------------------------------------------
+
+static uint32_t Crc32(const void *data, uint32_t len)
+{
+    const uint8_t *p = data;
+    uint32_t crc = 0xFFFFFFFFu;
+
+    while (len--)
+    {
+        crc ^= *p++;
+        for (int k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+    }
+    return ~crc;
+}
+
+static uint32_t RecordCrc(const CrashRecord_t *r)
+{
+    return Crc32(r, offsetof(CrashRecord_t, crc));
+}
+
+// Number of readable bytes from addr up to the end of SRAM or CCM (0 if neither)
+static uint32_t RamBytesFrom(uint32_t addr)
+{
+    if (addr >= SRAM1_BASE && addr < SRAM1_BASE + 0x20000u)
+        return SRAM1_BASE + 0x20000u - addr;
+    if (addr >= CCMDATARAM_BASE && addr < CCMDATARAM_BASE + 0x10000u)
+        return CCMDATARAM_BASE + 0x10000u - addr;
+    return 0;
+}
+
+static uint32_t CurrentSP(void)
+{
+    // thread mode on the process stack -> PSP, otherwise MSP
+    if (__get_IPSR() == 0 && (__get_CONTROL() & CONTROL_SPSEL_Msk))
+        return __get_PSP();
+    return __get_MSP();
+}
+
+//-------------------------------------------------------------------------
+// Boot side
+//-------------------------------------------------------------------------
+
+/**
+ * @brief  Powers the backup SRAM and its regulator, starts the cycle counter
+ *         used for trace timestamps and arms the live trace ring.
+ *         Call early in main(), after HAL_Init().
+ */
+void Crash_Init(void)
+{
+    __HAL_RCC_PWR_CLK_ENABLE();
+    HAL_PWR_EnableBkUpAccess();
+    __HAL_RCC_BKPSRAM_CLK_ENABLE();
+    HAL_PWREx_EnableBkUpReg();          // keep the contents on VBAT
+
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    // a fresh ring each boot; the previous one was copied into the record
+    memset(CRASH_RING, 0, sizeof(CrashTraceRing_t));
+    CRASH_RING->magic = CRASH_MAGIC;
+
+    ready = true;
+}
+
+/**
+ * @brief  Dumps a record left by the previous run over USART3, once.
+ *         Call after MX_USART3_UART_Init() and before CommsInit().
+ */
+void Crash_ReportPending(void)
+{
+    CrashRecord_t *r = CRASH_RECORD;
+    char line[80];
+
+    if (!ready || r->magic != CRASH_MAGIC || r->version != CRASH_VERSION ||
+        r->size != sizeof(CrashRecord_t) || r->crc != RecordCrc(r) || r->reported)
+        return;
+
+    int n = snprintf(line, sizeof(line), "\r\n=== CRASH RECORD v%u reason %lu task '%.16s' ===\r\n",
+                     r->version, (unsigned long)r->reason, r->task);
+    HAL_UART_Transmit(&huart3, (uint8_t *)line, n, CRASH_UART_TIMEOUT);
+
+    const uint8_t *p = (const uint8_t *)r;
+    for (uint32_t off = 0; off < sizeof(CrashRecord_t); off += 32)
+    {
+        uint32_t chunk = sizeof(CrashRecord_t) - off;
+        if (chunk > 32)
+            chunk = 32;
+
+        n = snprintf(line, sizeof(line), "C:");
+        for (uint32_t i = 0; i < chunk; i++)
+            n += snprintf(line + n, sizeof(line) - n, "%02X", p[off + i]);
+        n += snprintf(line + n, sizeof(line) - n, "\r\n");
+        HAL_UART_Transmit(&huart3, (uint8_t *)line, n, CRASH_UART_TIMEOUT);
+    }
+
+    n = snprintf(line, sizeof(line), "=== END ===\r\n");
+    HAL_UART_Transmit(&huart3, (uint8_t *)line, n, CRASH_UART_TIMEOUT);
+
+    r->reported = 1;
+    r->crc = RecordCrc(r);
+}
+
+//-------------------------------------------------------------------------
+// Trace
+//-------------------------------------------------------------------------
+
+/**
+ * @brief  Appends an event to the live trace ring. Safe from tasks and ISRs.
+ */
+void Crash_Trace(uint8_t event, uint32_t arg)
+{
+    if (!ready)
+        return;
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    CrashTraceRing_t *ring = CRASH_RING;
+    CrashTrace_t *e = &ring->ev[ring->head];
+    e->cycles = DWT->CYCCNT;
+    e->arg    = arg;
+    e->event  = event;
+
+    ring->head = (ring->head + 1) % CRASH_TRACE_LEN;
+    if (ring->count < CRASH_TRACE_LEN)
+        ring->count++;
+
+    __set_PRIMASK(primask);
+}
+
+/**
+ * @brief  traceTASK_SWITCHED_IN() hook: logs the first 4 characters of the name.
+ */
+void Crash_TraceTaskIn(const char *name)
+{
+    uint32_t tag = 0;
+    for (int i = 0; i < 4 && name[i] != '\0'; i++)
+        tag |= (uint32_t)(uint8_t)name[i] << (8 * i);
+    Crash_Trace(CRASH_EV_TASK_IN, tag);
+}
+
+//-------------------------------------------------------------------------
+// Capture
+//-------------------------------------------------------------------------
+
+/**
+ * @param  regs        r0 r1 r2 r3 r12 lr pc xpsr, in exception frame order
+ * @param  stack_from  first address of the stack snippet
+ */
+static void Capture(CrashReason_t reason, const uint32_t *regs, uint32_t exc_return,
+                    uint32_t sp, uint32_t stack_from, const char *file, int line)
+{
+    if (!ready)
+        return;
+
+    CrashRecord_t *r = CRASH_RECORD;
+    memset(r, 0, sizeof(*r));
+
+    r->magic      = CRASH_MAGIC;
+    r->version    = CRASH_VERSION;
+    r->size       = sizeof(CrashRecord_t);
+    r->reason     = reason;
+    r->tick       = HAL_GetTick();
+    r->exc_return = exc_return;
+    r->sp         = sp;
+    r->cfsr       = SCB->CFSR;
+    r->hfsr       = SCB->HFSR;
+    r->mmfar      = SCB->MMFAR;
+    r->bfar       = SCB->BFAR;
+    r->line       = (uint32_t)line;
+
+    if (regs != NULL)
+        memcpy(r->frame, regs, sizeof(r->frame));
+
+    if (file != NULL)
+    {
+        // keep the tail of long paths, the file name matters most
+        size_t len = strlen(file);
+        if (len > CRASH_FILE_LEN - 1)
+            file += len - (CRASH_FILE_LEN - 1);
+        strncpy(r->file, file, CRASH_FILE_LEN - 1);
+    }
+
+    if (xTaskGetSchedulerState() != taskSCHEDULER_NOT_STARTED)
+        strncpy(r->task, pcTaskGetName(NULL), CRASH_TASK_NAME_LEN - 1);
+
+    // trace, oldest first
+    const CrashTraceRing_t *ring = CRASH_RING;
+    if (ring->magic == CRASH_MAGIC && ring->count <= CRASH_TRACE_LEN)
+    {
+        uint32_t idx = (ring->head + CRASH_TRACE_LEN - ring->count) % CRASH_TRACE_LEN;
+        for (uint32_t i = 0; i < ring->count; i++)
+        {
+            r->trace[i] = ring->ev[idx];
+            idx = (idx + 1) % CRASH_TRACE_LEN;
+        }
+        r->trace_count = ring->count;
+    }
+
+    // stack snippet, only if the stack pointer is sane
+    stack_from &= ~3u;
+    uint32_t avail = RamBytesFrom(stack_from) / 4;
+    uint32_t words = (avail < CRASH_STACK_WORDS) ? avail : CRASH_STACK_WORDS;
+    r->stack_addr  = stack_from;
+    r->stack_words = words;
+    memcpy(r->stack, (const void *)stack_from, words * 4);
+
+    r->crc = RecordCrc(r);
+}
+
+/**
+ * @brief  Records a failed assert. Called from vAssertCalled().
+ * @param  caller  Return address of vAssertCalled()
+ */
+void Crash_CaptureAssert(const char *file, int line, uint32_t caller)
+{
+    uint32_t frame[8] = { 0 };
+    frame[5] = caller;                  // lr
+    frame[6] = caller;                  // pc
+
+    uint32_t sp = CurrentSP();
+    Capture(CRASH_REASON_ASSERT, frame, 0, sp, sp, file, line);
+}
+
+/**
+ * @brief  Records a HAL Error_Handler() call. Called from Error_Handler().
+ * @param  caller  Return address of Error_Handler() (of the function
+ *                 before, if that one reached it with a tail call)
+ */
+void Crash_CaptureError(uint32_t caller)
+{
+    uint32_t frame[8] = { 0 };
+    frame[5] = caller;                  // lr
+    frame[6] = caller;                  // pc
+
+    uint32_t sp = CurrentSP();
+    Capture(CRASH_REASON_ERROR_HANDLER, frame, 0, sp, sp, NULL, 0);
+}
+
+/**
+ * @brief  Stops at a breakpoint when a debugger is attached, otherwise resets.
+ */
+void Crash_Reboot(void)
+{
+    if (CoreDebug->DHCSR & CoreDebug_DHCSR_C_DEBUGEN_Msk)
+        __BKPT(0);
+    NVIC_SystemReset();
+}
+
+/**
+ * @brief  C half of the HardFault handler.
+ * @param  frame       Exception frame on the stack that was active
+ * @param  exc_return  LR on exception entry
+ */
+__attribute__((used)) void Crash_FaultEntry(uint32_t *frame, uint32_t exc_return)
+{
+    // a corrupt SP would fault again while reading the frame
+    if (RamBytesFrom((uint32_t)frame) < 32)
+    {
+        Capture(CRASH_REASON_HARDFAULT, NULL, exc_return, (uint32_t)frame, 0, NULL, 0);
+        Crash_Reboot();
+    }
+
+    // SP before the exception: basic frame, FP frame, alignment padding
+    uint32_t sp = (uint32_t)frame + 32;
+    if (!(exc_return & 0x10u))
+        sp += 72;
+    if (frame[7] & (1u << 9))
+        sp += 4;
+
+    Capture(CRASH_REASON_HARDFAULT, frame, exc_return, sp, (uint32_t)frame, NULL, 0);
+    Crash_Reboot();
+}
+
+/**
+ * @brief  Picks the stack the fault was stacked on and hands it to C.
+ *         (Generation of this handler is disabled in InverterEval.ioc.)
+ */
+__attribute__((naked)) void HardFault_Handler(void)
+{
+    __asm volatile(
+        "tst   lr, #4           \n"
+        "ite   eq               \n"
+        "mrseq r0, msp          \n"
+        "mrsne r0, psp          \n"
+        "mov   r1, lr           \n"
+        "b     Crash_FaultEntry \n");
+}
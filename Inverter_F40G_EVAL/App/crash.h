@@ -0,0 +1,65 @@
+/* crash.h  — post-mortem capture in backup SRAM */
+#pragma once
+#include <stdint.h>
+
+#define CRASH_MAGIC         0x48535243u     // "CRSH"
+#define CRASH_VERSION       1
+#define CRASH_TRACE_LEN     32              // last N trace events kept
+#define CRASH_STACK_WORDS   32              // words copied from the faulting SP
+#define CRASH_TASK_NAME_LEN 16              // configMAX_TASK_NAME_LEN
+#define CRASH_FILE_LEN      64
+
+typedef enum {
+    CRASH_REASON_NONE = 0,
+    CRASH_REASON_ASSERT,            // configASSERT / assert_param
+    CRASH_REASON_HARDFAULT,
+    CRASH_REASON_ERROR_HANDLER,     // HAL Error_Handler()
+} CrashReason_t;
+
+typedef enum {
+    CRASH_EV_NONE = 0,
+    CRASH_EV_TASK_IN,               // arg = first 4 chars of the task name
+    CRASH_EV_QUEUE_FULL,            // arg = queue handle
+    CRASH_EV_USER = 0x80,           // application events start here
+} CrashEvent_t;
+
+typedef struct {
+    uint32_t cycles;                // DWT->CYCCNT
+    uint32_t arg;
+    uint8_t  event;
+    uint8_t  rsvd[3];
+} CrashTrace_t;
+
+/**
+ * Post-mortem record. The layout is read by Tools/crash_decode.py, bump
+ * CRASH_VERSION when it changes.
+ */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;                  // sizeof(CrashRecord_t)
+    uint32_t reason;                // CrashReason_t
+    uint32_t reported;              // non-zero once dumped over the UART
+    uint32_t tick;                  // HAL tick at the crash (ms)
+    uint32_t frame[8];              // stacked r0 r1 r2 r3 r12 lr pc xpsr
+    uint32_t exc_return;            // 0 for asserts
+    uint32_t sp;                    // SP before the exception / at the assert
+    uint32_t cfsr, hfsr, mmfar, bfar;
+    uint32_t line;
+    char     task[CRASH_TASK_NAME_LEN];
+    char     file[CRASH_FILE_LEN];
+    uint32_t trace_count;           // valid entries in trace[], oldest first
+    CrashTrace_t trace[CRASH_TRACE_LEN];
+    uint32_t stack_addr;
+    uint32_t stack_words;
+    uint32_t stack[CRASH_STACK_WORDS];
+    uint32_t crc;                   // CRC-32 (zlib) of everything above
+} CrashRecord_t;
+
+void Crash_Init(void);
+void Crash_ReportPending(void);
+void Crash_Trace(uint8_t event, uint32_t arg);
+void Crash_TraceTaskIn(const char *name);
+void Crash_CaptureAssert(const char *file, int line, uint32_t caller);
+void Crash_CaptureError(uint32_t caller);
+void Crash_Reboot(void);
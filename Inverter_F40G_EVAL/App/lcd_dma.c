@@ -0,0 +1,194 @@
+/* LCD DMA engine
+ *
+ * Overrides the weak LCD_IO_DMA_Write() hook of the eval BSP, so large GRAM
+ * fills (clear, rectangles, bars) and row blits are moved by DMA2 in
+ * memory-to-memory mode instead of CPU store loops. The FSMC data register
+ * is a fixed destination (MINC off); the source either steps through a
+ * buffer or repeats one colour word (PINC off).
+ *
+ * The calling task sleeps on a task notification while a chunk is in flight.
+ * Before the scheduler runs (BSP_LCD_Clear() in main) or with interrupts
+ * masked, the transfer complete flag is polled instead, timed on the DWT
+ * cycle counter: SysTick does not advance with interrupts masked (an assert
+ * drawing its screen from vAssertCalled()).
+ */
+
+#include "app.h"
+#include "main.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include <stdbool.h>
+
+#define LCD_DMA_STREAM      DMA2_Stream0            // channel 0, free on this board
+#define LCD_DMA_IRQn        DMA2_Stream0_IRQn
+#define LCD_DMA_TC_FLAG     DMA_LISR_TCIF0
+#define LCD_DMA_ERR_FLAGS   (DMA_LISR_TEIF0 | DMA_LISR_FEIF0)
+#define LCD_DMA_ALL_FLAGS   (DMA_LIFCR_CTCIF0 | DMA_LIFCR_CHTIF0 | DMA_LIFCR_CTEIF0 | \
+                             DMA_LIFCR_CDMEIF0 | DMA_LIFCR_CFEIF0)
+
+#define LCD_DMA_MAX_CHUNK   0xFFFFu                 // NDTR is 16 bits
+#define LCD_DMA_TIMEOUT_MS  50                      // one chunk is ~5 ms on the FSMC
+
+// Must be at or below configLIBRARY_MAX_SYSCALL_INTERRUPT_PRIORITY (5) numerically
+#define LCD_DMA_IRQ_PRIO    6
+
+static TaskHandle_t     waitingTask;
+static volatile bool    busy;                       // taken by Claim(), with interrupts off
+static uint16_t         fillWord;                   // fill source, must outlive the call
+
+/**
+ * @brief  Enables the DMA2 clock and the transfer complete interrupt.
+ *         Call once before the first LCD drawing.
+ */
+void LCD_DMA_Init(void)
+{
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    // cycle counter for the polled timeout
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+    LCD_DMA_STREAM->CR &= ~DMA_SxCR_EN;
+    while (LCD_DMA_STREAM->CR & DMA_SxCR_EN)
+        ;
+    DMA2->LIFCR = LCD_DMA_ALL_FLAGS;
+
+    HAL_NVIC_SetPriority(LCD_DMA_IRQn, LCD_DMA_IRQ_PRIO, 0);
+    HAL_NVIC_EnableIRQ(LCD_DMA_IRQn);
+}
+
+void DMA2_Stream0_IRQHandler(void)
+{
+    BaseType_t woken = pdFALSE;
+
+    LCD_DMA_STREAM->CR &= ~(DMA_SxCR_TCIE | DMA_SxCR_TEIE);
+    if (waitingTask != NULL)
+        vTaskNotifyGiveFromISR(waitingTask, &woken);
+
+    portYIELD_FROM_ISR(woken);
+}
+
+// true when the caller can block on a notification
+static bool CanSleep(void)
+{
+    return (__get_PRIMASK() == 0) &&
+           (__get_IPSR() == 0) &&
+           (xTaskGetSchedulerState() == taskSCHEDULER_RUNNING);
+}
+
+// The stream cannot reach CCM RAM; anything else (SRAM, flash) is fine
+static bool Reachable(const void *p)
+{
+    uint32_t a = (uint32_t)p;
+    return !(a >= CCMDATARAM_BASE && a < CCMDATARAM_BASE + 0x10000u);
+}
+
+/**
+ * @brief  Runs one chunk and waits for it. Returns the number of words
+ *         that were NOT transferred (non-zero only after a timeout).
+ */
+static uint32_t RunChunk(volatile uint16_t *pDst, const uint16_t *pSrc,
+                         uint16_t count, bool increment, bool sleep)
+{
+    DMA2->LIFCR = LCD_DMA_ALL_FLAGS;
+
+    // memory-to-memory: PAR is the source, M0AR the destination
+    LCD_DMA_STREAM->PAR  = (uint32_t)pSrc;
+    LCD_DMA_STREAM->M0AR = (uint32_t)pDst;
+    LCD_DMA_STREAM->NDTR = count;
+    LCD_DMA_STREAM->FCR  = DMA_SxFCR_DMDIS | DMA_SxFCR_FTH;   // FIFO on, full threshold
+
+    uint32_t cr = DMA_SxCR_DIR_1                 // memory to memory
+                | DMA_SxCR_PSIZE_0               // 16-bit source
+                | DMA_SxCR_MSIZE_0               // 16-bit destination
+                | DMA_SxCR_PL_0;                 // medium priority
+    if (increment)
+        cr |= DMA_SxCR_PINC;
+    if (sleep)
+    {
+        cr |= DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+        waitingTask = xTaskGetCurrentTaskHandle();
+        (void)ulTaskNotifyTake(pdTRUE, 0);      // drop a stale notification
+    }
+
+    LCD_DMA_STREAM->CR = cr;
+    LCD_DMA_STREAM->CR = cr | DMA_SxCR_EN;
+
+    bool done;
+    if (sleep)
+    {
+        done = ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(LCD_DMA_TIMEOUT_MS)) != 0;
+        waitingTask = NULL;
+    }
+    else
+    {
+        uint32_t start   = DWT->CYCCNT;
+        uint32_t timeout = (SystemCoreClock / 1000u) * LCD_DMA_TIMEOUT_MS;
+        while (!(DMA2->LISR & (LCD_DMA_TC_FLAG | LCD_DMA_ERR_FLAGS)) &&
+               (DWT->CYCCNT - start) < timeout)
+            ;
+        done = (DMA2->LISR & LCD_DMA_TC_FLAG) != 0;
+    }
+
+    LCD_DMA_STREAM->CR &= ~DMA_SxCR_EN;
+    while (LCD_DMA_STREAM->CR & DMA_SxCR_EN)
+        ;
+    uint32_t left = done ? 0 : LCD_DMA_STREAM->NDTR;
+    DMA2->LIFCR = LCD_DMA_ALL_FLAGS;
+    return left;
+}
+
+// Takes the engine; false while another caller (a task, or an ISR drawing
+// over one) has it. Test and set with interrupts off, masked state restored.
+static bool Claim(void)
+{
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    bool taken = busy;
+    busy = true;
+    __set_PRIMASK(primask);
+    return !taken;
+}
+
+/**
+ * @brief  DMA back end for LCD_IO_WriteMultipleData() / LCD_IO_FillData().
+ * @retval 1 if all words were written, 0 to let the BSP use CPU writes
+ */
+uint8_t LCD_IO_DMA_Write(volatile uint16_t *pDst, const uint16_t *pSrc, uint32_t Count, uint8_t Increment)
+{
+    if (!Reachable(pSrc) || !Claim())
+        return 0;
+
+    if (!Increment)
+    {
+        // the caller's word usually lives on its stack
+        fillWord = *pSrc;
+        pSrc = &fillWord;
+    }
+
+    bool sleep = CanSleep();
+
+    while (Count > 0)
+    {
+        uint16_t chunk = (Count > LCD_DMA_MAX_CHUNK) ? LCD_DMA_MAX_CHUNK : (uint16_t)Count;
+        uint32_t left  = RunChunk(pDst, pSrc, chunk, Increment != 0, sleep);
+
+        // GRAM address has already advanced; finish this chunk by hand
+        uint32_t sent = chunk - left;
+        const uint16_t *p = Increment ? pSrc + sent : pSrc;
+        while (left--)
+        {
+            *pDst = *p;
+            if (Increment)
+                p++;
+        }
+
+        if (Increment)
+            pSrc += chunk;
+        Count -= chunk;
+    }
+
+    busy = false;
+    return 1;
+}
@@ -6,37 +6,156 @@
 #include "cmsis_os2.h"        // for osDelay
 #include "stm324xg_eval_lcd.h"
 #include "stm324xg_eval.h"
+#include "lcd_widgets.h"
+#include "scope.h"
 
 #include <stdio.h>
 
 extern QueueHandle_t xSensorQueue;
 
+#define UI_FRAME_MS       50    // 20 Hz telemetry refresh
+#define UI_BLINK_FRAMES   10    // heartbeat LED toggles every 500 ms
+
+#define UI_VALUES_X       16
+#define UI_VALUES_Y       64
+#define UI_VALUE_PITCH_X  100
+#define UI_VALUE_PITCH_Y  20
+
+#define UI_SCOPE_STATS_Y  (SCOPE_PLOT_Y + SCOPE_PLOT_H + 4)
+#define UI_KEY_PRESSED    GPIO_PIN_RESET   // KEY button pulls PG15 low
+
+typedef enum {
+    SCREEN_TELEMETRY,
+    SCREEN_SCOPE,
+} UiScreen_t;
+
+static TextWidget_t titleText;
+static TextWidget_t valueText[9];
+static BarWidget_t  levelBar;
+static TextWidget_t frameText;
+static TextWidget_t scopeText[3];        // RMS, peak, frequency
+
+static void UI_Layout(void)
+{
+    Widget_TextInit(&titleText, 0, Font24.Height, 18, &Font24, LCD_COLOR_YELLOW, LCD_COLOR_BLACK);
+
+    // 9 sensor bytes in a 3x3 grid
+    for (int i = 0; i < 9; i++)
+    {
+        Widget_TextInit(&valueText[i],
+                        UI_VALUES_X + (i % 3) * UI_VALUE_PITCH_X,
+                        UI_VALUES_Y + (i / 3) * UI_VALUE_PITCH_Y,
+                        5, &Font16, LCD_COLOR_WHITE, LCD_COLOR_BLACK);
+    }
+
+    // control level (raw[0], see ControlTask)
+    Widget_BarInit(&levelBar, UI_VALUES_X, 136, 288, 16,
+                   LCD_COLOR_GREEN, LCD_COLOR_BLACK, LCD_COLOR_GRAY);
+
+    Widget_TextInit(&frameText, 0, BSP_LCD_GetYSize() - Font12.Height, 24, &Font12, LCD_COLOR_GRAY, LCD_COLOR_BLACK);
+
+    for (int i = 0; i < 3; i++)
+        Widget_TextInit(&scopeText[i], 4 + i * 106, UI_SCOPE_STATS_Y, 9, &Font16, LCD_COLOR_WHITE, LCD_COLOR_BLACK);
+}
+
 /**
- * @brief  Blink LED1 and refresh display with last sensor packet.
+ * @brief  Clears the glass and makes every widget of the new screen repaint.
  */
+static void UI_Switch(UiScreen_t screen)
+{
+    BSP_LCD_Clear(LCD_COLOR_BLACK);
+
+    Widget_TextInvalidate(&titleText);
+    for (int i = 0; i < 9; i++)
+        Widget_TextInvalidate(&valueText[i]);
+    Widget_BarInvalidate(&levelBar);
+    Widget_TextInvalidate(&frameText);
+    for (int i = 0; i < 3; i++)
+        Widget_TextInvalidate(&scopeText[i]);
+
+    if (screen == SCREEN_SCOPE)
+        Scope_Invalidate();
+}
+
+static void UI_DrawTelemetry(void)
+{
+    sensorPacket_t pkt;
+
+    Widget_SetText(&titleText, "LEDUITask");
 
+    if (xQueuePeek(xSensorQueue, &pkt, 0) == pdPASS)
+    {
+        for (int i = 0; i < 9; i++)
+            Widget_SetNumber(&valueText[i], pkt.raw[i], 0, NULL);
+
+        Widget_SetBar(&levelBar, pkt.raw[0], 255);
+    }
+}
+
+static void UI_DrawScope(void)
+{
+    Scope_Draw();
+
+    const ScopeStats_t *sc = Scope_GetStats();
+    Widget_SetText(&titleText, sc->triggered ? "Scope  trig" : "Scope  auto");
+    Widget_SetNumber(&scopeText[0], sc->rms_mV, 3, "Vr");
+    Widget_SetNumber(&scopeText[1], sc->peak_mV, 3, "Vp");
+    Widget_SetNumber(&scopeText[2], sc->freq_dHz, 1, "Hz");
+}
+
+/**
+ * @brief  Blink LED1 and refresh the current screen: telemetry from the last
+ *         sensor packet, or the scope view. The KEY button switches screens.
+ *         Widgets repaint only what changed, so a 20 Hz refresh stays cheap.
+ */
 void LEDUITask(void *argument)
 {
     (void)argument;
 
-    // Optional: set up text/font once
-    BSP_LCD_SetTextColor(LCD_COLOR_YELLOW);
-    BSP_LCD_SetBackColor(LCD_COLOR_BLACK);
-    BSP_LCD_SetFont(&Font24);
+    char buf[WIDGET_MAX_COLS + 1];
+    uint32_t frame = 0;
+    UiScreen_t screen = SCREEN_TELEMETRY;
+    uint32_t key, lastKey = !UI_KEY_PRESSED;
+
+    Widget_Init();
+    UI_Layout();
+    Scope_Init();
+    BSP_PB_Init(BUTTON_KEY, BUTTON_MODE_GPIO);
+
+    uint32_t next = osKernelGetTickCount();
 
     for (;;)
     {
         // Toggle the heartbeat LED
-        BSP_LED_Toggle(LED1);
+        if (frame++ % UI_BLINK_FRAMES == 0)
+            BSP_LED_Toggle(LED1);
+
+        // Switch screens on the press edge (the 50 ms frame debounces it)
+        key = BSP_PB_GetState(BUTTON_KEY);
+        if (key == UI_KEY_PRESSED && lastKey != UI_KEY_PRESSED)
+        {
+            screen = (screen == SCREEN_TELEMETRY) ? SCREEN_SCOPE : SCREEN_TELEMETRY;
+            UI_Switch(screen);
+        }
+        lastKey = key;
+
+        Widget_FrameBegin();
+
+        if (screen == SCREEN_SCOPE)
+            UI_DrawScope();
+        else
+            UI_DrawTelemetry();
 
-        // Clear the line to avoid leftover pixels
-        BSP_LCD_ClearStringLine(1);
+        const WidgetFrameStats_t *st = Widget_GetFrameStats();
+        snprintf(buf, sizeof(buf), "frame %5lu/%5lu us",
+                 (unsigned long)st->last_us, (unsigned long)st->max_us);
+        Widget_SetText(&frameText, buf);
 
-        // Print on line 1 (second text line)
-        BSP_LCD_DisplayStringAtLine(1, (uint8_t*)"LEDUITask");
+        Widget_FrameEnd();
 
-        // Block for 500 ms so other tasks (and you!) can see it
-        osDelay(500);
+        // Fixed-rate refresh: sleep until the next 50 ms slot
+        next += pdMS_TO_TICKS(UI_FRAME_MS);
+        osDelayUntil(next);
     }
 }
 
@@ -0,0 +1,279 @@
+/* LCD widget layer
+ *
+ * Every widget keeps a copy of what it last put on the glass and repaints
+ * only the glyph cells (or bar strip) that differ. On the ILI9325 each pixel
+ * costs several FSMC writes, so skipping unchanged cells is what keeps a
+ * 20 Hz telemetry screen cheap and flicker-free.
+ */
+
+#include "lcd_widgets.h"
+#include "stm324xg_eval_lcd.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static WidgetFrameStats_t frameStats;
+static uint32_t           frameStart;
+
+/* Saved draw properties, so widgets don't disturb other LCD users */
+typedef struct {
+    sFONT   *font;
+    uint16_t fg, bg;
+} DrawState_t;
+
+static void SaveDrawState(DrawState_t *s)
+{
+    s->font = BSP_LCD_GetFont();
+    s->fg   = BSP_LCD_GetTextColor();
+    s->bg   = BSP_LCD_GetBackColor();
+}
+
+static void RestoreDrawState(const DrawState_t *s)
+{
+    BSP_LCD_SetFont(s->font);
+    BSP_LCD_SetTextColor(s->fg);
+    BSP_LCD_SetBackColor(s->bg);
+}
+
+/**
+ * @brief  Paints a solid w x h rectangle.
+ */
+static void FillArea(uint16_t x, uint16_t y, uint16_t w, uint16_t h, uint16_t color)
+{
+    if (w == 0 || h == 0)
+        return;
+
+    BSP_LCD_SetTextColor(color);
+    // BSP_LCD_FillRect() paints Height + 1 rows
+    BSP_LCD_FillRect(x, y, w, h - 1);
+}
+
+/**
+ * @brief  Enables the DWT cycle counter used for frame timing.
+ */
+void Widget_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+
+    Widget_ResetFrameStats();
+}
+
+//-------------------------------------------------------------------------
+// Text fields
+//-------------------------------------------------------------------------
+
+void Widget_TextInit(TextWidget_t *w, uint16_t x, uint16_t y, uint8_t cols,
+                     sFONT *font, uint16_t fg, uint16_t bg)
+{
+    if (cols > WIDGET_MAX_COLS)
+        cols = WIDGET_MAX_COLS;
+
+    w->x     = x;
+    w->y     = y;
+    w->cols  = cols;
+    w->font  = font;
+    w->fg    = fg;
+    w->bg    = bg;
+    w->valid = false;
+    memset(w->shown, ' ', cols);
+    w->shown[cols] = '\0';
+}
+
+/**
+ * @brief  Forces the next update to repaint the whole field
+ *         (e.g. after the screen was cleared underneath it).
+ */
+void Widget_TextInvalidate(TextWidget_t *w)
+{
+    w->valid = false;
+}
+
+/**
+ * @brief  Shows text left-aligned in the field. Shorter text is blank-padded,
+ *         longer text is truncated. Only changed cells are redrawn.
+ */
+void Widget_SetText(TextWidget_t *w, const char *text)
+{
+    char next[WIDGET_MAX_COLS + 1];
+    uint8_t i = 0;
+
+    // pad with blanks so a shorter string erases the tail of the old one
+    while (i < w->cols && text[i] != '\0')
+    {
+        char c = text[i];
+        next[i++] = (c >= ' ' && c <= '~') ? c : '?';
+    }
+    while (i < w->cols)
+        next[i++] = ' ';
+    next[w->cols] = '\0';
+
+    DrawState_t saved;
+    bool        drawing = false;
+
+    for (i = 0; i < w->cols; i++)
+    {
+        if (w->valid && next[i] == w->shown[i])
+            continue;
+
+        if (!drawing)
+        {
+            SaveDrawState(&saved);
+            BSP_LCD_SetFont(w->font);
+            BSP_LCD_SetTextColor(w->fg);
+            BSP_LCD_SetBackColor(w->bg);
+            drawing = true;
+        }
+        BSP_LCD_DisplayChar(w->x + i * w->font->Width, w->y, (uint8_t)next[i]);
+        frameStats.cells++;
+    }
+
+    if (drawing)
+        RestoreDrawState(&saved);
+
+    memcpy(w->shown, next, sizeof(next));
+    w->valid = true;
+}
+
+/**
+ * @brief  Shows a fixed-point number right-aligned in the field.
+ * @param  value     Scaled integer, e.g. 1234 with decimals = 1 shows "123.4"
+ * @param  decimals  Number of digits after the decimal point (0..9)
+ * @param  unit      Optional suffix, may be NULL
+ */
+void Widget_SetNumber(TextWidget_t *w, int32_t value, uint8_t decimals, const char *unit)
+{
+    char num[WIDGET_MAX_COLS + 1];
+    char text[WIDGET_MAX_COLS + 1];
+
+    uint32_t mag = (value < 0) ? 0u - (uint32_t)value : (uint32_t)value;
+    const char *sign = (value < 0) ? "-" : "";
+    if (unit == NULL)
+        unit = "";
+
+    if (decimals == 0)
+    {
+        snprintf(num, sizeof(num), "%s%lu%s", sign, (unsigned long)mag, unit);
+    }
+    else
+    {
+        uint32_t div = 1;
+        for (uint8_t i = 0; i < decimals; i++)
+            div *= 10;
+        snprintf(num, sizeof(num), "%s%lu.%0*lu%s", sign, (unsigned long)(mag / div),
+                 (int)decimals, (unsigned long)(mag % div), unit);
+    }
+
+    int len = strlen(num);
+    int pad = w->cols - len;
+    if (pad < 0)
+        pad = 0;
+    memset(text, ' ', pad);
+    strcpy(text + pad, num);
+
+    Widget_SetText(w, text);
+}
+
+//-------------------------------------------------------------------------
+// Bars
+//-------------------------------------------------------------------------
+
+void Widget_BarInit(BarWidget_t *b, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                    uint16_t fg, uint16_t bg, uint16_t frame)
+{
+    b->x        = x;
+    b->y        = y;
+    b->w        = w;
+    b->h        = h;
+    b->fg       = fg;
+    b->bg       = bg;
+    b->frame    = frame;
+    b->shown_px = 0;
+    b->valid    = false;
+}
+
+void Widget_BarInvalidate(BarWidget_t *b)
+{
+    b->valid = false;
+}
+
+/**
+ * @brief  Sets the bar fill to value/max. Only the strip between the old and
+ *         the new fill length is repainted.
+ */
+void Widget_SetBar(BarWidget_t *b, uint32_t value, uint32_t max)
+{
+    // 1-pixel frame around the fill area
+    uint16_t inner_x = b->x + 1;
+    uint16_t inner_y = b->y + 1;
+    uint16_t inner_w = b->w - 2;
+    uint16_t inner_h = b->h - 2;
+
+    uint16_t px = 0;
+    if (max != 0)
+        px = (value >= max) ? inner_w : (uint16_t)(((uint64_t)value * inner_w) / max);
+
+    if (b->valid && px == b->shown_px)
+        return;
+
+    DrawState_t saved;
+    SaveDrawState(&saved);
+
+    if (!b->valid)
+    {
+        BSP_LCD_SetTextColor(b->frame);
+        BSP_LCD_DrawRect(b->x, b->y, b->w - 1, b->h - 1);
+        FillArea(inner_x, inner_y, px, inner_h, b->fg);
+        FillArea(inner_x + px, inner_y, inner_w - px, inner_h, b->bg);
+        b->valid = true;
+    }
+    else if (px > b->shown_px)
+    {
+        FillArea(inner_x + b->shown_px, inner_y, px - b->shown_px, inner_h, b->fg);
+    }
+    else
+    {
+        FillArea(inner_x + px, inner_y, b->shown_px - px, inner_h, b->bg);
+    }
+
+    RestoreDrawState(&saved);
+    b->shown_px = px;
+}
+
+//-------------------------------------------------------------------------
+// Frame timing
+//-------------------------------------------------------------------------
+
+/**
+ * @brief  Marks the start of a UI frame (call before the first widget update).
+ */
+void Widget_FrameBegin(void)
+{
+    frameStats.cells = 0;
+    frameStart = DWT->CYCCNT;
+}
+
+/**
+ * @brief  Marks the end of a UI frame and updates the timing statistics.
+ */
+void Widget_FrameEnd(void)
+{
+    uint32_t cycles = DWT->CYCCNT - frameStart;
+    uint32_t us     = cycles / (SystemCoreClock / 1000000u);
+
+    frameStats.last_us = us;
+    if (us > frameStats.max_us)
+        frameStats.max_us = us;
+    frameStats.frames++;
+}
+
+const WidgetFrameStats_t *Widget_GetFrameStats(void)
+{
+    return &frameStats;
+}
+
+void Widget_ResetFrameStats(void)
+{
+    memset(&frameStats, 0, sizeof(frameStats));
+}
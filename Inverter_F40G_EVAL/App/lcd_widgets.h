@@ -0,0 +1,57 @@
+/* lcd_widgets.h  — cached text/bar widgets for the eval LCD */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+#include "fonts.h"
+
+// Longest text field, in glyph cells (320 px / Font8 width = 64, but we never need that many)
+#define WIDGET_MAX_COLS   24
+
+/**
+ * Text field (label or numeric). Remembers what is currently on the glass,
+ * so an update only repaints the glyph cells whose character changed.
+ */
+typedef struct {
+    uint16_t x, y;                       // top-left corner in pixels
+    uint8_t  cols;                       // field width in glyph cells
+    sFONT   *font;
+    uint16_t fg, bg;
+    char     shown[WIDGET_MAX_COLS + 1]; // text currently drawn on the LCD
+    bool     valid;                      // false -> next update repaints every cell
+} TextWidget_t;
+
+/**
+ * Horizontal bar. Only the strip between the old and the new fill
+ * length is repainted.
+ */
+typedef struct {
+    uint16_t x, y, w, h;                 // outer frame in pixels
+    uint16_t fg, bg, frame;
+    uint16_t shown_px;                   // fill length currently drawn
+    bool     valid;
+} BarWidget_t;
+
+typedef struct {
+    uint32_t last_us;                    // duration of the last frame
+    uint32_t max_us;                     // worst frame since Widget_ResetFrameStats()
+    uint32_t frames;                     // frames rendered
+    uint16_t cells;                      // glyph cells repainted in the last frame
+} WidgetFrameStats_t;
+
+void Widget_Init(void);
+
+void Widget_TextInit(TextWidget_t *w, uint16_t x, uint16_t y, uint8_t cols,
+                     sFONT *font, uint16_t fg, uint16_t bg);
+void Widget_SetText(TextWidget_t *w, const char *text);
+void Widget_SetNumber(TextWidget_t *w, int32_t value, uint8_t decimals, const char *unit);
+void Widget_TextInvalidate(TextWidget_t *w);
+
+void Widget_BarInit(BarWidget_t *b, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                    uint16_t fg, uint16_t bg, uint16_t frame);
+void Widget_SetBar(BarWidget_t *b, uint32_t value, uint32_t max);
+void Widget_BarInvalidate(BarWidget_t *b);
+
+void Widget_FrameBegin(void);
+void Widget_FrameEnd(void);
+const WidgetFrameStats_t *Widget_GetFrameStats(void);
+void Widget_ResetFrameStats(void);
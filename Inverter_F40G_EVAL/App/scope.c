@@ -0,0 +1,327 @@
+/* On-board oscilloscope
+ *
+ * ADC3 samples PF9 on every TIM2 update and DMA2 Stream1 writes the results
+ * into a circular ring, so capture costs no CPU at all. Scope_Draw() takes a
+ * snapshot of the ring, looks for the newest rising edge that still has a
+ * full screen of samples after it, reduces every column to a min/max pair
+ * and repaints only the columns whose pair changed. RMS, peak and frequency
+ * are computed from the same snapshot over a whole number of periods.
+ */
+
+#include "scope.h"
+#include "main.h"
+#include "stm324xg_eval_lcd.h"
+
+#include <math.h>
+#include <string.h>
+
+#define SCOPE_ADC_CHANNEL   7               // ADC3_IN7 = PF9
+#define SCOPE_DMA_STREAM    DMA2_Stream1    // ADC3 request, channel 2
+#define SCOPE_GUARD         32              // oldest samples may be overwritten while copying
+#define SCOPE_PRETRIGGER    32              // columns shown before the trigger point
+
+#define SCOPE_FULL_SCALE    4095u
+#define SCOPE_VREF_MV       3300u
+
+#define SCOPE_TRACE_COLOR   LCD_COLOR_GREEN
+#define SCOPE_BACK_COLOR    LCD_COLOR_BLACK
+#define SCOPE_GRID_COLOR    LCD_COLOR_DARKGRAY
+
+#define COLUMN_NONE         0xFF            // nothing drawn in this column yet
+
+static uint16_t ring[SCOPE_RING_SAMPLES];  // written by DMA
+static uint16_t snap[SCOPE_RING_SAMPLES];  // oldest sample first
+
+// What is currently on the glass, as plot rows (0 = top)
+static uint8_t  shownTop[SCOPE_PLOT_W];
+static uint8_t  shownBot[SCOPE_PLOT_W];
+
+static uint8_t      decimation = SCOPE_MAX_DECIM;
+static ScopeStats_t stats;
+
+/**
+ * @brief  Starts continuous capture: TIM2 TRGO -> ADC3 -> DMA2 Stream1 (circular).
+ */
+void Scope_Init(void)
+{
+    __HAL_RCC_GPIOF_CLK_ENABLE();
+    __HAL_RCC_ADC3_CLK_ENABLE();
+    __HAL_RCC_TIM2_CLK_ENABLE();
+    __HAL_RCC_DMA2_CLK_ENABLE();
+
+    // PF9 analog
+    GPIOF->MODER |= 3u << (9 * 2);
+    GPIOF->PUPDR &= ~(3u << (9 * 2));
+
+    // ADC clock = PCLK2 / 4 = 21 MHz; 56-cycle sampling -> 3.2 us per conversion
+    ADC->CCR = (ADC->CCR & ~ADC_CCR_ADCPRE) | ADC_CCR_ADCPRE_0;
+    ADC3->CR1   = 0;                                   // 12 bit, no scan
+    ADC3->SMPR2 = 3u << ADC_SMPR2_SMP7_Pos;
+    ADC3->SQR1  = 0;                                   // one conversion
+    ADC3->SQR3  = SCOPE_ADC_CHANNEL;
+
+    SCOPE_DMA_STREAM->CR &= ~DMA_SxCR_EN;
+    while (SCOPE_DMA_STREAM->CR & DMA_SxCR_EN)
+        ;
+    DMA2->LIFCR = DMA_LIFCR_CTCIF1 | DMA_LIFCR_CHTIF1 | DMA_LIFCR_CTEIF1 |
+                  DMA_LIFCR_CDMEIF1 | DMA_LIFCR_CFEIF1;
+    SCOPE_DMA_STREAM->PAR  = (uint32_t)&ADC3->DR;
+    SCOPE_DMA_STREAM->M0AR = (uint32_t)ring;
+    SCOPE_DMA_STREAM->NDTR = SCOPE_RING_SAMPLES;
+    SCOPE_DMA_STREAM->FCR  = 0;                        // direct mode
+    SCOPE_DMA_STREAM->CR   = DMA_SxCR_CHSEL_1          // channel 2
+                           | DMA_SxCR_PSIZE_0          // 16 bit
+                           | DMA_SxCR_MSIZE_0
+                           | DMA_SxCR_MINC
+                           | DMA_SxCR_CIRC;            // peripheral -> memory
+    SCOPE_DMA_STREAM->CR  |= DMA_SxCR_EN;
+
+    // conversion on TIM2 TRGO rising edge, DMA requests kept running
+    ADC3->CR2 = ADC_CR2_EXTEN_0
+              | ADC_CR2_EXTSEL_1 | ADC_CR2_EXTSEL_2    // 0110: TIM2 TRGO
+              | ADC_CR2_DMA | ADC_CR2_DDS
+              | ADC_CR2_ADON;
+
+    // APB1 is divided, so the timer clock is 2 x PCLK1
+    uint32_t timclk = 2u * HAL_RCC_GetPCLK1Freq();
+    TIM2->CR1 = 0;
+    TIM2->PSC = 0;
+    TIM2->ARR = timclk / SCOPE_SAMPLE_HZ - 1u;
+    TIM2->CR2 = TIM_CR2_MMS_1;                         // TRGO on update
+    TIM2->EGR = TIM_EGR_UG;
+    TIM2->CR1 = TIM_CR1_CEN;
+
+    Scope_Invalidate();
+}
+
+/**
+ * @brief  Sets the samples per screen column (1..SCOPE_MAX_DECIM).
+ */
+void Scope_SetDecimation(uint8_t decim)
+{
+    if (decim < 1)
+        decim = 1;
+    if (decim > SCOPE_MAX_DECIM)
+        decim = SCOPE_MAX_DECIM;
+    decimation = decim;
+}
+
+/**
+ * @brief  Forgets what is on the glass; the next Scope_Draw() repaints
+ *         every column and the graticule (call after clearing the screen).
+ */
+void Scope_Invalidate(void)
+{
+    memset(shownTop, COLUMN_NONE, sizeof(shownTop));
+    memset(shownBot, COLUMN_NONE, sizeof(shownBot));
+}
+
+const ScopeStats_t *Scope_GetStats(void)
+{
+    return &stats;
+}
+
+//-------------------------------------------------------------------------
+// Capture analysis
+//-------------------------------------------------------------------------
+
+// Copies the ring oldest-first. The DMA keeps writing at ~1 sample / 100 us,
+// so only the first few entries of snap[] can be stale; SCOPE_GUARD skips them.
+static void TakeSnapshot(void)
+{
+    uint32_t wr = SCOPE_RING_SAMPLES - SCOPE_DMA_STREAM->NDTR;
+    if (wr >= SCOPE_RING_SAMPLES)
+        wr = 0;
+
+    uint32_t tail = SCOPE_RING_SAMPLES - wr;
+    memcpy(snap, &ring[wr], tail * sizeof(uint16_t));
+    memcpy(&snap[tail], ring, wr * sizeof(uint16_t));
+}
+
+static uint32_t ToMillivolts(uint32_t counts)
+{
+    return counts * SCOPE_VREF_MV / SCOPE_FULL_SCALE;
+}
+
+/**
+ * @brief  Finds rising crossings of the mid level (with hysteresis) and
+ *         fills in the waveform statistics.
+ * @return Index of the newest crossing that leaves a full screen after
+ *         the pretrigger, or -1 if there is none.
+ */
+static int32_t Analyse(uint32_t span)
+{
+    uint16_t lo = 0xFFFF, hi = 0;
+    for (uint32_t i = SCOPE_GUARD; i < SCOPE_RING_SAMPLES; i++)
+    {
+        if (snap[i] < lo) lo = snap[i];
+        if (snap[i] > hi) hi = snap[i];
+    }
+
+    uint16_t level = (lo + hi) / 2;
+    uint16_t hyst  = (hi - lo) / 16;
+    if (hyst < 8)
+        hyst = 8;
+
+    uint32_t pre = SCOPE_PRETRIGGER * decimation;
+    int32_t  first = -1, last = -1, trigger = -1;
+    uint32_t edges = 0;
+    bool     armed = false;
+
+    for (uint32_t i = SCOPE_GUARD; i < SCOPE_RING_SAMPLES; i++)
+    {
+        if (snap[i] + hyst < level)
+            armed = true;
+        else if (armed && snap[i] >= level)
+        {
+            armed = false;
+            if (first < 0)
+                first = i;
+            last = i;
+            edges++;
+
+            if (i >= SCOPE_GUARD + pre && i - pre + span <= SCOPE_RING_SAMPLES)
+                trigger = i;
+        }
+    }
+
+    // statistics over whole periods when we have them
+    uint32_t from = SCOPE_GUARD, to = SCOPE_RING_SAMPLES;
+    if (edges >= 2)
+    {
+        from = first;
+        to   = last;
+        stats.freq_dHz = (uint32_t)((uint64_t)SCOPE_SAMPLE_HZ * 10u * (edges - 1) / (to - from));
+    }
+    else
+    {
+        stats.freq_dHz = 0;
+    }
+
+    uint32_t sum = 0;
+    for (uint32_t i = from; i < to; i++)
+        sum += snap[i];
+    float mean = (float)sum / (to - from);
+
+    float    sq = 0;
+    uint16_t peak = 0;
+    for (uint32_t i = from; i < to; i++)
+    {
+        float d = snap[i] - mean;
+        sq += d * d;
+        uint16_t a = (uint16_t)fabsf(d);
+        if (a > peak)
+            peak = a;
+    }
+
+    stats.mean_mV = ToMillivolts((uint32_t)mean);
+    stats.rms_mV  = ToMillivolts((uint32_t)sqrtf(sq / (to - from)));
+    stats.peak_mV = ToMillivolts(peak);
+
+    return (trigger < 0) ? -1 : trigger - (int32_t)pre;
+}
+
+//-------------------------------------------------------------------------
+// Drawing
+//-------------------------------------------------------------------------
+
+static uint8_t ToRow(uint16_t sample)
+{
+    if (sample > SCOPE_FULL_SCALE)
+        sample = SCOPE_FULL_SCALE;
+    return (uint8_t)(SCOPE_PLOT_H - 1 - (uint32_t)sample * (SCOPE_PLOT_H - 1) / SCOPE_FULL_SCALE);
+}
+
+// Graticule: dotted lines every 40 px, dots every 4 px
+static void RestoreGrid(uint16_t col, uint8_t top, uint8_t bot)
+{
+    for (uint8_t r = top; r <= bot; r++)
+    {
+        bool dot = (col % 40 == 0 && r % 4 == 0) ||
+                   (col % 4 == 0 && r % 40 == 0);
+        if (dot)
+            BSP_LCD_DrawPixel(SCOPE_PLOT_X + col, SCOPE_PLOT_Y + r, SCOPE_GRID_COLOR);
+    }
+}
+
+static void PaintRows(uint16_t col, uint8_t top, uint8_t bot, uint16_t color)
+{
+    BSP_LCD_SetTextColor(color);
+    BSP_LCD_DrawVLine(SCOPE_PLOT_X + col, SCOPE_PLOT_Y + top, bot - top + 1);
+    if (color == SCOPE_BACK_COLOR)
+        RestoreGrid(col, top, bot);
+}
+
+/**
+ * @brief  Moves the trace in one column from [oldTop..oldBot] to [top..bot],
+ *         touching only the rows that change.
+ */
+static void UpdateColumn(uint16_t col, uint8_t top, uint8_t bot)
+{
+    uint8_t oldTop = shownTop[col];
+    uint8_t oldBot = shownBot[col];
+
+    if (oldTop == COLUMN_NONE)
+    {
+        // first paint: background + grid for the whole column, then trace
+        PaintRows(col, 0, SCOPE_PLOT_H - 1, SCOPE_BACK_COLOR);
+        PaintRows(col, top, bot, SCOPE_TRACE_COLOR);
+    }
+    else if (bot < oldTop || top > oldBot)
+    {
+        // no overlap
+        PaintRows(col, oldTop, oldBot, SCOPE_BACK_COLOR);
+        PaintRows(col, top, bot, SCOPE_TRACE_COLOR);
+    }
+    else
+    {
+        if (oldTop < top) PaintRows(col, oldTop, top - 1, SCOPE_BACK_COLOR);
+        if (oldBot > bot) PaintRows(col, bot + 1, oldBot, SCOPE_BACK_COLOR);
+        if (top < oldTop) PaintRows(col, top, oldTop - 1, SCOPE_TRACE_COLOR);
+        if (bot > oldBot) PaintRows(col, oldBot + 1, bot, SCOPE_TRACE_COLOR);
+    }
+
+    shownTop[col] = top;
+    shownBot[col] = bot;
+}
+
+/**
+ * @brief  Captures, triggers and redraws the changed columns of the trace.
+ *         Must run in the task that owns the LCD.
+ */
+void Scope_Draw(void)
+{
+    uint32_t span = (uint32_t)SCOPE_PLOT_W * decimation + 1;   // +1 joins the last column
+
+    TakeSnapshot();
+
+    int32_t start = Analyse(span);
+    stats.triggered = (start >= 0);
+    if (start < 0)
+        start = SCOPE_RING_SAMPLES - span;       // free-running: newest samples
+
+    uint16_t saved = BSP_LCD_GetTextColor();
+    stats.columns = 0;
+
+    const uint16_t *s = &snap[start];
+    for (uint16_t col = 0; col < SCOPE_PLOT_W; col++, s += decimation)
+    {
+        // include the first sample of the next column so the trace has no gaps
+        uint16_t lo = s[0], hi = s[0];
+        for (uint8_t k = 1; k <= decimation; k++)
+        {
+            if (s[k] < lo) lo = s[k];
+            if (s[k] > hi) hi = s[k];
+        }
+
+        uint8_t top = ToRow(hi);
+        uint8_t bot = ToRow(lo);
+        if (top == shownTop[col] && bot == shownBot[col])
+            continue;
+
+        UpdateColumn(col, top, bot);
+        stats.columns++;
+    }
+
+    BSP_LCD_SetTextColor(saved);
+}
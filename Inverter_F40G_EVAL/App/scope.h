@@ -0,0 +1,31 @@
+/* scope.h  — on-board oscilloscope view for the eval LCD */
+#pragma once
+#include <stdint.h>
+#include <stdbool.h>
+
+// Input: ADC3_IN7 on PF9, 0..3.3 V.
+// Feed it the RC-filtered PWM output or a divided-down output voltage.
+#define SCOPE_SAMPLE_HZ     10000u      // ADC3 trigger rate (TIM2 TRGO)
+#define SCOPE_RING_SAMPLES  4096u       // capture ring, 410 ms at 10 kHz
+#define SCOPE_MAX_DECIM     8u          // 320 columns x 8 = 2560 samples per screen
+
+// Plot area on the 320x240 panel
+#define SCOPE_PLOT_X        0
+#define SCOPE_PLOT_Y        52          // below the Font24 title
+#define SCOPE_PLOT_W        320
+#define SCOPE_PLOT_H        150
+
+typedef struct {
+    uint32_t rms_mV;            // AC RMS about the mean
+    uint32_t peak_mV;           // largest deviation from the mean
+    uint32_t mean_mV;
+    uint32_t freq_dHz;          // fundamental in 0.1 Hz, 0 if no edges found
+    bool     triggered;         // false -> free-running (no rising edge on screen)
+    uint16_t columns;           // columns repainted in the last Scope_Draw()
+} ScopeStats_t;
+
+void Scope_Init(void);
+void Scope_SetDecimation(uint8_t decim);
+void Scope_Invalidate(void);
+void Scope_Draw(void);
+const ScopeStats_t *Scope_GetStats(void);
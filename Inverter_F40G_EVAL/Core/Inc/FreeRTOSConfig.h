@@ -45,6 +45,7 @@
 
 /* USER CODE BEGIN Includes */
 #include "stm324xg_eval_lcd.h"
+#include "crash.h"
 #include <stdio.h>
 /* USER CODE END Includes */
 
@@ -174,6 +175,9 @@ standard names. */
 
 /* USER CODE BEGIN Defines */
 /* Section where parameter definitions can be added (for instance, to override default ones in FreeRTOS.h) */
+/* Trace hooks feeding the post-mortem record (App/crash.c) */
+#define traceTASK_SWITCHED_IN()              Crash_TraceTaskIn( pxCurrentTCB->pcTaskName )
+#define traceQUEUE_SEND_FAILED( pxQueue )    Crash_Trace( CRASH_EV_QUEUE_FULL, ( uint32_t ) ( pxQueue ) )
 /* USER CODE END Defines */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -95,7 +95,7 @@ void MX_FREERTOS_Init(void) {
   osThreadNew(CommsTask,   NULL, &(osThreadAttr_t){ .name="Comms",   .stack_size=256, .priority=osPriorityLow     });
 //  osThreadNew(ControlTask, NULL, &(osThreadAttr_t){ .name="Control", .stack_size=256, .priority=osPriorityAboveNormal });
 //  osThreadNew(SineGenTask, NULL, &(osThreadAttr_t){ .name="SineGen", .stack_size=256, .priority=osPriorityNormal    });
-  osThreadNew(LEDUITask,   NULL, &(osThreadAttr_t){ .name="LEDUI",   .stack_size=256, .priority=osPriorityLow       });
+  osThreadNew(LEDUITask,   NULL, &(osThreadAttr_t){ .name="LEDUI",   .stack_size=1024, .priority=osPriorityLow       });
   /* USER CODE END RTOS_THREADS */
 
   /* USER CODE BEGIN RTOS_EVENTS */
@@ -25,6 +25,8 @@
 /* USER CODE BEGIN Includes */
 #include "stm324xg_eval.h"
 #include "stm324xg_eval_lcd.h"
+#include "app.h"
+#include "crash.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -75,11 +77,15 @@ int main(void)
 
   /* USER CODE BEGIN SysInit */
 
+  /* Backup SRAM: post-mortem record from the previous run, live trace */
+  Crash_Init();
+
   /* Configure LED1 and LED3 */
   BSP_LED_Init(LED1);
   BSP_LED_Init(LED3);
 
   /*LCD Initialization */
+  LCD_DMA_Init();                   /* GRAM fills/blits by DMA2 */
   BSP_LCD_Init();                   /* Initialize the LCD */
   BSP_LCD_DisplayOn();              /* Enable the LCD */
   BSP_LCD_Clear(LCD_COLOR_BLACK);   /* Clear the LCD Background layer */
@@ -92,6 +98,7 @@ int main(void)
   MX_USART3_UART_Init();
 
   /* USER CODE BEGIN 2 */
+  Crash_ReportPending();
 //  CommsInit();
   /* USER CODE END 2 */
 
@@ -196,9 +203,8 @@ void Error_Handler(void)
   /* USER CODE BEGIN Error_Handler_Debug */
   /* User can add his own implementation to report the HAL error return state */
   __disable_irq();
-  while (1)
-  {
-  }
+  Crash_CaptureError((uint32_t)__builtin_return_address(0));
+  Crash_Reboot();
   /* USER CODE END Error_Handler_Debug */
 }
 
@@ -80,7 +80,6 @@ LCD_DrvTypeDef   ili9325_drv =
   ili9325_DrawRGBImage,  
 };
 
-static uint16_t ArrayRGB[320] = {0};
 /**
   * @}
   */ 
@@ -366,8 +365,6 @@ void ili9325_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint
   */
 void ili9325_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  uint16_t counter = 0;
-  
   /* Set Cursor */
   ili9325_SetCursor(Xpos, Ypos); 
   
@@ -375,12 +372,7 @@ void ili9325_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t
   LCD_IO_WriteReg(LCD_REG_34);
 
   /* Sent a complete line */
-  for(counter = 0; counter < Length; counter++)
-  {
-    ArrayRGB[counter] = RGBCode;
-  }  
-
-  LCD_IO_WriteMultipleData((uint8_t*)&ArrayRGB[0], Length * 2);
+  LCD_IO_FillData(RGBCode, Length);
 }
 
 /**
@@ -393,8 +385,6 @@ void ili9325_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t
   */
 void ili9325_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length)
 {
-  uint16_t counter = 0;
-
   /* set GRAM write direction and BGR = 1 */
   /* I/D=00 (Horizontal : increment, Vertical : decrement) */
   /* AM=1 (address is updated in vertical writing direction) */
@@ -407,13 +397,7 @@ void ili9325_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t
   LCD_IO_WriteReg(LCD_REG_34);
 
   /* Fill a complete vertical line */
-  for(counter = 0; counter < Length; counter++)
-  {
-    ArrayRGB[counter] = RGBCode;
-  }
-  
-  /* Write 16-bit GRAM Reg */
-  LCD_IO_WriteMultipleData((uint8_t*)&ArrayRGB[0], Length * 2);
+  LCD_IO_FillData(RGBCode, Length);
   
   /* set GRAM write direction and BGR = 1 */
   /* I/D=00 (Horizontal : increment, Vertical : decrement) */
@@ -482,6 +466,28 @@ void ili9325_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t
   LCD_IO_WriteMultipleData((uint8_t*)pdata, size*2);
 }
 
+/**
+  * @brief  Fills a rectangle with one color.
+  * @note   The caller sets the display window to the rectangle first, so the
+  *         GRAM address wraps at the rectangle edge.
+  * @param  RGBCode: Fill color
+  * @param  Xpos: Rectangle X position in the LCD
+  * @param  Ypos: Rectangle Y position in the LCD
+  * @param  Xsize: Rectangle width
+  * @param  Ysize: Rectangle height
+  * @retval None
+  */
+void ili9325_FillRect(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize)
+{
+  /* Set Cursor */
+  ili9325_SetCursor(Xpos, Ypos);
+  
+  /* Prepare to write GRAM */
+  LCD_IO_WriteReg(LCD_REG_34);
+  
+  LCD_IO_FillData(RGBCode, (uint32_t)Xsize * Ysize);
+}
+
 /**
   * @}
   */ 
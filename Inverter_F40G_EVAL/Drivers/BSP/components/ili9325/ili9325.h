@@ -198,6 +198,7 @@ void     ili9325_DrawHLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint1
 void     ili9325_DrawVLine(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Length);
 void     ili9325_DrawBitmap(uint16_t Xpos, uint16_t Ypos, uint8_t *pbmp);
 void     ili9325_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize, uint8_t *pdata);
+void     ili9325_FillRect(uint16_t RGBCode, uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t Ysize);
 
 void     ili9325_SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height);
 
@@ -211,6 +212,8 @@ extern LCD_DrvTypeDef   ili9325_drv;
 /* LCD IO functions */
 void     LCD_IO_Init(void);
 void     LCD_IO_WriteMultipleData(uint8_t *pData, uint32_t Size);
+void     LCD_IO_FillData(uint16_t Data, uint32_t Count);
+uint8_t  LCD_IO_DMA_Write(volatile uint16_t *pDst, const uint16_t *pSrc, uint32_t Count, uint8_t Increment);
 void     LCD_IO_WriteReg(uint8_t Reg);
 uint16_t LCD_IO_ReadData(uint16_t Reg);
 
@@ -74,6 +74,9 @@ typedef struct
 
 #define I2C_TIMEOUT  100 /*<! Value of Timeout when I2C communication fails */
 
+/* GRAM transfers shorter than this stay on the CPU (DMA setup would cost more) */
+#define LCD_IO_DMA_MIN_WORDS  64
+
 /**
   * @}
   */ 
@@ -156,6 +159,8 @@ uint16_t        IOE_ReadMultiple(uint8_t Addr, uint8_t Reg, uint8_t *Buffer, uin
 void            LCD_IO_Init(void);
 void            LCD_IO_WriteData(uint16_t Data); 
 void            LCD_IO_WriteMultipleData(uint8_t *pData, uint32_t Size);
+void            LCD_IO_FillData(uint16_t Data, uint32_t Count);
+uint8_t         LCD_IO_DMA_Write(__IO uint16_t *pDst, const uint16_t *pSrc, uint32_t Count, uint8_t Increment);
 void            LCD_IO_WriteReg(uint8_t Reg);
 uint16_t        LCD_IO_ReadData(uint16_t Reg);
 
@@ -886,6 +891,12 @@ void LCD_IO_WriteMultipleData(uint8_t *pData, uint32_t Size)
   uint32_t counter;
   uint16_t *ptr = (uint16_t *) pData;
   
+  if((Size / 2 >= LCD_IO_DMA_MIN_WORDS) &&
+     LCD_IO_DMA_Write(&FMC_BANK3->RAM, ptr, Size / 2, 1))
+  {
+    return;
+  }
+  
   for (counter = 0; counter < Size; counter+=2)
   {  
     /* Write 16-bit Reg */
@@ -894,6 +905,44 @@ void LCD_IO_WriteMultipleData(uint8_t *pData, uint32_t Size)
   }
 }
 
+/**
+  * @brief  Writes the same value Count times to the LCD data register.
+  * @param  Data: 16-bit value (usually an RGB565 color)
+  * @param  Count: Number of writes
+  */
+void LCD_IO_FillData(uint16_t Data, uint32_t Count)
+{
+  if((Count >= LCD_IO_DMA_MIN_WORDS) &&
+     LCD_IO_DMA_Write(&FMC_BANK3->RAM, &Data, Count, 0))
+  {
+    return;
+  }
+  
+  while(Count--)
+  {
+    FSMC_BANK3_WriteData(Data);
+  }
+}
+
+/**
+  * @brief  Moves a block of 16-bit words to the LCD data register by DMA.
+  * @note   This weak stub reports "not handled" so the CPU loop is used.
+  *         The application may override it with a DMA engine.
+  * @param  pDst: LCD data register
+  * @param  pSrc: Source words (a single word when Increment is 0)
+  * @param  Count: Number of 16-bit words
+  * @param  Increment: 1 to step through pSrc, 0 to repeat *pSrc
+  * @retval 1 if the data was written, 0 to fall back to CPU writes
+  */
+__weak uint8_t LCD_IO_DMA_Write(__IO uint16_t *pDst, const uint16_t *pSrc, uint32_t Count, uint8_t Increment)
+{
+  (void)pDst;
+  (void)pSrc;
+  (void)Count;
+  (void)Increment;
+  return 0;
+}
+
 /**
   * @brief  Writes register on LCD register.
   * @param  Reg: Register to be written
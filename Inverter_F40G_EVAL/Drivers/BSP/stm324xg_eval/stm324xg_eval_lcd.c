@@ -45,11 +45,17 @@
 /* Includes ------------------------------------------------------------------*/
 #include "stm324xg_eval_lcd.h"
 #include "../../../Utilities/Fonts/fonts.h"
+/* Fonts are run-length packed by Tools/fontpack.py; define LCD_RAW_FONTS to
+   link the original bitmap tables instead */
+#if defined(LCD_RAW_FONTS)
 #include "../../../Utilities/Fonts/font24.c"
 #include "../../../Utilities/Fonts/font20.c"
 #include "../../../Utilities/Fonts/font16.c"
 #include "../../../Utilities/Fonts/font12.c"
 #include "../../../Utilities/Fonts/font8.c"
+#else
+#include "../../../Utilities/Fonts/font_packed.c"
+#endif
 
 /** @addtogroup BSP
   * @{
@@ -68,10 +74,34 @@
   */
 #define POLY_X(Z)              ((int32_t)((Points + (Z))->X))
 #define POLY_Y(Z)              ((int32_t)((Points + (Z))->Y))
+#define LCD_GLYPH_MAX_WIDTH    24   /* widest glyph row the fonts can encode (3 bytes) */
+#define GLYPH_TOKEN_BLANK      0x80 /* 1nnnnnnn: n blank rows */
+#define GLYPH_TOKEN_REPEAT     0x40 /* 01nnnnnn: previous row n more times */
+#define GLYPH_TOKEN_LITERAL    0x00 /* 00nnnnnn: n bit-packed rows follow */
 /**
   * @}
   */ 
 
+/** @defgroup STM324xG_EVAL_LCD_Private_Types STM324xG EVAL LCD Private Types
+  * @{
+  */
+/* Walks a glyph row by row, from a raw bitmap or a packed stream */
+typedef struct
+{
+  const uint8_t *pdata;   /* next table byte */
+  uint32_t row;           /* last row returned */
+  uint32_t acc;           /* literal bit accumulator */
+  uint8_t  nbits;         /* valid bits in acc */
+  uint8_t  run;           /* rows left in the current token */
+  uint8_t  mode;          /* current token */
+  uint8_t  packed;
+  uint16_t width;
+  uint16_t bytes;         /* raw bytes per row */
+} GlyphReaderTypeDef;
+/**
+  * @}
+  */
+
 /** @defgroup STM324xG_EVAL_LCD_Private_Macros STM324xG EVAL LCD Private Macros
   * @{
   */
@@ -85,6 +115,7 @@
   */ 
 LCD_DrawPropTypeDef DrawProp;
 static LCD_DrvTypeDef  *lcd_drv; 
+static uint16_t GlyphLine[LCD_GLYPH_MAX_WIDTH];
 /**
   * @}
   */ 
@@ -93,7 +124,11 @@ static LCD_DrvTypeDef  *lcd_drv;
   * @{
   */ 
 static void DrawChar(uint16_t Xpos, uint16_t Ypos, const uint8_t *c);
+static const uint8_t *GlyphData(uint8_t Ascii);
+static void GlyphReader_Init(GlyphReaderTypeDef *reader, const uint8_t *c);
+static uint32_t GlyphReader_NextRow(GlyphReaderTypeDef *reader);
 static void SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height);
+static void FillArea(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height, uint16_t Color);
 static void FillTriangle(uint16_t x1, uint16_t x2, uint16_t x3, uint16_t y1, uint16_t y2, uint16_t y3);
 /**
   * @}
@@ -210,16 +245,7 @@ sFONT *BSP_LCD_GetFont(void)
   */
 void BSP_LCD_Clear(uint16_t Color)
 { 
-  uint32_t counter = 0;
-  uint32_t color_backup = DrawProp.TextColor; 
-  DrawProp.TextColor = Color;
-  
-  for(counter = 0; counter < BSP_LCD_GetYSize(); counter++)
-  {
-    BSP_LCD_DrawHLine(0, counter, BSP_LCD_GetXSize());
-  }
-  DrawProp.TextColor = color_backup; 
-  BSP_LCD_SetTextColor(DrawProp.TextColor);
+  FillArea(0, 0, BSP_LCD_GetXSize(), BSP_LCD_GetYSize(), Color);
 }
 
 /**
@@ -251,8 +277,7 @@ void BSP_LCD_ClearStringLine(uint16_t Line)
   */
 void BSP_LCD_DisplayChar(uint16_t Xpos, uint16_t Ypos, uint8_t Ascii)
 {
-  DrawChar(Xpos, Ypos, &DrawProp.pFont->table[(Ascii-' ') *\
-    DrawProp.pFont->Height * ((DrawProp.pFont->Width + 7) / 8)]);
+  DrawChar(Xpos, Ypos, GlyphData(Ascii));
 }
 
 /**
@@ -663,12 +688,28 @@ void BSP_LCD_DrawRGBImage(uint16_t Xpos, uint16_t Ypos, uint16_t Xsize, uint16_t
   */
 void BSP_LCD_FillRect(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height)
 {
-  BSP_LCD_SetTextColor(DrawProp.TextColor);
-  do
+  uint32_t xsize = BSP_LCD_GetXSize();
+  uint32_t ysize = BSP_LCD_GetYSize();
+  
+  if((Xpos >= xsize) || (Ypos >= ysize))
+  {
+    return;
+  }
+  
+  /* Height + 1 rows are painted, as the original line-by-line loop did */
+  Height++;
+  
+  /* Clip to the screen */
+  if(Xpos + Width > xsize)
+  {
+    Width = xsize - Xpos;
+  }
+  if(Ypos + Height > ysize)
   {
-    BSP_LCD_DrawHLine(Xpos, Ypos++, Width);    
+    Height = ysize - Ypos;
   }
-  while(Height--);
+  
+  FillArea(Xpos, Ypos, Width, Height, DrawProp.TextColor);
 }
 
 /**
@@ -839,47 +880,135 @@ void BSP_LCD_DisplayOff(void)
 *******************************************************************************/
 
 /**
-  * @brief  Draws a character on LCD.
+  * @brief  Finds the data of a character in the current font.
+  * @param  Ascii: Character ascii code (0x20..0x7E)
+  * @retval Pointer to the raw bitmap or to the packed stream of the glyph
+  */
+static const uint8_t *GlyphData(uint8_t Ascii)
+{
+  sFONT *font = DrawProp.pFont;
+  
+  if(font->Packed != NULL)
+  {
+    return &font->table[font->Packed[Ascii - ' ']];
+  }
+  return &font->table[(Ascii - ' ') * font->Height * ((font->Width + 7) / 8)];
+}
+
+/**
+  * @brief  Prepares to read a glyph of the current font row by row.
+  * @param  reader: Reader state
+  * @param  c: Pointer to the character data (see GlyphData())
+  */
+static void GlyphReader_Init(GlyphReaderTypeDef *reader, const uint8_t *c)
+{
+  reader->pdata  = c;
+  reader->row    = 0;
+  reader->acc    = 0;
+  reader->nbits  = 0;
+  reader->run    = 0;
+  reader->mode   = GLYPH_TOKEN_BLANK;
+  reader->packed = (DrawProp.pFont->Packed != NULL);
+  reader->width  = DrawProp.pFont->Width;
+  reader->bytes  = (reader->width + 7) / 8;
+}
+
+/**
+  * @brief  Returns the next glyph row.
+  * @note   Packed streams are decoded as described in Tools/fontpack.py.
+  * @param  reader: Reader state
+  * @retval Row bits, right-aligned: bit (Width - 1) is the leftmost pixel
+  */
+static uint32_t GlyphReader_NextRow(GlyphReaderTypeDef *reader)
+{
+  uint8_t token;
+  
+  if(!reader->packed)
+  {
+    const uint8_t *p = reader->pdata;
+    uint32_t line;
+    
+    switch(reader->bytes)
+    {
+    case 1:
+      line = p[0];
+      break;
+    case 2:
+      line = (p[0]<< 8) | p[1];
+      break;
+    case 3:
+    default:
+      line = (p[0]<< 16) | (p[1]<< 8) | p[2];
+      break;
+    }
+    reader->pdata += reader->bytes;
+    return line >> (8 * reader->bytes - reader->width);
+  }
+  
+  if(reader->run == 0)
+  {
+    token = *reader->pdata++;
+    if(token & GLYPH_TOKEN_BLANK)
+    {
+      reader->mode = GLYPH_TOKEN_BLANK;
+      reader->run  = token & 0x7F;
+    }
+    else
+    {
+      reader->mode  = token & GLYPH_TOKEN_REPEAT;
+      reader->run   = token & 0x3F;
+      reader->nbits = 0;
+    }
+  }
+  reader->run--;
+  
+  switch(reader->mode)
+  {
+  case GLYPH_TOKEN_BLANK:
+    reader->row = 0;
+    break;
+    
+  case GLYPH_TOKEN_REPEAT:
+    break;
+    
+  default:
+    while(reader->nbits < reader->width)
+    {
+      reader->acc = (reader->acc << 8) | *reader->pdata++;
+      reader->nbits += 8;
+    }
+    reader->nbits -= reader->width;
+    reader->row = (reader->acc >> reader->nbits) & ((1UL << reader->width) - 1);
+    break;
+  }
+  return reader->row;
+}
+
+/**
+  * @brief  Draws a character pixel by pixel (used when the glyph is clipped).
   * @param  Xpos: Line where to display the character shape
   * @param  Ypos: Start column address
   * @param  c: Pointer to the character data
   */
-static void DrawChar(uint16_t Xpos, uint16_t Ypos, const uint8_t *c)
+static void DrawCharPixels(uint16_t Xpos, uint16_t Ypos, const uint8_t *c)
 {
   uint32_t i = 0, j = 0;
   uint16_t height, width;
-  uint8_t offset;
-  uint8_t *pchar;
   uint32_t line;
+  GlyphReaderTypeDef reader;
   
   height = DrawProp.pFont->Height;
   width  = DrawProp.pFont->Width;
   
-  offset =  8 *((width + 7)/8) -  width ;
+  GlyphReader_Init(&reader, c);
   
   for(i = 0; i < height; i++)
   {
-    pchar = ((uint8_t *)c + (width + 7)/8 * i);
-    
-    switch(((width + 7)/8))
-    {
-    case 1:
-      line =  pchar[0];
-      break;    
-
-    case 2:
-      line =  (pchar[0]<< 8) | pchar[1];
-      break;
-      
-    case 3:
-    default:
-      line =  (pchar[0]<< 16) | (pchar[1]<< 8) | pchar[2];
-      break;
-    }  
+    line = GlyphReader_NextRow(&reader);
     
     for (j = 0; j < width; j++)
     {
-      if(line & (1 << (width- j + offset- 1))) 
+      if(line & (1UL << (width - j - 1))) 
       {
         BSP_LCD_DrawPixel((Xpos + j), Ypos, DrawProp.TextColor);
       }
@@ -892,6 +1021,61 @@ static void DrawChar(uint16_t Xpos, uint16_t Ypos, const uint8_t *c)
   }
 }
 
+/**
+  * @brief  Draws a character on LCD.
+  * @note   The display window is set to the glyph cell once, then each row is
+  *         decoded, expanded into a line buffer and streamed to GRAM in one
+  *         burst, so the controller auto-increments the address instead of
+  *         taking a cursor update per pixel (about 6x fewer FSMC writes for
+  *         Font24).
+  * @param  Xpos: Line where to display the character shape
+  * @param  Ypos: Start column address
+  * @param  c: Pointer to the character data
+  */
+static void DrawChar(uint16_t Xpos, uint16_t Ypos, const uint8_t *c)
+{
+  uint32_t i = 0, j = 0;
+  uint16_t height, width;
+  uint32_t mask;
+  uint32_t line;
+  GlyphReaderTypeDef reader;
+  
+  height = DrawProp.pFont->Height;
+  width  = DrawProp.pFont->Width;
+  
+  /* Clipped glyphs, unknown fonts or drivers without windowing take the slow path */
+  if((width > LCD_GLYPH_MAX_WIDTH) ||
+     ((Xpos + width) > BSP_LCD_GetXSize()) || ((Ypos + height) > BSP_LCD_GetYSize()) ||
+     (lcd_drv->SetDisplayWindow == NULL) || (lcd_drv->SetCursor == NULL))
+  {
+    DrawCharPixels(Xpos, Ypos, c);
+    return;
+  }
+  
+  SetDisplayWindow(Xpos, Ypos, width, height);
+  lcd_drv->SetCursor(Xpos, Ypos);
+  
+  /* Prepare to write GRAM */
+  LCD_IO_WriteReg(LCD_REG_34);
+  
+  GlyphReader_Init(&reader, c);
+  
+  for(i = 0; i < height; i++)
+  {
+    line = GlyphReader_NextRow(&reader);
+    mask = 1UL << (width - 1);
+    
+    for (j = 0; j < width; j++)
+    {
+      GlyphLine[j] = (line & mask) ? DrawProp.TextColor : DrawProp.BackColor;
+      mask >>= 1;
+    }
+    LCD_IO_WriteMultipleData((uint8_t *)GlyphLine, width * 2);
+  }
+  
+  SetDisplayWindow(0, 0, BSP_LCD_GetXSize(), BSP_LCD_GetYSize());
+}
+
 /**
   * @brief  Sets display window.
   * @param  Xpos: LCD X position
@@ -907,6 +1091,41 @@ static void SetDisplayWindow(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint1
   }  
 }
 
+/**
+  * @brief  Fills a rectangle that lies inside the screen.
+  * @note   On the ILI9325 the window is set to the rectangle and the whole area
+  *         is streamed as one fill (DMA when the application provides it).
+  * @param  Xpos: X position
+  * @param  Ypos: Y position
+  * @param  Width: Rectangle width
+  * @param  Height: Rectangle height
+  * @param  Color: Fill color
+  */
+static void FillArea(uint16_t Xpos, uint16_t Ypos, uint16_t Width, uint16_t Height, uint16_t Color)
+{
+  uint32_t color_backup = DrawProp.TextColor;
+  
+  if((Width == 0) || (Height == 0))
+  {
+    return;
+  }
+  
+  if(lcd_drv == &ili9325_drv)
+  {
+    SetDisplayWindow(Xpos, Ypos, Width, Height);
+    ili9325_FillRect(Color, Xpos, Ypos, Width, Height);
+    SetDisplayWindow(0, 0, BSP_LCD_GetXSize(), BSP_LCD_GetYSize());
+    return;
+  }
+  
+  DrawProp.TextColor = Color;
+  while(Height--)
+  {
+    BSP_LCD_DrawHLine(Xpos, Ypos++, Width);
+  }
+  DrawProp.TextColor = color_backup;
+}
+
 /**
   * @brief  Fills a triangle (between 3 points).
   * @param  x1: Point 1 X position
@@ -0,0 +1,215 @@
+#!/usr/bin/env python3
+"""
+Decoder for the post-mortem record dumped by App/crash.c.
+
+On the boot after a crash the eval board prints, on USART3 (115200 8N1):
+
+    === CRASH RECORD v1 reason 2 task 'LEDUI' ===
+    C:435253480100....
+    ...
+    === END ===
+
+Save the terminal output to a file (or pipe it in) and run:
+
+    python3 Tools/crash_decode.py capture.log
+    python3 Tools/crash_decode.py capture.log --elf Debug/InverterEval.elf
+
+With --elf, code addresses are resolved with arm-none-eabi-addr2line.
+
+The layout below must match CrashRecord_t in App/crash.h (CRASH_VERSION).
+"""
+
+import argparse
+import re
+import shutil
+import struct
+import subprocess
+import sys
+import zlib
+
+CRASH_MAGIC   = 0x48535243
+CRASH_VERSION = 1
+TRACE_LEN     = 32
+STACK_WORDS   = 32
+TASK_LEN      = 16
+FILE_LEN      = 64
+
+HEADER_FMT = "<IHHIII8IIIIIIII%ds%dsI" % (TASK_LEN, FILE_LEN)
+TRACE_FMT  = "<IIB3x"
+TAIL_FMT   = "<II%dI" % STACK_WORDS
+
+REASONS = {0: "none", 1: "assert", 2: "HardFault", 3: "Error_Handler"}
+EVENTS  = {0: "none", 1: "task in", 2: "queue full"}
+
+CFSR_BITS = [
+    (0,  "IACCVIOL  instruction access violation (MPU/XN)"),
+    (1,  "DACCVIOL  data access violation (MPU)"),
+    (3,  "MUNSTKERR fault on exception return unstacking"),
+    (4,  "MSTKERR   fault on exception entry stacking"),
+    (5,  "MLSPERR   fault during lazy FP stacking"),
+    (7,  "MMARVALID MMFAR holds the faulting address"),
+    (8,  "IBUSERR   instruction bus error"),
+    (9,  "PRECISERR precise data bus error"),
+    (10, "IMPRECISERR imprecise data bus error"),
+    (11, "UNSTKERR  bus fault on unstacking"),
+    (12, "STKERR    bus fault on stacking (stack overflow?)"),
+    (13, "LSPERR    bus fault during lazy FP stacking"),
+    (15, "BFARVALID BFAR holds the faulting address"),
+    (16, "UNDEFINSTR undefined instruction"),
+    (17, "INVSTATE  invalid EPSR state (Thumb bit clear, bad function pointer?)"),
+    (18, "INVPC     invalid EXC_RETURN"),
+    (19, "NOCP      coprocessor access (FPU disabled?)"),
+    (24, "UNALIGNED unaligned access"),
+    (25, "DIVBYZERO divide by zero"),
+]
+HFSR_BITS = [
+    (1,  "VECTTBL   vector table read fault"),
+    (30, "FORCED    escalated from a configurable fault"),
+    (31, "DEBUGEVT  debug event"),
+]
+
+
+def extract(text):
+    """Returns the raw record bytes from the last dump in the text."""
+    blocks = re.findall(r"=== CRASH RECORD.*?===(.*?)=== END ===", text, re.S)
+    if not blocks:
+        sys.exit("no crash record found in the input")
+    hexdata = "".join(re.findall(r"^C:([0-9A-Fa-f]+)\s*$", blocks[-1], re.M))
+    return bytes.fromhex(hexdata)
+
+
+def cstr(b):
+    return b.split(b"\0", 1)[0].decode("ascii", "replace")
+
+
+def parse(raw):
+    hsize = struct.calcsize(HEADER_FMT)
+    tsize = struct.calcsize(TRACE_FMT)
+    size  = hsize + TRACE_LEN * tsize + struct.calcsize(TAIL_FMT) + 4
+
+    if len(raw) < size:
+        sys.exit("record too short: %d bytes, expected %d" % (len(raw), size))
+
+    h = struct.unpack_from(HEADER_FMT, raw, 0)
+    rec = {
+        "magic": h[0], "version": h[1], "size": h[2], "reason": h[3],
+        "reported": h[4], "tick": h[5], "frame": list(h[6:14]),
+        "exc_return": h[14], "sp": h[15],
+        "cfsr": h[16], "hfsr": h[17], "mmfar": h[18], "bfar": h[19],
+        "line": h[20], "task": cstr(h[21]), "file": cstr(h[22]),
+        "trace_count": h[23],
+    }
+    if rec["magic"] != CRASH_MAGIC:
+        sys.exit("bad magic 0x%08X" % rec["magic"])
+    if rec["version"] != CRASH_VERSION or rec["size"] != size:
+        sys.exit("record v%d / %d bytes, this decoder handles v%d / %d bytes"
+                 % (rec["version"], rec["size"], CRASH_VERSION, size))
+
+    off = hsize
+    rec["trace"] = []
+    for i in range(TRACE_LEN):
+        cyc, arg, ev = struct.unpack_from(TRACE_FMT, raw, off)
+        if i < rec["trace_count"]:
+            rec["trace"].append((cyc, arg, ev))
+        off += tsize
+
+    t = struct.unpack_from(TAIL_FMT, raw, off)
+    rec["stack_addr"], rec["stack_words"] = t[0], t[1]
+    rec["stack"] = list(t[2:2 + min(t[1], STACK_WORDS)])
+    off += struct.calcsize(TAIL_FMT)
+
+    (crc,) = struct.unpack_from("<I", raw, off)
+    # the firmware recomputes the CRC after setting 'reported'
+    rec["crc_ok"] = (zlib.crc32(raw[:off]) & 0xFFFFFFFF) == crc
+    return rec
+
+
+class Symbols:
+    def __init__(self, elf):
+        self.elf  = elf
+        self.tool = shutil.which("arm-none-eabi-addr2line") if elf else None
+        if elf and not self.tool:
+            print("note: arm-none-eabi-addr2line not found, addresses stay raw\n")
+
+    def __call__(self, addr):
+        if not self.tool or not (0x08000000 <= addr < 0x08100000):
+            return ""
+        out = subprocess.run([self.tool, "-f", "-C", "-s", "-e", self.elf, "0x%x" % (addr & ~1)],
+                             capture_output=True, text=True).stdout.split("\n")
+        if len(out) >= 2 and out[0] != "??":
+            return "  %s (%s)" % (out[0], out[1])
+        return ""
+
+
+def bits(value, table):
+    return [name for bit, name in table if value & (1 << bit)]
+
+
+def report(rec, sym):
+    frame = rec["frame"]
+    print("Crash record v%d, CRC %s%s" % (rec["version"], "ok" if rec["crc_ok"] else "BAD",
+                                          ", already reported" if rec["reported"] else ""))
+    print("  reason   %s" % REASONS.get(rec["reason"], "unknown (%d)" % rec["reason"]))
+    print("  uptime   %.3f s" % (rec["tick"] / 1000.0))
+    print("  task     %s" % (rec["task"] or "(scheduler not running)"))
+    if rec["file"]:
+        print("  assert   %s:%d" % (rec["file"], rec["line"]))
+
+    print("\nRegisters")
+    for name, value in zip(["r0", "r1", "r2", "r3", "r12", "lr", "pc", "xpsr"], frame):
+        extra = sym(value) if name in ("lr", "pc") else ""
+        print("  %-4s 0x%08X%s" % (name, value, extra))
+    print("  sp   0x%08X" % rec["sp"])
+
+    if rec["exc_return"]:
+        er = rec["exc_return"]
+        stack = "PSP (task)" if er & 4 else "MSP (handler/startup)"
+        print("  exc_return 0x%08X: stacked on %s, %s frame"
+              % (er, stack, "basic" if er & 0x10 else "FPU"))
+        ipsr = frame[7] & 0x1FF
+        if ipsr:
+            print("  faulted inside exception %d%s" % (ipsr, " (IRQ%d)" % (ipsr - 16) if ipsr >= 16 else ""))
+
+    print("\nFault status")
+    print("  CFSR 0x%08X  HFSR 0x%08X" % (rec["cfsr"], rec["hfsr"]))
+    for name in bits(rec["cfsr"], CFSR_BITS) + bits(rec["hfsr"], HFSR_BITS):
+        print("    " + name)
+    if rec["cfsr"] & (1 << 7):
+        print("  MMFAR 0x%08X" % rec["mmfar"])
+    if rec["cfsr"] & (1 << 15):
+        print("  BFAR  0x%08X" % rec["bfar"])
+
+    print("\nTrace (oldest first, cycles relative to the last event)")
+    if rec["trace"]:
+        last = rec["trace"][-1][0]
+        for cyc, arg, ev in rec["trace"]:
+            dt = (cyc - last) & 0xFFFFFFFF
+            if dt & 0x80000000:
+                dt -= 1 << 32
+            if ev == 1:
+                what = "task in   %s" % arg.to_bytes(4, "little").split(b"\0", 1)[0].decode("ascii", "replace")
+            elif ev >= 0x80:
+                what = "user 0x%02X arg 0x%08X" % (ev, arg)
+            else:
+                what = "%-9s 0x%08X" % (EVENTS.get(ev, "ev %d" % ev), arg)
+            print("  %12d  %s" % (dt, what))
+    else:
+        print("  (empty)")
+
+    print("\nStack from 0x%08X" % rec["stack_addr"])
+    for i, w in enumerate(rec["stack"]):
+        print("  0x%08X: 0x%08X%s" % (rec["stack_addr"] + 4 * i, w, sym(w)))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Decode an eval-board crash dump.")
+    ap.add_argument("log", nargs="?", help="terminal capture (default: stdin)")
+    ap.add_argument("--elf", help="firmware ELF for symbol lookup")
+    args = ap.parse_args()
+
+    text = open(args.log, errors="replace").read() if args.log else sys.stdin.read()
+    report(parse(extract(text)), Symbols(args.elf))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,286 @@
+#!/usr/bin/env python3
+"""
+Font packer for the eval LCD.
+
+Reads the bitmap tables in Utilities/Fonts/font*.c, run-length packs every
+glyph and writes Utilities/Fonts/font_packed.c, which the LCD driver includes
+instead of the raw tables (see LCD_RAW_FONTS in stm324xg_eval_lcd.c).
+
+Glyph stream (one per character, rows top to bottom), token byte first:
+
+    1nnnnnnn        n blank rows                    (n = 1..127)
+    01nnnnnn        repeat the previous row n times (n = 1..63)
+    00nnnnnn        n literal rows follow, Width bits each, MSB first,
+                    packed back to back and padded to a byte at the end
+
+Each packed font also gets a table of 95 uint16 offsets (' '..'~') into its
+stream. A font that would shrink by less than MIN_SAVING stays raw.
+
+Every glyph is decoded again with the same algorithm as the C decoder and
+compared pixel by pixel with the source table; any mismatch aborts.
+
+Usage:
+    python3 Tools/fontpack.py            # check, report, write font_packed.c
+    python3 Tools/fontpack.py --check    # check and report only
+"""
+
+import argparse
+import os
+import re
+import sys
+
+HERE      = os.path.dirname(os.path.abspath(__file__))
+FONT_DIR  = os.path.join(HERE, "..", "Utilities", "Fonts")
+FONTS     = ["font24", "font20", "font16", "font12", "font8"]
+OUT_FILE  = "font_packed.c"
+
+FIRST_CHAR = 0x20
+NUM_GLYPHS = 95
+
+BLANK_MAX  = 127
+REPEAT_MAX = 63
+LIT_MAX    = 63
+
+# Keep a font raw unless packing saves at least this fraction; small fonts
+# barely shrink and would only pay the decode cost.
+MIN_SAVING = 0.10
+
+# Rough Cortex-M4 cost model for the decoder, in CPU cycles (zero-wait flash
+# via the ART accelerator). Only used for the report.
+CYC_TOKEN  = 12     # fetch + decode one token byte
+CYC_ROW    = 6      # hand back one row from a blank/repeat run
+CYC_BYTE   = 4      # shift one literal byte into the bit accumulator
+CYC_LROW   = 8      # extract one literal row
+CYC_RAWROW = 10     # raw table: assemble one row from 1..3 bytes
+
+
+class Font:
+    def __init__(self, name, data, width, height):
+        self.name   = name
+        self.data   = data
+        self.width  = width
+        self.height = height
+        self.bpr    = (width + 7) // 8
+
+    def rows(self, glyph):
+        """Glyph rows as integers, right-aligned, bit (width-1) = leftmost pixel."""
+        out = []
+        shift = 8 * self.bpr - self.width
+        for r in range(self.height):
+            base = (glyph * self.height + r) * self.bpr
+            v = 0
+            for b in range(self.bpr):
+                v = (v << 8) | self.data[base + b]
+            out.append(v >> shift)
+        return out
+
+
+def parse_font(path):
+    text = open(path).read()
+    m = re.search(r"_Table\s*\[\]\s*=\s*\{(.*?)\};", text, re.S)
+    if not m:
+        sys.exit("%s: no font table found" % path)
+    body = re.sub(r"//[^\n]*", "", m.group(1))
+    data = [int(x, 16) for x in re.findall(r"0x[0-9A-Fa-f]{2}", body)]
+    width  = int(re.search(r"(\d+),\s*/\*\s*Width", text).group(1))
+    height = int(re.search(r"(\d+),\s*/\*\s*Height", text).group(1))
+    name   = re.search(r"sFONT\s+(\w+)\s*=", text).group(1)
+
+    font = Font(name, data, width, height)
+    if len(data) != NUM_GLYPHS * height * font.bpr:
+        sys.exit("%s: expected %d bytes, found %d"
+                 % (path, NUM_GLYPHS * height * font.bpr, len(data)))
+    return font
+
+
+def encode(rows, width):
+    out  = []
+    prev = None
+    i    = 0
+    while i < len(rows):
+        r = rows[i]
+        if r == 0:
+            n = 1
+            while i + n < len(rows) and rows[i + n] == 0 and n < BLANK_MAX:
+                n += 1
+            out.append(0x80 | n)
+            prev = 0
+            i += n
+            continue
+
+        if r == prev:
+            n = 1
+            while i + n < len(rows) and rows[i + n] == prev and n < REPEAT_MAX:
+                n += 1
+            out.append(0x40 | n)
+            i += n
+            continue
+
+        # literal run up to the next blank or repeated row
+        j, p = i, prev
+        while j < len(rows) and j - i < LIT_MAX and rows[j] != 0 and rows[j] != p:
+            p = rows[j]
+            j += 1
+        out.append(j - i)
+        acc, bits = 0, 0
+        for lit in rows[i:j]:
+            acc = (acc << width) | lit
+            bits += width
+        pad = -bits % 8
+        out.extend((acc << pad).to_bytes((bits + pad) // 8, "big"))
+        prev = rows[j - 1]
+        i = j
+    return out
+
+
+def decode(stream, pos, width, height):
+    """Mirror of GlyphReader_NextRow() in stm324xg_eval_lcd.c.
+    Returns (rows, cycles)."""
+    rows   = []
+    row    = 0
+    run    = 0
+    mode   = 0
+    acc    = 0
+    nbits  = 0
+    cycles = 0
+    mask   = (1 << width) - 1
+
+    for _ in range(height):
+        if run == 0:
+            tok = stream[pos]
+            pos += 1
+            cycles += CYC_TOKEN
+            if tok & 0x80:
+                mode, run = 0x80, tok & 0x7F
+            elif tok & 0x40:
+                mode, run = 0x40, tok & 0x3F
+            else:
+                mode, run = 0x00, tok & 0x3F
+                nbits = 0
+            if run == 0:
+                raise ValueError("zero-length run")
+        run -= 1
+
+        if mode == 0x80:
+            row = 0
+            cycles += CYC_ROW
+        elif mode == 0x40:
+            cycles += CYC_ROW
+        else:
+            while nbits < width:
+                acc = ((acc << 8) | stream[pos]) & 0xFFFFFFFF
+                pos += 1
+                nbits += 8
+                cycles += CYC_BYTE
+            nbits -= width
+            row = (acc >> nbits) & mask
+            cycles += CYC_LROW
+        rows.append(row)
+    return rows, cycles
+
+
+def pack_font(font):
+    stream  = []
+    offsets = []
+    cycles  = []
+    for g in range(NUM_GLYPHS):
+        rows = font.rows(g)
+        offsets.append(len(stream))
+        stream.extend(encode(rows, font.width))
+
+        got, cyc = decode(stream, offsets[-1], font.width, font.height)
+        if got != rows:
+            sys.exit("%s '%c': decoded glyph differs from the source table"
+                     % (font.name, chr(FIRST_CHAR + g)))
+        cycles.append(cyc)
+
+    if len(stream) > 0xFFFF:
+        sys.exit("%s: packed stream too large for 16-bit offsets" % font.name)
+    return stream, offsets, cycles
+
+
+def c_bytes(data, indent="  ", per_line=16):
+    lines = []
+    for i in range(0, len(data), per_line):
+        lines.append(indent + ", ".join("0x%02X" % b for b in data[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def c_words(data, indent="  ", per_line=12):
+    lines = []
+    for i in range(0, len(data), per_line):
+        lines.append(indent + ", ".join("%5d" % w for w in data[i:i + per_line]) + ",")
+    return "\n".join(lines)
+
+
+def emit(results):
+    out = []
+    out.append("""/**
+  ******************************************************************************
+  * @file    font_packed.c
+  * @brief   Run-length packed Font24/20/16/12/8 for the eval LCD driver.
+  *          Generated by Tools/fontpack.py from font24.c .. font8.c
+  *          (Copyright (c) 2014 STMicroelectronics). Do not edit.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "fonts.h"
+""")
+    for font, packed, stream, offsets, _ in results:
+        tname = font.name + "_Table"
+        if packed:
+            out.append("static const uint16_t %s_Index[] =\n{\n%s\n};\n"
+                       % (font.name, c_words(offsets)))
+            out.append("const uint8_t %s[] =\n{\n%s\n};\n" % (tname, c_bytes(stream)))
+            index = "%s_Index" % font.name
+        else:
+            out.append("/* raw bitmap, packing would save too little */")
+            out.append("const uint8_t %s[] =\n{\n%s\n};\n" % (tname, c_bytes(font.data)))
+            index = "0"
+        out.append("sFONT %s = {\n  %s,\n  %d, /* Width */\n  %d, /* Height */\n  %s, /* Packed */\n};\n"
+                   % (font.name, tname, font.width, font.height, index))
+
+    path = os.path.join(FONT_DIR, OUT_FILE)
+    with open(path, "w", newline="\n") as f:
+        f.write("\n".join(out))
+    print("wrote %s" % os.path.normpath(path))
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Pack the LCD fonts and verify the round trip.")
+    ap.add_argument("--check", action="store_true", help="verify and report, do not write")
+    args = ap.parse_args()
+
+    results = []
+    raw_total = packed_total = 0
+
+    print("%-7s %5s %5s %8s %8s %7s %10s %10s"
+          % ("font", "w", "h", "raw", "packed", "saved", "cyc/glyph", "raw cyc"))
+    for name in FONTS:
+        font = parse_font(os.path.join(FONT_DIR, name + ".c"))
+        stream, offsets, cycles = pack_font(font)
+
+        raw_size    = len(font.data)
+        packed_size = len(stream) + 2 * len(offsets)
+        packed      = packed_size <= raw_size * (1 - MIN_SAVING)
+        used        = packed_size if packed else raw_size
+
+        raw_total    += raw_size
+        packed_total += used
+        raw_cyc = font.height * CYC_RAWROW
+        print("%-7s %5d %5d %8d %8d %7d %10.0f %10d%s"
+              % (font.name, font.width, font.height, raw_size, used, raw_size - used,
+                 sum(cycles) / len(cycles), raw_cyc, "" if packed else "  (kept raw)"))
+        results.append((font, packed, stream, offsets, cycles))
+
+    print("%-7s %5s %5s %8d %8d %7d" % ("total", "", "", raw_total, packed_total,
+                                        raw_total - packed_total))
+    print("all glyphs decode pixel-exact")
+
+    if not args.check:
+        emit(results)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,591 @@
+/**
+  ******************************************************************************
+  * @file    font_packed.c
+  * @brief   Run-length packed Font24/20/16/12/8 for the eval LCD driver.
+  *          Generated by Tools/fontpack.py from font24.c .. font8.c
+  *          (Copyright (c) 2014 STMicroelectronics). Do not edit.
+  ******************************************************************************
+  */
+
+/* Includes ------------------------------------------------------------------*/
+#include "fonts.h"
+
+static const uint16_t Font24_Index[] =
+{
+      0,     1,    19,    31,    57,    97,   133,   164,   176,   212,   248,   271,
+    288,   306,   313,   320,   368,   395,   415,   450,   484,   521,   552,   586,
+    623,   658,   692,   705,   728,   759,   772,   803,   834,   871,   904,   936,
+    963,   988,  1023,  1059,  1093,  1120,  1137,  1162,  1195,  1217,  1252,  1285,
+   1314,  1343,  1378,  1412,  1446,  1468,  1488,  1521,  1557,  1590,  1618,  1651,
+   1668,  1716,  1733,  1753,  1759,  1771,  1798,  1829,  1856,  1887,  1915,  1941,
+   1973,  2001,  2024,  2050,  2086,  2103,  2121,  2139,  2164,  2193,  2222,  2242,
+   2269,  2294,  2314,  2343,  2371,  2397,  2436,  2462,  2490,  2497,  2525,
+};
+
+const uint8_t Font24_Table[] =
+{
+  0x98, 0x82, 0x01, 0x03, 0x80, 0x00, 0x48, 0x01, 0x01, 0x00, 0x00, 0x41, 0x82, 0x01, 0x03, 0x80,
+  0x00, 0x41, 0x87, 0x83, 0x01, 0x0E, 0x70, 0x00, 0x42, 0x01, 0x04, 0x20, 0x00, 0x43, 0x8E, 0x82,
+  0x01, 0x06, 0x60, 0x00, 0x44, 0x01, 0x3F, 0xF8, 0x00, 0x41, 0x03, 0x06, 0x60, 0x06, 0x60, 0x0F,
+  0xFE, 0x00, 0x41, 0x01, 0x0C, 0xC0, 0x00, 0x44, 0x86, 0x81, 0x01, 0x01, 0x80, 0x00, 0x41, 0x03,
+  0x07, 0xB0, 0x07, 0xF8, 0x06, 0x1C, 0x00, 0x41, 0x0A, 0x1C, 0x00, 0x07, 0xC0, 0x01, 0xF8, 0x00,
+  0x1E, 0x01, 0x83, 0x00, 0xE1, 0x80, 0x71, 0xC0, 0x3F, 0xC0, 0x1B, 0xC0, 0x00, 0xC0, 0x00, 0x43,
+  0x84, 0x82, 0x04, 0x07, 0x80, 0x07, 0xE0, 0x07, 0x38, 0x03, 0x0C, 0x00, 0x41, 0x06, 0x1C, 0xE0,
+  0x07, 0xFC, 0x01, 0xF8, 0x03, 0xFE, 0x00, 0x73, 0x80, 0x30, 0xC0, 0x41, 0x03, 0x07, 0x38, 0x01,
+  0xF8, 0x00, 0x78, 0x00, 0x87, 0x84, 0x04, 0x03, 0xF0, 0x03, 0xF8, 0x03, 0x18, 0x01, 0x80, 0x00,
+  0x41, 0x08, 0x06, 0x00, 0x03, 0x80, 0x03, 0xE7, 0x03, 0xBF, 0x81, 0x8F, 0x00, 0xC3, 0x80, 0x3F,
+  0xF0, 0x0F, 0xB8, 0x87, 0x83, 0x01, 0x03, 0x80, 0x00, 0x42, 0x01, 0x01, 0x00, 0x00, 0x43, 0x8E,
+  0x82, 0x05, 0x00, 0x18, 0x00, 0x1C, 0x00, 0x1C, 0x00, 0x1E, 0x00, 0x0E, 0x00, 0x41, 0x01, 0x01,
+  0xC0, 0x00, 0x45, 0x01, 0x00, 0xE0, 0x00, 0x41, 0x01, 0x00, 0x70, 0x00, 0x41, 0x02, 0x00, 0x38,
+  0x00, 0x0C, 0x00, 0x84, 0x82, 0x03, 0x18, 0x00, 0x0E, 0x00, 0x03, 0x80, 0x00, 0x41, 0x01, 0x07,
+  0x00, 0x00, 0x41, 0x01, 0x03, 0x80, 0x00, 0x45, 0x01, 0x07, 0x00, 0x00, 0x41, 0x04, 0x0F, 0x00,
+  0x07, 0x00, 0x07, 0x00, 0x03, 0x00, 0x00, 0x84, 0x82, 0x01, 0x01, 0x80, 0x00, 0x42, 0x04, 0x1D,
+  0xB8, 0x0F, 0xFC, 0x01, 0xF8, 0x00, 0x78, 0x00, 0x41, 0x01, 0x06, 0x60, 0x00, 0x41, 0x8C, 0x84,
+  0x01, 0x01, 0x80, 0x00, 0x44, 0x01, 0x3F, 0xFC, 0x00, 0x41, 0x01, 0x01, 0x80, 0x00, 0x44, 0x88,
+  0x8E, 0x04, 0x00, 0xE0, 0x00, 0x60, 0x00, 0x70, 0x00, 0x30, 0x00, 0x41, 0x01, 0x03, 0x00, 0x00,
+  0x41, 0x83, 0x89, 0x01, 0x1F, 0xF8, 0x00, 0x41, 0x8D, 0x8E, 0x01, 0x03, 0xC0, 0x00, 0x42, 0x87,
+  0x01, 0x00, 0x18, 0x00, 0x41, 0x04, 0x00, 0x38, 0x00, 0x18, 0x00, 0x1C, 0x00, 0x0C, 0x00, 0x41,
+  0x01, 0x00, 0xC0, 0x00, 0x41, 0x01, 0x01, 0x80, 0x00, 0x41, 0x01, 0x03, 0x00, 0x00, 0x41, 0x01,
+  0x06, 0x00, 0x00, 0x41, 0x04, 0x0E, 0x00, 0x06, 0x00, 0x07, 0x00, 0x03, 0x00, 0x00, 0x41, 0x84,
+  0x82, 0x03, 0x03, 0xC0, 0x03, 0xF0, 0x03, 0x0C, 0x00, 0x41, 0x01, 0x18, 0x18, 0x00, 0x46, 0x01,
+  0x0C, 0x30, 0x00, 0x41, 0x02, 0x07, 0xE0, 0x01, 0xE0, 0x00, 0x87, 0x82, 0x05, 0x00, 0x80, 0x03,
+  0xC0, 0x07, 0xE0, 0x03, 0xB0, 0x00, 0x18, 0x00, 0x48, 0x01, 0x1F, 0xF8, 0x00, 0x41, 0x87, 0x82,
+  0x04, 0x07, 0xC0, 0x0F, 0xF8, 0x0E, 0x0C, 0x06, 0x03, 0x00, 0x41, 0x09, 0x00, 0x18, 0x00, 0x18,
+  0x00, 0x18, 0x00, 0x38, 0x00, 0x38, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x3F, 0xF8, 0x00,
+  0x41, 0x87, 0x82, 0x04, 0x03, 0xC0, 0x07, 0xF0, 0x03, 0x1C, 0x00, 0x06, 0x00, 0x41, 0x05, 0x00,
+  0x60, 0x01, 0xE0, 0x00, 0xF8, 0x00, 0x0E, 0x00, 0x01, 0x80, 0x42, 0x03, 0x18, 0x38, 0x0F, 0xF8,
+  0x03, 0xF0, 0x00, 0x87, 0x82, 0x02, 0x00, 0xE0, 0x00, 0xF0, 0x00, 0x41, 0x02, 0x03, 0x60, 0x03,
+  0x30, 0x00, 0x41, 0x01, 0x0C, 0x60, 0x00, 0x41, 0x03, 0x18, 0x60, 0x18, 0x30, 0x0F, 0xFE, 0x00,
+  0x41, 0x02, 0x00, 0x60, 0x01, 0xFC, 0x00, 0x41, 0x87, 0x82, 0x01, 0x1F, 0xF0, 0x00, 0x41, 0x01,
+  0x18, 0x00, 0x00, 0x42, 0x04, 0x1B, 0xC0, 0x0F, 0xF8, 0x07, 0x0C, 0x00, 0x03, 0x00, 0x43, 0x03,
+  0x30, 0x30, 0x1F, 0xF8, 0x03, 0xF0, 0x00, 0x87, 0x82, 0x0A, 0x00, 0xF8, 0x01, 0xFC, 0x01, 0xC0,
+  0x01, 0xC0, 0x00, 0xC0, 0x00, 0xC0, 0x00, 0x6F, 0x00, 0x3F, 0xE0, 0x1C, 0x30, 0x0C, 0x0C, 0x00,
+  0x42, 0x03, 0x0C, 0x38, 0x07, 0xF8, 0x00, 0xF8, 0x00, 0x87, 0x82, 0x01, 0x1F, 0xF8, 0x00, 0x41,
+  0x03, 0x18, 0x18, 0x0C, 0x1C, 0x00, 0x0C, 0x00, 0x41, 0x02, 0x00, 0x70, 0x00, 0x30, 0x00, 0x41,
+  0x02, 0x00, 0xE0, 0x00, 0x60, 0x00, 0x41, 0x02, 0x01, 0xC0, 0x00, 0xC0, 0x00, 0x41, 0x87, 0x82,
+  0x04, 0x07, 0xE0, 0x07, 0xF8, 0x07, 0x0E, 0x03, 0x03, 0x00, 0x41, 0x02, 0x0C, 0x30, 0x03, 0xF0,
+  0x00, 0x41, 0x02, 0x0C, 0x30, 0x0C, 0x0C, 0x00, 0x42, 0x03, 0x1C, 0x38, 0x07, 0xF8, 0x01, 0xF8,
+  0x00, 0x87, 0x82, 0x04, 0x07, 0xC0, 0x07, 0xF8, 0x07, 0x0C, 0x03, 0x03, 0x00, 0x42, 0x09, 0x0C,
+  0x38, 0x07, 0xFC, 0x00, 0xF6, 0x00, 0x03, 0x00, 0x03, 0x00, 0x03, 0x80, 0x03, 0x80, 0x3F, 0x80,
+  0x1F, 0x00, 0x00, 0x87, 0x86, 0x01, 0x03, 0xC0, 0x00, 0x42, 0x85, 0x01, 0x03, 0xC0, 0x00, 0x42,
+  0x87, 0x86, 0x01, 0x00, 0xF0, 0x00, 0x42, 0x84, 0x03, 0x00, 0xE0, 0x00, 0xE0, 0x00, 0x60, 0x00,
+  0x41, 0x02, 0x03, 0x00, 0x01, 0x00, 0x00, 0x85, 0x84, 0x0D, 0x00, 0x1C, 0x00, 0x1E, 0x00, 0x3C,
+  0x00, 0x78, 0x00, 0xF0, 0x01, 0xE0, 0x03, 0xC0, 0x00, 0x78, 0x00, 0x0F, 0x00, 0x01, 0xE0, 0x00,
+  0x3C, 0x00, 0x07, 0x80, 0x01, 0xC0, 0x87, 0x87, 0x01, 0x7F, 0xFC, 0x00, 0x41, 0x82, 0x01, 0x7F,
+  0xFC, 0x00, 0x41, 0x8B, 0x84, 0x0D, 0x70, 0x00, 0x3C, 0x00, 0x07, 0x80, 0x00, 0xF0, 0x00, 0x1E,
+  0x00, 0x03, 0xC0, 0x00, 0x78, 0x00, 0xF0, 0x01, 0xE0, 0x03, 0xC0, 0x07, 0x80, 0x0F, 0x00, 0x07,
+  0x00, 0x00, 0x87, 0x83, 0x04, 0x07, 0xC0, 0x07, 0xF0, 0x06, 0x1C, 0x03, 0x06, 0x00, 0x41, 0x05,
+  0x00, 0x70, 0x00, 0x70, 0x00, 0xF0, 0x00, 0x70, 0x00, 0x30, 0x00, 0x82, 0x01, 0x07, 0x00, 0x00,
+  0x41, 0x87, 0x82, 0x08, 0x03, 0xE0, 0x03, 0xF8, 0x03, 0x8E, 0x01, 0x83, 0x01, 0x87, 0x80, 0xC7,
+  0xC0, 0x67, 0x60, 0x33, 0x30, 0x42, 0x07, 0x18, 0xF8, 0x0C, 0x3C, 0x06, 0x00, 0x01, 0x80, 0x00,
+  0xE1, 0x80, 0x3F, 0xC0, 0x0F, 0x80, 0x85, 0x83, 0x04, 0x1F, 0x80, 0x0F, 0xE0, 0x00, 0x70, 0x00,
+  0x6C, 0x00, 0x41, 0x01, 0x06, 0x30, 0x00, 0x41, 0x06, 0x0C, 0x30, 0x07, 0xFC, 0x07, 0xFE, 0x03,
+  0x01, 0x83, 0x00, 0xC7, 0xE3, 0xF8, 0x41, 0x87, 0x83, 0x04, 0x7F, 0xE0, 0x3F, 0xF8, 0x06, 0x0E,
+  0x03, 0x03, 0x00, 0x41, 0x05, 0x18, 0x38, 0x0F, 0xF8, 0x07, 0xFE, 0x03, 0x03, 0x81, 0x80, 0xC0,
+  0x42, 0x02, 0x7F, 0xF8, 0x3F, 0xF8, 0x00, 0x87, 0x83, 0x06, 0x03, 0xEC, 0x07, 0xFE, 0x07, 0x07,
+  0x03, 0x01, 0x83, 0x00, 0xC1, 0x80, 0x00, 0x44, 0x04, 0x18, 0x0C, 0x0E, 0x0E, 0x03, 0xFE, 0x00,
+  0x7E, 0x00, 0x87, 0x83, 0x05, 0x7F, 0xC0, 0x3F, 0xF8, 0x06, 0x0E, 0x03, 0x03, 0x01, 0x80, 0xC0,
+  0x45, 0x04, 0x18, 0x18, 0x0C, 0x1C, 0x1F, 0xFC, 0x0F, 0xFC, 0x00, 0x87, 0x83, 0x01, 0x7F, 0xF8,
+  0x00, 0x41, 0x01, 0x18, 0x18, 0x00, 0x41, 0x03, 0x19, 0x98, 0x0C, 0xC0, 0x07, 0xE0, 0x00, 0x41,
+  0x03, 0x19, 0x80, 0x0C, 0xCC, 0x06, 0x06, 0x00, 0x41, 0x01, 0x7F, 0xF8, 0x00, 0x41, 0x87, 0x83,
+  0x01, 0x3F, 0xFC, 0x00, 0x41, 0x01, 0x0C, 0x0C, 0x00, 0x41, 0x03, 0x0C, 0xCC, 0x06, 0x60, 0x03,
+  0xF0, 0x00, 0x41, 0x01, 0x0C, 0xC0, 0x00, 0x41, 0x01, 0x0C, 0x00, 0x00, 0x41, 0x01, 0x3F, 0xC0,
+  0x00, 0x41, 0x87, 0x83, 0x06, 0x03, 0xEC, 0x07, 0xFE, 0x07, 0x07, 0x03, 0x01, 0x83, 0x00, 0xC1,
+  0x80, 0x00, 0x41, 0x01, 0x30, 0xFE, 0x00, 0x41, 0x05, 0x30, 0x0C, 0x1C, 0x06, 0x07, 0x07, 0x01,
+  0xFF, 0x80, 0x3F, 0x00, 0x87, 0x83, 0x01, 0x7E, 0x7E, 0x00, 0x41, 0x01, 0x18, 0x18, 0x00, 0x43,
+  0x01, 0x1F, 0xF8, 0x00, 0x41, 0x01, 0x18, 0x18, 0x00, 0x43, 0x01, 0x7E, 0x7E, 0x00, 0x41, 0x87,
+  0x83, 0x01, 0x1F, 0xF8, 0x00, 0x41, 0x01, 0x01, 0x80, 0x00, 0x49, 0x01, 0x1F, 0xF8, 0x00, 0x41,
+  0x87, 0x83, 0x01, 0x07, 0xFE, 0x00, 0x41, 0x01, 0x00, 0x30, 0x00, 0x44, 0x01, 0x30, 0x30, 0x00,
+  0x43, 0x03, 0x30, 0x60, 0x1F, 0xF0, 0x03, 0xE0, 0x00, 0x87, 0x83, 0x01, 0x7F, 0x3E, 0x00, 0x41,
+  0x0B, 0x18, 0x30, 0x0C, 0x30, 0x06, 0x30, 0x03, 0x30, 0x01, 0xB8, 0x00, 0xFE, 0x00, 0x73, 0x80,
+  0x30, 0xE0, 0x18, 0x30, 0x0C, 0x1C, 0x1F, 0xC7, 0xC0, 0x41, 0x87, 0x83, 0x01, 0x7F, 0x80, 0x00,
+  0x41, 0x01, 0x0C, 0x00, 0x00, 0x45, 0x01, 0x0C, 0x0C, 0x00, 0x43, 0x01, 0x7F, 0xFC, 0x00, 0x41,
+  0x87, 0x83, 0x04, 0xF0, 0x0F, 0x7C, 0x0F, 0x8E, 0x07, 0x07, 0x87, 0x80, 0x41, 0x01, 0x36, 0x6C,
+  0x00, 0x41, 0x01, 0x33, 0xCC, 0x00, 0x41, 0x02, 0x31, 0x8C, 0x18, 0x06, 0x00, 0x41, 0x01, 0xFE,
+  0x7F, 0x00, 0x41, 0x87, 0x83, 0x01, 0x78, 0xFE, 0x00, 0x41, 0x0B, 0x1C, 0x18, 0x0F, 0x0C, 0x07,
+  0xC6, 0x03, 0x63, 0x01, 0xB9, 0x80, 0xCE, 0xC0, 0x63, 0x60, 0x31, 0xF0, 0x18, 0x78, 0x0C, 0x1C,
+  0x1F, 0xC6, 0x00, 0x41, 0x87, 0x83, 0x06, 0x03, 0xC0, 0x07, 0xF8, 0x07, 0x0E, 0x03, 0x03, 0x03,
+  0x81, 0xC1, 0x80, 0x60, 0x43, 0x05, 0x38, 0x1C, 0x0C, 0x0C, 0x07, 0x0E, 0x01, 0xFE, 0x00, 0x3C,
+  0x00, 0x87, 0x83, 0x04, 0x3F, 0xF0, 0x1F, 0xFC, 0x03, 0x07, 0x01, 0x81, 0x80, 0x42, 0x04, 0x0C,
+  0x18, 0x07, 0xFC, 0x03, 0xF8, 0x01, 0x80, 0x00, 0x42, 0x01, 0x3F, 0xC0, 0x00, 0x41, 0x87, 0x83,
+  0x06, 0x03, 0xC0, 0x07, 0xF8, 0x07, 0x0E, 0x03, 0x03, 0x03, 0x81, 0xC1, 0x80, 0x60, 0x43, 0x08,
+  0x38, 0x1C, 0x0C, 0x0C, 0x07, 0x0E, 0x01, 0xFE, 0x00, 0x7C, 0x00, 0x3E, 0x60, 0x3F, 0xF0, 0x18,
+  0x70, 0x84, 0x83, 0x04, 0x7F, 0xE0, 0x3F, 0xF8, 0x06, 0x0E, 0x03, 0x03, 0x00, 0x41, 0x09, 0x18,
+  0x38, 0x0F, 0xF8, 0x07, 0xF0, 0x03, 0x1C, 0x01, 0x87, 0x00, 0xC1, 0x80, 0x60, 0xE0, 0xFE, 0x3C,
+  0x7F, 0x0E, 0x00, 0x87, 0x83, 0x04, 0x07, 0xD8, 0x07, 0xFC, 0x07, 0x0E, 0x03, 0x03, 0x00, 0x41,
+  0x05, 0x1E, 0x00, 0x07, 0xE0, 0x00, 0xFC, 0x00, 0x0F, 0x01, 0x81, 0x80, 0x41, 0x03, 0x1C, 0x38,
+  0x0F, 0xF8, 0x06, 0xF8, 0x00, 0x87, 0x83, 0x01, 0x3F, 0xFC, 0x00, 0x41, 0x01, 0x31, 0x8C, 0x00,
+  0x43, 0x01, 0x01, 0x80, 0x00, 0x45, 0x01, 0x0F, 0xF0, 0x00, 0x41, 0x87, 0x83, 0x01, 0x7E, 0x7E,
+  0x00, 0x41, 0x01, 0x18, 0x18, 0x00, 0x48, 0x03, 0x0C, 0x30, 0x07, 0xF8, 0x00, 0xF0, 0x00, 0x87,
+  0x83, 0x01, 0x7F, 0x7F, 0x00, 0x41, 0x02, 0x18, 0x0C, 0x06, 0x0C, 0x00, 0x42, 0x01, 0x06, 0x30,
+  0x00, 0x41, 0x01, 0x03, 0x60, 0x00, 0x42, 0x01, 0x01, 0xC0, 0x00, 0x41, 0x01, 0x00, 0x80, 0x00,
+  0x87, 0x83, 0x01, 0xFE, 0x3F, 0x80, 0x41, 0x01, 0x30, 0x06, 0x00, 0x41, 0x02, 0x30, 0x86, 0x0C,
+  0xE6, 0x00, 0x41, 0x01, 0x1B, 0x6C, 0x00, 0x41, 0x02, 0x1E, 0x7C, 0x07, 0x1C, 0x00, 0x41, 0x01,
+  0x0C, 0x18, 0x00, 0x41, 0x87, 0x83, 0x01, 0x7E, 0x7E, 0x00, 0x41, 0x05, 0x18, 0x18, 0x06, 0x18,
+  0x01, 0x98, 0x00, 0x78, 0x00, 0x18, 0x00, 0x41, 0x05, 0x03, 0xC0, 0x03, 0x30, 0x03, 0x0C, 0x03,
+  0x03, 0x07, 0xE7, 0xE0, 0x41, 0x87, 0x83, 0x01, 0x7C, 0x7E, 0x00, 0x41, 0x03, 0x18, 0x18, 0x06,
+  0x18, 0x01, 0x98, 0x00, 0x41, 0x02, 0x03, 0xC0, 0x00, 0xC0, 0x00, 0x44, 0x01, 0x0F, 0xF0, 0x00,
+  0x41, 0x87, 0x83, 0x01, 0x1F, 0xF8, 0x00, 0x41, 0x0B, 0x18, 0x18, 0x0C, 0x18, 0x06, 0x18, 0x03,
+  0x18, 0x00, 0x18, 0x00, 0x18, 0x00, 0x18, 0x60, 0x18, 0x30, 0x18, 0x18, 0x18, 0x0C, 0x0F, 0xFE,
+  0x00, 0x41, 0x87, 0x82, 0x01, 0x01, 0xF0, 0x00, 0x41, 0x01, 0x01, 0x80, 0x00, 0x4D, 0x01, 0x01,
+  0xF0, 0x00, 0x41, 0x84, 0x01, 0x18, 0x00, 0x00, 0x41, 0x04, 0x1C, 0x00, 0x06, 0x00, 0x03, 0x80,
+  0x00, 0xC0, 0x00, 0x41, 0x01, 0x03, 0x00, 0x00, 0x41, 0x01, 0x01, 0x80, 0x00, 0x41, 0x01, 0x00,
+  0xC0, 0x00, 0x41, 0x01, 0x00, 0x60, 0x00, 0x41, 0x04, 0x00, 0x70, 0x00, 0x18, 0x00, 0x0E, 0x00,
+  0x03, 0x00, 0x41, 0x84, 0x82, 0x01, 0x0F, 0x80, 0x00, 0x41, 0x01, 0x01, 0x80, 0x00, 0x4D, 0x01,
+  0x0F, 0x80, 0x00, 0x41, 0x84, 0x81, 0x08, 0x00, 0x80, 0x00, 0xE0, 0x00, 0xF8, 0x00, 0xEE, 0x00,
+  0x63, 0x00, 0x60, 0xC0, 0x60, 0x30, 0x20, 0x08, 0x8F, 0x96, 0x01, 0xFF, 0xFF, 0x00, 0x41, 0x81,
+  0x04, 0x03, 0x00, 0x01, 0xC0, 0x00, 0x38, 0x00, 0x0C, 0x00, 0x93, 0x86, 0x03, 0x0F, 0xC0, 0x0F,
+  0xF0, 0x00, 0x0C, 0x00, 0x41, 0x07, 0x07, 0xF0, 0x0F, 0xF8, 0x0E, 0x0C, 0x06, 0x06, 0x03, 0x07,
+  0x00, 0xFF, 0xE0, 0x3E, 0xF0, 0x87, 0x82, 0x01, 0x78, 0x00, 0x00, 0x41, 0x01, 0x18, 0x00, 0x00,
+  0x41, 0x04, 0x1B, 0xE0, 0x0F, 0xFC, 0x07, 0x06, 0x03, 0x01, 0x80, 0x44, 0x03, 0x1C, 0x18, 0x3F,
+  0xFC, 0x1E, 0xF8, 0x00, 0x87, 0x86, 0x06, 0x03, 0xEC, 0x07, 0xFE, 0x07, 0x07, 0x07, 0x01, 0x83,
+  0x00, 0xC1, 0x80, 0x00, 0x41, 0x04, 0x38, 0x0C, 0x0E, 0x0E, 0x03, 0xFE, 0x00, 0x7E, 0x00, 0x87,
+  0x82, 0x01, 0x00, 0x78, 0x00, 0x41, 0x01, 0x00, 0x18, 0x00, 0x41, 0x04, 0x07, 0xD8, 0x0F, 0xFC,
+  0x06, 0x0E, 0x06, 0x03, 0x00, 0x44, 0x03, 0x18, 0x38, 0x0F, 0xFF, 0x01, 0xF7, 0x80, 0x87, 0x86,
+  0x05, 0x07, 0xE0, 0x0F, 0xFC, 0x06, 0x06, 0x06, 0x01, 0x83, 0xFF, 0xC0, 0x41, 0x01, 0x30, 0x00,
+  0x00, 0x41, 0x03, 0x18, 0x0C, 0x0F, 0xFE, 0x01, 0xFC, 0x00, 0x87, 0x82, 0x03, 0x01, 0xFC, 0x01,
+  0xFE, 0x01, 0x80, 0x00, 0x41, 0x01, 0x3F, 0xF8, 0x00, 0x41, 0x01, 0x06, 0x00, 0x00, 0x46, 0x01,
+  0x3F, 0xF0, 0x00, 0x41, 0x87, 0x86, 0x04, 0x07, 0xDE, 0x0F, 0xFF, 0x06, 0x0E, 0x06, 0x03, 0x00,
+  0x44, 0x04, 0x18, 0x38, 0x0F, 0xFC, 0x01, 0xF6, 0x00, 0x03, 0x00, 0x41, 0x03, 0x00, 0x38, 0x07,
+  0xF8, 0x03, 0xF0, 0x00, 0x82, 0x82, 0x01, 0x78, 0x00, 0x00, 0x41, 0x01, 0x18, 0x00, 0x00, 0x41,
+  0x04, 0x1B, 0xE0, 0x0F, 0xF8, 0x07, 0x0E, 0x03, 0x03, 0x00, 0x45, 0x01, 0x7E, 0x7E, 0x00, 0x41,
+  0x87, 0x82, 0x01, 0x01, 0x80, 0x00, 0x41, 0x82, 0x01, 0x1F, 0x80, 0x00, 0x41, 0x01, 0x01, 0x80,
+  0x00, 0x46, 0x01, 0x3F, 0xFC, 0x00, 0x41, 0x87, 0x82, 0x01, 0x00, 0xC0, 0x00, 0x41, 0x82, 0x01,
+  0x1F, 0xF0, 0x00, 0x41, 0x01, 0x00, 0x30, 0x00, 0x4A, 0x03, 0x00, 0x70, 0x0F, 0xF0, 0x07, 0xE0,
+  0x00, 0x82, 0x82, 0x01, 0x3C, 0x00, 0x00, 0x41, 0x01, 0x0C, 0x00, 0x00, 0x41, 0x01, 0x0C, 0xF8,
+  0x00, 0x41, 0x08, 0x0C, 0xC0, 0x06, 0xC0, 0x03, 0xE0, 0x01, 0xE0, 0x00, 0xF8, 0x00, 0x6E, 0x00,
+  0x33, 0x80, 0x78, 0xF8, 0x41, 0x87, 0x82, 0x01, 0x1F, 0x80, 0x00, 0x41, 0x01, 0x01, 0x80, 0x00,
+  0x4A, 0x01, 0x3F, 0xFC, 0x00, 0x41, 0x87, 0x86, 0x04, 0xF7, 0x78, 0x7F, 0xFE, 0x0E, 0x73, 0x06,
+  0x31, 0x80, 0x45, 0x01, 0xFD, 0xEF, 0x00, 0x41, 0x87, 0x86, 0x04, 0x7B, 0xE0, 0x3F, 0xF8, 0x07,
+  0x0E, 0x03, 0x03, 0x00, 0x45, 0x01, 0x7E, 0x7E, 0x00, 0x41, 0x87, 0x86, 0x05, 0x03, 0xC0, 0x07,
+  0xF8, 0x07, 0x0E, 0x07, 0x03, 0x83, 0x00, 0xC0, 0x42, 0x04, 0x38, 0x1C, 0x0E, 0x1C, 0x03, 0xFC,
+  0x00, 0x78, 0x00, 0x87, 0x86, 0x04, 0x7B, 0xE0, 0x3F, 0xFC, 0x07, 0x06, 0x03, 0x01, 0x80, 0x44,
+  0x04, 0x1C, 0x18, 0x0F, 0xFC, 0x06, 0xF8, 0x03, 0x00, 0x00, 0x42, 0x01, 0x7F, 0x00, 0x00, 0x41,
+  0x82, 0x86, 0x04, 0x07, 0xDE, 0x0F, 0xFF, 0x06, 0x0E, 0x06, 0x03, 0x00, 0x44, 0x04, 0x18, 0x38,
+  0x0F, 0xFC, 0x01, 0xF6, 0x00, 0x03, 0x00, 0x42, 0x01, 0x00, 0xFE, 0x00, 0x41, 0x82, 0x86, 0x05,
+  0x3E, 0x78, 0x1F, 0x7E, 0x01, 0xF3, 0x00, 0xE0, 0x00, 0x60, 0x00, 0x44, 0x01, 0x3F, 0xF0, 0x00,
+  0x41, 0x87, 0x86, 0x03, 0x07, 0xF8, 0x07, 0xFC, 0x06, 0x06, 0x00, 0x41, 0x07, 0x1F, 0x80, 0x07,
+  0xF8, 0x00, 0x3E, 0x03, 0x03, 0x01, 0x83, 0x80, 0xFF, 0x80, 0x7F, 0x80, 0x87, 0x82, 0x01, 0x0C,
+  0x00, 0x00, 0x43, 0x01, 0x3F, 0xF0, 0x00, 0x41, 0x01, 0x0C, 0x00, 0x00, 0x45, 0x03, 0x0C, 0x1C,
+  0x03, 0xFE, 0x00, 0xFC, 0x00, 0x87, 0x86, 0x01, 0x78, 0x78, 0x00, 0x41, 0x01, 0x18, 0x18, 0x00,
+  0x45, 0x03, 0x18, 0x38, 0x07, 0xFF, 0x01, 0xF7, 0x80, 0x87, 0x86, 0x01, 0x7C, 0x3E, 0x00, 0x41,
+  0x01, 0x18, 0x18, 0x00, 0x41, 0x01, 0x0C, 0x30, 0x00, 0x41, 0x01, 0x06, 0x60, 0x00, 0x41, 0x02,
+  0x07, 0xE0, 0x01, 0xE0, 0x00, 0x41, 0x87, 0x86, 0x01, 0x78, 0x3C, 0x00, 0x41, 0x02, 0x31, 0x18,
+  0x19, 0xCC, 0x00, 0x41, 0x02, 0x1A, 0xB0, 0x0F, 0x78, 0x00, 0x41, 0x02, 0x1C, 0x60, 0x06, 0x30,
+  0x00, 0x41, 0x87, 0x86, 0x01, 0x3E, 0x7C, 0x00, 0x41, 0x08, 0x0C, 0x30, 0x03, 0x30, 0x00, 0xF0,
+  0x00, 0x30, 0x00, 0x3C, 0x00, 0x33, 0x00, 0x30, 0xC0, 0x7C, 0xF8, 0x41, 0x87, 0x86, 0x01, 0x7E,
+  0x1F, 0x00, 0x41, 0x02, 0x18, 0x0C, 0x06, 0x0C, 0x00, 0x41, 0x01, 0x06, 0x30, 0x00, 0x41, 0x05,
+  0x03, 0x60, 0x01, 0xF0, 0x00, 0x70, 0x00, 0x18, 0x00, 0x18, 0x00, 0x41, 0x02, 0x03, 0x00, 0x1F,
+  0xE0, 0x00, 0x41, 0x82, 0x86, 0x01, 0x1F, 0xF8, 0x00, 0x41, 0x08, 0x18, 0x30, 0x0C, 0x30, 0x00,
+  0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0xC0, 0x30, 0x60, 0x3F, 0xF0, 0x41, 0x87, 0x82, 0x03,
+  0x00, 0xE0, 0x00, 0xF0, 0x00, 0x60, 0x00, 0x45, 0x04, 0x03, 0x80, 0x03, 0x80, 0x00, 0xE0, 0x00,
+  0x30, 0x00, 0x44, 0x02, 0x01, 0xE0, 0x00, 0x70, 0x00, 0x84, 0x82, 0x01, 0x01, 0x80, 0x00, 0x51,
+  0x84, 0x82, 0x03, 0x07, 0x00, 0x03, 0xC0, 0x00, 0x60, 0x00, 0x45, 0x04, 0x01, 0xC0, 0x00, 0x70,
+  0x00, 0x70, 0x00, 0x30, 0x00, 0x44, 0x02, 0x07, 0x80, 0x03, 0x80, 0x00, 0x84, 0x88, 0x05, 0x0E,
+  0x00, 0x0F, 0x8C, 0x0E, 0xEE, 0x06, 0x3E, 0x00, 0x0E, 0x00, 0x8B,
+};
+
+sFONT Font24 = {
+  Font24_Table,
+  17, /* Width */
+  24, /* Height */
+  Font24_Index, /* Packed */
+};
+
+static const uint16_t Font20_Index[] =
+{
+      0,     1,    16,    26,    47,    76,   100,   124,   134,   156,   178,   197,
+    211,   226,   232,   238,   267,   285,   301,   326,   354,   382,   408,   435,
+    457,   485,   511,   522,   540,   563,   574,   597,   620,   647,   673,   699,
+    720,   741,   767,   793,   818,   840,   854,   875,   901,   919,   944,   970,
+    991,  1015,  1042,  1066,  1090,  1108,  1125,  1147,  1170,  1194,  1216,  1240,
+   1254,  1283,  1297,  1311,  1316,  1325,  1344,  1370,  1390,  1416,  1435,  1457,
+   1482,  1505,  1524,  1546,  1574,  1588,  1602,  1617,  1635,  1659,  1683,  1700,
+   1719,  1740,  1757,  1777,  1797,  1816,  1843,  1862,  1886,  1892,  1916,
+};
+
+const uint8_t Font20_Table[] =
+{
+  0x94, 0x81, 0x01, 0x07, 0x00, 0x46, 0x01, 0x02, 0x00, 0x41, 0x82, 0x01, 0x07, 0x00, 0x41, 0x86,
+  0x82, 0x01, 0x1C, 0xE0, 0x42, 0x01, 0x08, 0x40, 0x42, 0x8C, 0x01, 0x0C, 0xC0, 0x44, 0x01, 0x3F,
+  0xF0, 0x41, 0x01, 0x0C, 0xC0, 0x41, 0x01, 0x3F, 0xF0, 0x41, 0x01, 0x0C, 0xC0, 0x44, 0x84, 0x01,
+  0x03, 0x00, 0x41, 0x08, 0x07, 0xE0, 0x3F, 0x81, 0x86, 0x06, 0x00, 0x1F, 0x00, 0x3F, 0x00, 0x0E,
+  0x06, 0x18, 0x41, 0x03, 0x1F, 0xC0, 0x7E, 0x00, 0x30, 0x00, 0x42, 0x84, 0x81, 0x02, 0x1C, 0x00,
+  0x88, 0x00, 0x42, 0x06, 0x1C, 0x60, 0x07, 0x80, 0xF8, 0x0F, 0x00, 0x31, 0xC0, 0x08, 0x80, 0x42,
+  0x01, 0x01, 0xC0, 0x86, 0x83, 0x03, 0x03, 0xE0, 0x3F, 0x80, 0xC0, 0x00, 0x41, 0x07, 0x06, 0x00,
+  0x3C, 0xC1, 0xFF, 0x06, 0x78, 0x18, 0xC0, 0x7F, 0xC0, 0x7B, 0x00, 0x86, 0x82, 0x01, 0x03, 0x80,
+  0x42, 0x01, 0x01, 0x00, 0x42, 0x8C, 0x81, 0x01, 0x00, 0xC0, 0x41, 0x01, 0x01, 0x80, 0x42, 0x01,
+  0x03, 0x00, 0x45, 0x01, 0x01, 0x80, 0x42, 0x01, 0x00, 0xC0, 0x41, 0x83, 0x81, 0x01, 0x0C, 0x00,
+  0x41, 0x01, 0x06, 0x00, 0x42, 0x01, 0x03, 0x00, 0x45, 0x01, 0x06, 0x00, 0x42, 0x01, 0x0C, 0x00,
+  0x41, 0x83, 0x81, 0x01, 0x03, 0x00, 0x42, 0x03, 0x1B, 0x60, 0x7F, 0x80, 0x78, 0x00, 0x41, 0x02,
+  0x0F, 0xC0, 0x33, 0x00, 0x8A, 0x83, 0x01, 0x03, 0x00, 0x43, 0x01, 0x3F, 0xF0, 0x41, 0x01, 0x03,
+  0x00, 0x43, 0x87, 0x8B, 0x02, 0x03, 0x80, 0x0C, 0x00, 0x41, 0x01, 0x06, 0x00, 0x41, 0x01, 0x04,
+  0x00, 0x83, 0x87, 0x01, 0x3F, 0xE0, 0x41, 0x8B, 0x8B, 0x01, 0x03, 0x80, 0x42, 0x86, 0x01, 0x00,
+  0x60, 0x41, 0x01, 0x00, 0xC0, 0x42, 0x01, 0x01, 0x80, 0x41, 0x01, 0x03, 0x00, 0x41, 0x01, 0x06,
+  0x00, 0x41, 0x01, 0x0C, 0x00, 0x42, 0x01, 0x18, 0x00, 0x41, 0x84, 0x81, 0x04, 0x0F, 0x80, 0x7F,
+  0x01, 0x8C, 0x0C, 0x18, 0x46, 0x03, 0x18, 0xC0, 0x7F, 0x00, 0xF8, 0x00, 0x86, 0x81, 0x02, 0x03,
+  0x00, 0x7C, 0x00, 0x41, 0x01, 0x03, 0x00, 0x47, 0x01, 0x1F, 0xE0, 0x41, 0x86, 0x81, 0x0C, 0x0F,
+  0x80, 0x7F, 0x03, 0x8E, 0x0C, 0x18, 0x00, 0x60, 0x03, 0x00, 0x18, 0x00, 0xC0, 0x06, 0x00, 0x30,
+  0x01, 0x80, 0x0F, 0xF8, 0x41, 0x86, 0x81, 0x06, 0x0F, 0x80, 0xFF, 0x03, 0x0E, 0x00, 0x18, 0x00,
+  0xE0, 0x1F, 0x00, 0x41, 0x02, 0x00, 0xE0, 0x01, 0x80, 0x41, 0x03, 0x60, 0xE1, 0xFF, 0x03, 0xF8,
+  0x00, 0x86, 0x81, 0x02, 0x01, 0xC0, 0x0F, 0x00, 0x41, 0x02, 0x06, 0xC0, 0x33, 0x00, 0x41, 0x03,
+  0x18, 0xC0, 0xC3, 0x03, 0xFE, 0x00, 0x41, 0x02, 0x00, 0xC0, 0x0F, 0x80, 0x41, 0x86, 0x81, 0x01,
+  0x1F, 0xC0, 0x41, 0x01, 0x18, 0x00, 0x41, 0x04, 0x1F, 0x80, 0x7F, 0x01, 0x8E, 0x00, 0x18, 0x42,
+  0x03, 0x30, 0xE0, 0xFF, 0x01, 0xF8, 0x00, 0x86, 0x81, 0x09, 0x03, 0xE0, 0x3F, 0x81, 0xE0, 0x06,
+  0x00, 0x38, 0x00, 0xDE, 0x03, 0xFC, 0x0E, 0x38, 0x30, 0x60, 0x41, 0x03, 0x18, 0xE0, 0x7F, 0x00,
+  0x78, 0x00, 0x86, 0x81, 0x01, 0x3F, 0xE0, 0x41, 0x03, 0x30, 0x60, 0x01, 0x80, 0x0C, 0x00, 0x42,
+  0x01, 0x01, 0x80, 0x42, 0x01, 0x03, 0x00, 0x42, 0x86, 0x81, 0x06, 0x0F, 0x80, 0x7F, 0x03, 0x8E,
+  0x0C, 0x18, 0x38, 0xE0, 0x7F, 0x00, 0x41, 0x02, 0x38, 0xE0, 0xC1, 0x80, 0x41, 0x03, 0x38, 0xE0,
+  0x7F, 0x00, 0xF8, 0x00, 0x86, 0x81, 0x04, 0x0F, 0x00, 0x7F, 0x03, 0x8C, 0x0C, 0x18, 0x41, 0x08,
+  0x38, 0xE0, 0x7F, 0x80, 0xF6, 0x00, 0x38, 0x00, 0xC0, 0x0F, 0x03, 0xF8, 0x0F, 0x80, 0x86, 0x85,
+  0x01, 0x03, 0x80, 0x42, 0x83, 0x01, 0x03, 0x80, 0x42, 0x86, 0x85, 0x01, 0x01, 0xC0, 0x42, 0x83,
+  0x03, 0x03, 0x80, 0x0C, 0x00, 0x60, 0x00, 0x41, 0x01, 0x04, 0x00, 0x84, 0x83, 0x0B, 0x00, 0x30,
+  0x03, 0xC0, 0x3C, 0x01, 0xC0, 0x1C, 0x01, 0xE0, 0x01, 0xC0, 0x01, 0xC0, 0x03, 0xC0, 0x03, 0xC0,
+  0x03, 0x00, 0x86, 0x85, 0x01, 0x7F, 0xF0, 0x41, 0x82, 0x01, 0x7F, 0xF0, 0x41, 0x89, 0x83, 0x0B,
+  0x30, 0x00, 0xF0, 0x00, 0xF0, 0x00, 0xE0, 0x00, 0xE0, 0x01, 0xE0, 0x0E, 0x00, 0xE0, 0x0F, 0x00,
+  0xF0, 0x03, 0x00, 0x00, 0x86, 0x82, 0x03, 0x0F, 0x80, 0x7F, 0x01, 0x86, 0x00, 0x41, 0x04, 0x00,
+  0x60, 0x07, 0x00, 0x38, 0x00, 0xC0, 0x82, 0x01, 0x07, 0x00, 0x41, 0x86, 0x81, 0x04, 0x03, 0x80,
+  0x32, 0x00, 0x84, 0x04, 0x10, 0x41, 0x02, 0x11, 0xC0, 0x49, 0x00, 0x42, 0x05, 0x11, 0xC0, 0x40,
+  0x00, 0x80, 0x02, 0x10, 0x07, 0x80, 0x85, 0x82, 0x01, 0x1F, 0x80, 0x41, 0x02, 0x03, 0x80, 0x1B,
+  0x00, 0x41, 0x03, 0x0C, 0xC0, 0x31, 0x81, 0xFE, 0x00, 0x41, 0x02, 0x30, 0x31, 0xE1, 0xE0, 0x41,
+  0x86, 0x82, 0x03, 0x3F, 0x80, 0xFF, 0x01, 0x86, 0x00, 0x41, 0x05, 0x18, 0xE0, 0x7F, 0x01, 0xFE,
+  0x06, 0x1C, 0x18, 0x30, 0x41, 0x02, 0x3F, 0xF0, 0xFF, 0x80, 0x86, 0x82, 0x05, 0x07, 0xB0, 0x3F,
+  0xC1, 0xC7, 0x0E, 0x0C, 0x30, 0x00, 0x43, 0x04, 0x38, 0x30, 0x71, 0xC0, 0xFE, 0x01, 0xF0, 0x86,
+  0x82, 0x05, 0x7F, 0x81, 0xFF, 0x03, 0x0E, 0x0C, 0x1C, 0x30, 0x30, 0x43, 0x04, 0x30, 0x70, 0xC3,
+  0x87, 0xFC, 0x1F, 0xE0, 0x86, 0x82, 0x01, 0x3F, 0xF0, 0x41, 0x01, 0x18, 0x30, 0x41, 0x02, 0x19,
+  0x80, 0x7E, 0x00, 0x41, 0x02, 0x19, 0x80, 0x60, 0xC0, 0x41, 0x01, 0x3F, 0xF0, 0x41, 0x86, 0x82,
+  0x01, 0x3F, 0xF0, 0x41, 0x01, 0x18, 0x30, 0x41, 0x02, 0x19, 0x80, 0x7E, 0x00, 0x41, 0x02, 0x19,
+  0x80, 0x60, 0x00, 0x41, 0x01, 0x3F, 0x00, 0x41, 0x86, 0x82, 0x05, 0x07, 0xB0, 0x7F, 0xC1, 0x87,
+  0x0C, 0x0C, 0x30, 0x00, 0x41, 0x01, 0x31, 0xF8, 0x41, 0x04, 0x30, 0x30, 0x60, 0xC1, 0xFF, 0x01,
+  0xF0, 0x86, 0x82, 0x01, 0x3C, 0xF0, 0x41, 0x01, 0x18, 0x60, 0x42, 0x01, 0x1F, 0xE0, 0x41, 0x01,
+  0x18, 0x60, 0x42, 0x01, 0x3C, 0xF0, 0x41, 0x86, 0x82, 0x01, 0x1F, 0xE0, 0x41, 0x01, 0x03, 0x00,
+  0x47, 0x01, 0x1F, 0xE0, 0x41, 0x86, 0x82, 0x01, 0x03, 0xF8, 0x41, 0x01, 0x00, 0x60, 0x43, 0x01,
+  0x30, 0x60, 0x42, 0x03, 0x30, 0xE0, 0xFF, 0x00, 0xF8, 0x00, 0x86, 0x82, 0x01, 0x3E, 0xF8, 0x41,
+  0x06, 0x18, 0xE0, 0x66, 0x01, 0xB0, 0x07, 0xC0, 0x1D, 0x80, 0x63, 0x00, 0x41, 0x03, 0x18, 0x60,
+  0xF9, 0xE3, 0xE3, 0x80, 0x86, 0x82, 0x01, 0x3F, 0x00, 0x41, 0x01, 0x0C, 0x00, 0x44, 0x01, 0x0C,
+  0x30, 0x42, 0x01, 0x3F, 0xF0, 0x41, 0x86, 0x82, 0x01, 0x78, 0x78, 0x41, 0x04, 0x38, 0x70, 0xF3,
+  0xC3, 0x4B, 0x0D, 0xEC, 0x41, 0x01, 0x33, 0x30, 0x41, 0x02, 0x30, 0x31, 0xF3, 0xE0, 0x41, 0x86,
+  0x82, 0x04, 0x39, 0xF0, 0xF7, 0xC1, 0xC6, 0x07, 0x98, 0x41, 0x01, 0x1B, 0x60, 0x41, 0x01, 0x19,
+  0xE0, 0x41, 0x03, 0x18, 0xE0, 0xFB, 0x83, 0xE6, 0x00, 0x86, 0x82, 0x05, 0x07, 0x80, 0x3F, 0x01,
+  0xCE, 0x0E, 0x1C, 0x30, 0x30, 0x43, 0x04, 0x38, 0x70, 0x73, 0x80, 0xFC, 0x01, 0xE0, 0x86, 0x82,
+  0x04, 0x3F, 0xC0, 0xFF, 0x81, 0x87, 0x06, 0x0C, 0x41, 0x04, 0x18, 0x70, 0x7F, 0x81, 0xFC, 0x06,
+  0x00, 0x41, 0x01, 0x3F, 0x00, 0x41, 0x86, 0x82, 0x05, 0x07, 0x80, 0x3F, 0x01, 0xCE, 0x0E, 0x1C,
+  0x30, 0x30, 0x43, 0x07, 0x38, 0x70, 0x73, 0x80, 0xFC, 0x01, 0xE0, 0x07, 0xB0, 0x3F, 0xC0, 0xCE,
+  0x00, 0x83, 0x82, 0x0C, 0x3F, 0xC0, 0xFF, 0x81, 0x87, 0x06, 0x0C, 0x18, 0x70, 0x7F, 0x81, 0xFC,
+  0x06, 0x38, 0x18, 0x60, 0x61, 0xC3, 0xE3, 0x8F, 0x86, 0x86, 0x82, 0x0C, 0x0F, 0xB0, 0x7F, 0xC3,
+  0x87, 0x0C, 0x0C, 0x38, 0x00, 0x7E, 0x00, 0x7E, 0x00, 0x1C, 0x30, 0x30, 0xE1, 0xC3, 0xFE, 0x0D,
+  0xF0, 0x86, 0x82, 0x01, 0x3F, 0xF0, 0x41, 0x01, 0x33, 0x30, 0x42, 0x01, 0x03, 0x00, 0x44, 0x01,
+  0x0F, 0xC0, 0x41, 0x86, 0x82, 0x01, 0x3C, 0xF0, 0x41, 0x01, 0x18, 0x60, 0x46, 0x03, 0x1C, 0xE0,
+  0x3F, 0x00, 0x78, 0x00, 0x86, 0x82, 0x01, 0x78, 0xF0, 0x41, 0x01, 0x30, 0x60, 0x41, 0x01, 0x18,
+  0xC0, 0x41, 0x01, 0x0D, 0x80, 0x42, 0x01, 0x07, 0x00, 0x42, 0x86, 0x82, 0x01, 0x7C, 0x7C, 0x41,
+  0x02, 0x30, 0x18, 0xCE, 0x60, 0x42, 0x03, 0x36, 0xD8, 0x5B, 0x41, 0xC7, 0x00, 0x42, 0x01, 0x18,
+  0x30, 0x86, 0x82, 0x01, 0x78, 0xF0, 0x41, 0x04, 0x30, 0x60, 0x63, 0x00, 0xD8, 0x01, 0xC0, 0x41,
+  0x04, 0x0D, 0x80, 0x63, 0x03, 0x06, 0x1E, 0x3C, 0x41, 0x86, 0x82, 0x01, 0x3C, 0xF0, 0x41, 0x03,
+  0x18, 0x60, 0x33, 0x00, 0x78, 0x00, 0x41, 0x01, 0x03, 0x00, 0x43, 0x01, 0x0F, 0xC0, 0x41, 0x86,
+  0x82, 0x01, 0x1F, 0xE0, 0x41, 0x04, 0x18, 0x60, 0x63, 0x00, 0x18, 0x00, 0xC0, 0x41, 0x04, 0x06,
+  0x00, 0x31, 0x81, 0x86, 0x07, 0xF8, 0x41, 0x86, 0x81, 0x01, 0x03, 0xC0, 0x41, 0x01, 0x03, 0x00,
+  0x4B, 0x01, 0x03, 0xC0, 0x41, 0x83, 0x01, 0x18, 0x00, 0x41, 0x01, 0x0C, 0x00, 0x42, 0x01, 0x06,
+  0x00, 0x41, 0x01, 0x03, 0x00, 0x41, 0x01, 0x01, 0x80, 0x41, 0x01, 0x00, 0xC0, 0x42, 0x01, 0x00,
+  0x60, 0x41, 0x84, 0x81, 0x01, 0x0F, 0x00, 0x41, 0x01, 0x03, 0x00, 0x4B, 0x01, 0x0F, 0x00, 0x41,
+  0x83, 0x81, 0x06, 0x02, 0x00, 0x1C, 0x00, 0xD8, 0x06, 0x30, 0x30, 0x60, 0x80, 0x80, 0x8D, 0x92,
+  0x01, 0xFF, 0xFC, 0x41, 0x81, 0x03, 0x04, 0x00, 0x0C, 0x00, 0x08, 0x00, 0x90, 0x85, 0x09, 0x0F,
+  0xC0, 0x7F, 0x80, 0x06, 0x03, 0xF8, 0x1F, 0xE0, 0xE1, 0x83, 0x0E, 0x0F, 0xFC, 0x1F, 0x70, 0x86,
+  0x81, 0x01, 0x70, 0x00, 0x41, 0x01, 0x30, 0x00, 0x41, 0x04, 0x37, 0x80, 0xFF, 0x83, 0x86, 0x0C,
+  0x0C, 0x42, 0x03, 0x38, 0x61, 0xFF, 0x87, 0x78, 0x00, 0x86, 0x85, 0x05, 0x07, 0xB0, 0x7F, 0xC1,
+  0x83, 0x0C, 0x0C, 0x30, 0x00, 0x41, 0x03, 0x38, 0x30, 0x7F, 0xC0, 0xFC, 0x00, 0x86, 0x81, 0x01,
+  0x00, 0x70, 0x41, 0x01, 0x00, 0x30, 0x41, 0x04, 0x07, 0xB0, 0x7F, 0xC1, 0x87, 0x0C, 0x0C, 0x42,
+  0x03, 0x38, 0x70, 0x7F, 0xE0, 0x7B, 0x80, 0x86, 0x85, 0x04, 0x07, 0x80, 0x7F, 0x81, 0x86, 0x0F,
+  0xFC, 0x41, 0x04, 0x30, 0x00, 0x60, 0xC1, 0xFF, 0x01, 0xF0, 0x86, 0x81, 0x03, 0x03, 0xF0, 0x1F,
+  0xC0, 0x60, 0x00, 0x41, 0x01, 0x1F, 0xE0, 0x41, 0x01, 0x06, 0x00, 0x44, 0x01, 0x1F, 0xE0, 0x41,
+  0x86, 0x85, 0x04, 0x07, 0xB8, 0x7F, 0xE1, 0x87, 0x0C, 0x0C, 0x42, 0x07, 0x18, 0x70, 0x7F, 0xC0,
+  0x7B, 0x00, 0x0C, 0x00, 0x70, 0x3F, 0x80, 0xFC, 0x00, 0x82, 0x81, 0x01, 0x38, 0x00, 0x41, 0x01,
+  0x18, 0x00, 0x41, 0x04, 0x1B, 0xC0, 0x7F, 0x81, 0xC6, 0x06, 0x18, 0x43, 0x01, 0x3C, 0xF0, 0x41,
+  0x86, 0x81, 0x01, 0x03, 0x00, 0x41, 0x82, 0x01, 0x1F, 0x00, 0x41, 0x01, 0x03, 0x00, 0x44, 0x01,
+  0x1F, 0xE0, 0x41, 0x86, 0x81, 0x01, 0x03, 0x00, 0x41, 0x82, 0x01, 0x1F, 0xC0, 0x41, 0x01, 0x00,
+  0xC0, 0x47, 0x03, 0x01, 0xC0, 0xFE, 0x03, 0xF0, 0x00, 0x82, 0x81, 0x01, 0x38, 0x00, 0x41, 0x01,
+  0x18, 0x00, 0x41, 0x01, 0x1B, 0xE0, 0x41, 0x02, 0x1B, 0x00, 0x78, 0x00, 0x41, 0x03, 0x1B, 0x00,
+  0x66, 0x03, 0x9F, 0x00, 0x41, 0x86, 0x81, 0x01, 0x1F, 0x00, 0x41, 0x01, 0x03, 0x00, 0x48, 0x01,
+  0x1F, 0xE0, 0x41, 0x86, 0x85, 0x03, 0x7E, 0xE1, 0xFF, 0xC3, 0x33, 0x00, 0x44, 0x01, 0x7B, 0xB8,
+  0x41, 0x86, 0x85, 0x04, 0x3B, 0xC0, 0xFF, 0x81, 0xC6, 0x06, 0x18, 0x43, 0x01, 0x3C, 0xF0, 0x41,
+  0x86, 0x85, 0x04, 0x07, 0x80, 0x7F, 0x81, 0x86, 0x0C, 0x0C, 0x42, 0x03, 0x18, 0x60, 0x7F, 0x80,
+  0x78, 0x00, 0x86, 0x85, 0x04, 0x77, 0x81, 0xFF, 0x83, 0x86, 0x0C, 0x0C, 0x42, 0x04, 0x38, 0x60,
+  0xFF, 0x83, 0x78, 0x0C, 0x00, 0x41, 0x01, 0x7C, 0x00, 0x41, 0x82, 0x85, 0x04, 0x07, 0xB8, 0x7F,
+  0xE1, 0x87, 0x0C, 0x0C, 0x42, 0x04, 0x18, 0x70, 0x7F, 0xC0, 0x7B, 0x00, 0x0C, 0x41, 0x01, 0x00,
+  0xF8, 0x41, 0x82, 0x85, 0x05, 0x3C, 0xE0, 0xF7, 0xC0, 0xF3, 0x03, 0x80, 0x0C, 0x00, 0x42, 0x01,
+  0x3F, 0xC0, 0x41, 0x86, 0x85, 0x09, 0x07, 0xE0, 0x7F, 0x81, 0x86, 0x07, 0x80, 0x0F, 0xC0, 0x07,
+  0x81, 0x86, 0x07, 0xF8, 0x1F, 0x80, 0x86, 0x82, 0x01, 0x0C, 0x00, 0x42, 0x01, 0x3F, 0xE0, 0x41,
+  0x01, 0x0C, 0x00, 0x43, 0x03, 0x0C, 0x30, 0x3F, 0xC0, 0x7C, 0x00, 0x86, 0x85, 0x01, 0x38, 0xE0,
+  0x41, 0x01, 0x18, 0x60, 0x43, 0x03, 0x18, 0xE0, 0x7F, 0xC0, 0xF7, 0x00, 0x86, 0x85, 0x01, 0x78,
+  0xF0, 0x41, 0x02, 0x30, 0x60, 0x63, 0x00, 0x41, 0x01, 0x0D, 0x80, 0x41, 0x01, 0x07, 0x00, 0x41,
+  0x86, 0x85, 0x01, 0x78, 0xF0, 0x41, 0x01, 0x32, 0x60, 0x41, 0x02, 0x37, 0xE0, 0x77, 0x00, 0x41,
+  0x01, 0x18, 0xC0, 0x41, 0x86, 0x85, 0x01, 0x3C, 0xF0, 0x41, 0x06, 0x0C, 0xC0, 0x1E, 0x00, 0x30,
+  0x01, 0xE0, 0x0C, 0xC0, 0xF3, 0xC0, 0x41, 0x86, 0x85, 0x01, 0x78, 0xF0, 0x41, 0x02, 0x30, 0x60,
+  0x63, 0x00, 0x41, 0x04, 0x0D, 0x80, 0x3E, 0x00, 0x70, 0x01, 0x80, 0x41, 0x02, 0x0C, 0x01, 0xFC,
+  0x00, 0x41, 0x82, 0x85, 0x01, 0x1F, 0xE0, 0x41, 0x06, 0x18, 0xC0, 0x06, 0x00, 0x30, 0x01, 0x80,
+  0x0C, 0x60, 0x7F, 0x80, 0x41, 0x86, 0x81, 0x03, 0x01, 0xC0, 0x0F, 0x00, 0x30, 0x00, 0x44, 0x04,
+  0x07, 0x00, 0x38, 0x00, 0x70, 0x00, 0xC0, 0x43, 0x02, 0x03, 0xC0, 0x07, 0x00, 0x83, 0x81, 0x01,
+  0x03, 0x00, 0x4F, 0x83, 0x81, 0x03, 0x1C, 0x00, 0x78, 0x00, 0x60, 0x00, 0x44, 0x04, 0x07, 0x00,
+  0x0E, 0x00, 0x70, 0x01, 0x80, 0x43, 0x02, 0x1E, 0x00, 0x70, 0x00, 0x83, 0x86, 0x04, 0x0E, 0x00,
+  0xFC, 0xC3, 0x3F, 0x00, 0x78, 0x8A,
+};
+
+sFONT Font20 = {
+  Font20_Table,
+  14, /* Width */
+  20, /* Height */
+  Font20_Index, /* Packed */
+};
+
+static const uint16_t Font16_Index[] =
+{
+      0,     1,    11,    21,    35,    57,    76,    91,   101,   121,   138,   154,
+    165,   175,   180,   186,   212,   225,   237,   256,   274,   292,   310,   328,
+    342,   357,   376,   387,   401,   417,   426,   442,   460,   481,   499,   514,
+    530,   543,   561,   579,   596,   611,   621,   635,   651,   665,   681,   697,
+    710,   725,   741,   758,   776,   790,   800,   816,   834,   850,   864,   880,
+    890,   916,   926,   937,   941,   948,   962,   980,   993,  1011,  1024,  1039,
+   1058,  1075,  1090,  1105,  1125,  1135,  1145,  1157,  1170,  1189,  1208,  1220,
+   1233,  1248,  1259,  1274,  1288,  1301,  1321,  1334,  1349,  1355,  1370,
+};
+
+const uint8_t Font16_Table[] =
+{
+  0x90, 0x81, 0x01, 0x0C, 0x00, 0x47, 0x81, 0x01, 0x0C, 0x00, 0x85, 0x82, 0x01, 0x1D, 0xC0, 0x41,
+  0x01, 0x08, 0x80, 0x42, 0x89, 0x81, 0x01, 0x0D, 0x80, 0x43, 0x04, 0x3F, 0xC3, 0x60, 0xFF, 0x0D,
+  0x80, 0x43, 0x84, 0x03, 0x04, 0x03, 0xF0, 0xC6, 0x00, 0x41, 0x05, 0x38, 0x03, 0xC0, 0x3C, 0x01,
+  0xC3, 0x18, 0x41, 0x02, 0x3F, 0x00, 0x80, 0x41, 0x83, 0x81, 0x02, 0x18, 0x04, 0x80, 0x41, 0x05,
+  0x18, 0xC0, 0xF0, 0x78, 0x18, 0xC0, 0x24, 0x41, 0x01, 0x01, 0x80, 0x85, 0x82, 0x02, 0x0F, 0x03,
+  0x00, 0x42, 0x05, 0x0C, 0x03, 0xB0, 0xDC, 0x19, 0x81, 0xD8, 0x85, 0x82, 0x01, 0x07, 0x00, 0x41,
+  0x01, 0x02, 0x00, 0x42, 0x89, 0x81, 0x01, 0x03, 0x00, 0x41, 0x03, 0x06, 0x01, 0xC0, 0x30, 0x00,
+  0x43, 0x03, 0x0E, 0x00, 0xC0, 0x0C, 0x00, 0x41, 0x83, 0x81, 0x01, 0x18, 0x00, 0x41, 0x02, 0x0C,
+  0x00, 0xC0, 0x45, 0x03, 0x0C, 0x03, 0x80, 0x60, 0x00, 0x83, 0x81, 0x01, 0x06, 0x00, 0x41, 0x01,
+  0x3F, 0xC0, 0x41, 0x03, 0x0F, 0x03, 0xF0, 0x66, 0x00, 0x88, 0x83, 0x01, 0x04, 0x00, 0x42, 0x02,
+  0x3F, 0x80, 0x80, 0x42, 0x86, 0x89, 0x04, 0x06, 0x00, 0x80, 0x30, 0x04, 0x00, 0x41, 0x82, 0x86,
+  0x01, 0x3F, 0x80, 0x89, 0x89, 0x01, 0x0C, 0x00, 0x41, 0x85, 0x01, 0x00, 0xC0, 0x41, 0x01, 0x01,
+  0x80, 0x41, 0x01, 0x03, 0x00, 0x41, 0x02, 0x06, 0x01, 0x80, 0x41, 0x01, 0x18, 0x00, 0x41, 0x01,
+  0x30, 0x00, 0x41, 0x83, 0x81, 0x03, 0x0E, 0x03, 0x60, 0xC6, 0x00, 0x45, 0x02, 0x1B, 0x01, 0xC0,
+  0x85, 0x81, 0x03, 0x06, 0x07, 0xC0, 0x18, 0x00, 0x46, 0x01, 0x3F, 0xC0, 0x85, 0x81, 0x03, 0x0F,
+  0x03, 0x30, 0xC6, 0x00, 0x41, 0x06, 0x03, 0x00, 0xC0, 0x30, 0x0C, 0x03, 0x00, 0x7F, 0x00, 0x85,
+  0x81, 0x07, 0x3F, 0x0C, 0x30, 0x06, 0x01, 0x81, 0xF0, 0x07, 0x00, 0x60, 0x41, 0x02, 0x61, 0x87,
+  0xE0, 0x85, 0x81, 0x01, 0x07, 0x00, 0x41, 0x08, 0x0F, 0x01, 0x60, 0x6C, 0x09, 0x83, 0x30, 0x7F,
+  0x00, 0xC0, 0x7C, 0x85, 0x81, 0x02, 0x1F, 0x83, 0x00, 0x42, 0x03, 0x1F, 0x02, 0x30, 0x06, 0x00,
+  0x41, 0x02, 0x21, 0x83, 0xE0, 0x85, 0x81, 0x07, 0x07, 0x83, 0x80, 0x60, 0x18, 0x03, 0x70, 0x73,
+  0x0C, 0x60, 0x41, 0x02, 0x19, 0x81, 0xE0, 0x85, 0x81, 0x04, 0x7F, 0x08, 0x60, 0x0C, 0x03, 0x00,
+  0x43, 0x01, 0x0C, 0x00, 0x42, 0x85, 0x81, 0x02, 0x1F, 0x06, 0x30, 0x42, 0x02, 0x1F, 0x06, 0x30,
+  0x43, 0x01, 0x1F, 0x00, 0x85, 0x81, 0x03, 0x1E, 0x06, 0x60, 0xC6, 0x00, 0x41, 0x06, 0x33, 0x83,
+  0xB0, 0x06, 0x01, 0x80, 0x70, 0x78, 0x00, 0x85, 0x84, 0x01, 0x0C, 0x00, 0x41, 0x83, 0x01, 0x0C,
+  0x00, 0x41, 0x85, 0x84, 0x01, 0x03, 0x00, 0x41, 0x83, 0x03, 0x06, 0x00, 0x80, 0x20, 0x00, 0x41,
+  0x83, 0x82, 0x09, 0x00, 0xC0, 0x60, 0x10, 0x0C, 0x06, 0x00, 0x30, 0x01, 0x00, 0x18, 0x00, 0xC0,
+  0x85, 0x85, 0x01, 0x7F, 0xC0, 0x81, 0x01, 0x7F, 0xC0, 0x88, 0x82, 0x09, 0x60, 0x03, 0x00, 0x10,
+  0x01, 0x80, 0x0C, 0x06, 0x01, 0x00, 0xC0, 0x60, 0x00, 0x85, 0x82, 0x02, 0x1F, 0x06, 0x30, 0x41,
+  0x03, 0x01, 0x80, 0xE0, 0x30, 0x00, 0x41, 0x81, 0x01, 0x0C, 0x00, 0x85, 0x81, 0x03, 0x0E, 0x02,
+  0x20, 0x84, 0x00, 0x41, 0x02, 0x27, 0x05, 0x20, 0x41, 0x04, 0x27, 0x04, 0x00, 0x44, 0x07, 0x00,
+  0x84, 0x82, 0x04, 0x3F, 0x01, 0xE0, 0x24, 0x0C, 0xC0, 0x41, 0x02, 0x1F, 0x86, 0x18, 0x41, 0x01,
+  0x79, 0xE0, 0x85, 0x82, 0x02, 0x7F, 0x06, 0x30, 0x42, 0x02, 0x3F, 0x06, 0x30, 0x42, 0x01, 0x7F,
+  0x00, 0x85, 0x82, 0x04, 0x1F, 0x46, 0x19, 0x81, 0x30, 0x00, 0x42, 0x03, 0x60, 0x46, 0x10, 0x7C,
+  0x00, 0x85, 0x82, 0x03, 0x7F, 0x06, 0x30, 0xC3, 0x00, 0x44, 0x02, 0x31, 0x8F, 0xE0, 0x85, 0x82,
+  0x02, 0x7F, 0x86, 0x10, 0x41, 0x04, 0x32, 0x07, 0xC0, 0xC8, 0x18, 0x40, 0x41, 0x01, 0x7F, 0x80,
+  0x85, 0x82, 0x02, 0x7F, 0xC6, 0x08, 0x41, 0x04, 0x32, 0x07, 0xC0, 0xC8, 0x18, 0x00, 0x41, 0x01,
+  0x7C, 0x00, 0x85, 0x82, 0x04, 0x1E, 0x86, 0x31, 0x82, 0x30, 0x00, 0x41, 0x04, 0x67, 0xCC, 0x30,
+  0xC6, 0x0F, 0x80, 0x85, 0x82, 0x02, 0x7B, 0xC6, 0x30, 0x42, 0x02, 0x3F, 0x86, 0x30, 0x42, 0x01,
+  0x7B, 0xC0, 0x85, 0x82, 0x02, 0x3F, 0xC0, 0xC0, 0x46, 0x01, 0x3F, 0xC0, 0x85, 0x82, 0x02, 0x1F,
+  0xC0, 0x60, 0x43, 0x01, 0x63, 0x00, 0x42, 0x01, 0x3E, 0x00, 0x85, 0x82, 0x09, 0x7B, 0xC6, 0x30,
+  0xCC, 0x1B, 0x03, 0xC0, 0x7C, 0x0C, 0xC1, 0x8C, 0x79, 0xC0, 0x85, 0x82, 0x02, 0x7E, 0x03, 0x00,
+  0x43, 0x01, 0x18, 0x40, 0x42, 0x01, 0x7F, 0xC0, 0x85, 0x82, 0x09, 0xE0, 0xEC, 0x19, 0xC7, 0x3D,
+  0xE6, 0xAC, 0xDD, 0x99, 0x33, 0x06, 0xFB, 0xE0, 0x85, 0x82, 0x09, 0x73, 0xC6, 0x30, 0xE6, 0x1E,
+  0xC3, 0x58, 0x6F, 0x0C, 0xE1, 0x8C, 0x79, 0x80, 0x85, 0x82, 0x03, 0x1F, 0x06, 0x31, 0x83, 0x00,
+  0x44, 0x02, 0x31, 0x83, 0xE0, 0x85, 0x82, 0x02, 0x7F, 0x06, 0x30, 0x43, 0x02, 0x3F, 0x06, 0x00,
+  0x41, 0x01, 0x7E, 0x00, 0x85, 0x82, 0x03, 0x1F, 0x06, 0x31, 0x83, 0x00, 0x44, 0x04, 0x31, 0x83,
+  0xE0, 0x33, 0x0F, 0xC0, 0x83, 0x82, 0x02, 0x7F, 0x06, 0x30, 0x42, 0x03, 0x3E, 0x06, 0x60, 0xC6,
+  0x00, 0x41, 0x01, 0x7C, 0xE0, 0x85, 0x82, 0x02, 0x1F, 0x86, 0x30, 0x41, 0x04, 0x38, 0x03, 0xE0,
+  0x0E, 0x18, 0xC0, 0x41, 0x01, 0x3F, 0x00, 0x85, 0x82, 0x02, 0x7F, 0x89, 0x90, 0x42, 0x01, 0x0C,
+  0x00, 0x43, 0x01, 0x3F, 0x00, 0x85, 0x82, 0x02, 0x7B, 0xC6, 0x30, 0x46, 0x01, 0x1F, 0x00, 0x85,
+  0x82, 0x02, 0x7B, 0xC6, 0x30, 0x41, 0x01, 0x1B, 0x00, 0x42, 0x02, 0x0A, 0x01, 0xC0, 0x41, 0x85,
+  0x82, 0x04, 0xFB, 0xEC, 0x19, 0x93, 0x37, 0x60, 0x41, 0x02, 0x2A, 0x87, 0x70, 0x41, 0x01, 0x31,
+  0x80, 0x85, 0x82, 0x04, 0x7B, 0xC6, 0x30, 0x6C, 0x07, 0x00, 0x42, 0x03, 0x1B, 0x06, 0x31, 0xEF,
+  0x00, 0x85, 0x82, 0x05, 0x79, 0xE6, 0x18, 0x66, 0x07, 0x80, 0x60, 0x43, 0x01, 0x1F, 0x80, 0x85,
+  0x82, 0x09, 0x3F, 0x84, 0x30, 0x8C, 0x03, 0x00, 0x40, 0x18, 0x06, 0x21, 0x84, 0x3F, 0x80, 0x85,
+  0x81, 0x02, 0x07, 0x80, 0xC0, 0x49, 0x01, 0x07, 0x80, 0x83, 0x01, 0x30, 0x00, 0x41, 0x01, 0x18,
+  0x00, 0x41, 0x01, 0x0C, 0x00, 0x41, 0x02, 0x06, 0x00, 0x60, 0x41, 0x01, 0x01, 0x80, 0x41, 0x01,
+  0x00, 0xC0, 0x41, 0x83, 0x81, 0x02, 0x1E, 0x00, 0xC0, 0x49, 0x01, 0x1E, 0x00, 0x83, 0x02, 0x04,
+  0x01, 0x40, 0x41, 0x02, 0x11, 0x04, 0x10, 0x41, 0x8A, 0x8F, 0x01, 0xFF, 0xE0, 0x03, 0x08, 0x00,
+  0x80, 0x08, 0x00, 0x8D, 0x84, 0x02, 0x1F, 0x00, 0x30, 0x41, 0x04, 0x1F, 0x86, 0x30, 0xCE, 0x0E,
+  0xE0, 0x85, 0x81, 0x02, 0x70, 0x06, 0x00, 0x41, 0x03, 0x37, 0x07, 0x30, 0xC3, 0x00, 0x42, 0x02,
+  0x39, 0x8E, 0xE0, 0x85, 0x84, 0x07, 0x1E, 0x86, 0x31, 0x82, 0x30, 0x06, 0x08, 0x63, 0x07, 0xC0,
+  0x85, 0x81, 0x02, 0x03, 0x80, 0x30, 0x41, 0x03, 0x1D, 0x86, 0x71, 0x86, 0x00, 0x42, 0x02, 0x33,
+  0x83, 0xB8, 0x85, 0x84, 0x07, 0x1F, 0x06, 0x31, 0x83, 0x3F, 0xE6, 0x00, 0x61, 0x87, 0xE0, 0x85,
+  0x81, 0x02, 0x07, 0xE1, 0x80, 0x41, 0x02, 0x3F, 0x81, 0x80, 0x44, 0x01, 0x3F, 0x80, 0x85, 0x84,
+  0x03, 0x1D, 0xC6, 0x71, 0x86, 0x00, 0x42, 0x03, 0x33, 0x83, 0xB0, 0x06, 0x00, 0x41, 0x01, 0x1F,
+  0x00, 0x82, 0x81, 0x02, 0x70, 0x06, 0x00, 0x41, 0x03, 0x37, 0x07, 0x30, 0xC6, 0x00, 0x43, 0x01,
+  0x7B, 0xC0, 0x85, 0x81, 0x01, 0x06, 0x00, 0x41, 0x81, 0x02, 0x1E, 0x00, 0xC0, 0x44, 0x01, 0x3F,
+  0xC0, 0x85, 0x81, 0x01, 0x06, 0x00, 0x41, 0x81, 0x02, 0x3F, 0x00, 0x60, 0x47, 0x01, 0x3E, 0x00,
+  0x82, 0x81, 0x02, 0x70, 0x06, 0x00, 0x41, 0x03, 0x37, 0x86, 0xC0, 0xF0, 0x00, 0x41, 0x03, 0x36,
+  0x06, 0x61, 0xDF, 0x00, 0x85, 0x81, 0x02, 0x1E, 0x00, 0xC0, 0x47, 0x01, 0x3F, 0xC0, 0x85, 0x84,
+  0x02, 0x7F, 0x86, 0xD8, 0x44, 0x01, 0x76, 0xE0, 0x85, 0x84, 0x03, 0x77, 0x07, 0x30, 0xC6, 0x00,
+  0x43, 0x01, 0x7B, 0xC0, 0x85, 0x84, 0x03, 0x1F, 0x06, 0x31, 0x83, 0x00, 0x42, 0x02, 0x31, 0x83,
+  0xE0, 0x85, 0x84, 0x03, 0x77, 0x07, 0x30, 0xC3, 0x00, 0x42, 0x03, 0x39, 0x86, 0xE0, 0xC0, 0x00,
+  0x41, 0x01, 0x7C, 0x00, 0x82, 0x84, 0x03, 0x1D, 0xC6, 0x71, 0x86, 0x00, 0x42, 0x03, 0x33, 0x83,
+  0xB0, 0x06, 0x00, 0x41, 0x01, 0x07, 0xC0, 0x82, 0x84, 0x03, 0x7B, 0x83, 0x98, 0x60, 0x00, 0x43,
+  0x01, 0x7F, 0x00, 0x85, 0x84, 0x07, 0x1F, 0x86, 0x30, 0xF0, 0x0F, 0x80, 0x38, 0x63, 0x0F, 0xC0,
+  0x85, 0x81, 0x01, 0x18, 0x00, 0x42, 0x02, 0x7F, 0x03, 0x00, 0x43, 0x02, 0x18, 0x81, 0xE0, 0x85,
+  0x84, 0x02, 0x73, 0x86, 0x30, 0x43, 0x02, 0x33, 0x83, 0xB8, 0x85, 0x84, 0x02, 0x7B, 0xC6, 0x30,
+  0x41, 0x01, 0x1B, 0x00, 0x41, 0x01, 0x0E, 0x00, 0x41, 0x85, 0x84, 0x05, 0xF1, 0xEC, 0x19, 0x93,
+  0x37, 0x63, 0xB8, 0x41, 0x01, 0x31, 0x80, 0x85, 0x84, 0x03, 0x7B, 0xC3, 0x60, 0x38, 0x00, 0x42,
+  0x02, 0x1B, 0x0F, 0x78, 0x85, 0x84, 0x03, 0x79, 0xE6, 0x18, 0x66, 0x00, 0x41, 0x03, 0x0B, 0x01,
+  0xE0, 0x18, 0x00, 0x41, 0x02, 0x0C, 0x07, 0xC0, 0x82, 0x84, 0x07, 0x3F, 0x84, 0x30, 0x0C, 0x07,
+  0x01, 0x80, 0x61, 0x0F, 0xE0, 0x85, 0x81, 0x02, 0x06, 0x01, 0x80, 0x44, 0x02, 0x18, 0x01, 0x80,
+  0x43, 0x01, 0x06, 0x00, 0x83, 0x81, 0x01, 0x06, 0x00, 0x4B, 0x83, 0x81, 0x02, 0x0C, 0x00, 0xC0,
+  0x44, 0x02, 0x03, 0x00, 0xC0, 0x43, 0x01, 0x0C, 0x00, 0x83, 0x85, 0x03, 0x18, 0x04, 0x90, 0x0C,
+  0x00, 0x88,
+};
+
+sFONT Font16 = {
+  Font16_Table,
+  11, /* Width */
+  16, /* Height */
+  Font16_Index, /* Packed */
+};
+
+/* raw bitmap, packing would save too little */
+const uint8_t Font12_Table[] =
+{
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x10, 0x10,
+  0x10, 0x10, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00, 0x6C, 0x48, 0x48, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x14, 0x14, 0x28, 0x7C, 0x28, 0x7C, 0x28, 0x50, 0x50, 0x00, 0x00,
+  0x00, 0x10, 0x38, 0x40, 0x40, 0x38, 0x48, 0x70, 0x10, 0x10, 0x00, 0x00, 0x00, 0x20, 0x50, 0x20,
+  0x0C, 0x70, 0x08, 0x14, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x20, 0x20, 0x54, 0x48,
+  0x34, 0x00, 0x00, 0x00, 0x00, 0x10, 0x10, 0x10, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x08, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x08, 0x08, 0x00, 0x00, 0x20, 0x20, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x10, 0x20, 0x20, 0x00, 0x00, 0x10, 0x7C, 0x10, 0x28, 0x28, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x10, 0x10, 0x10, 0xFE, 0x10, 0x10, 0x10, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x10, 0x30, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30,
+  0x30, 0x00, 0x00, 0x00, 0x00, 0x04, 0x04, 0x08, 0x08, 0x10, 0x10, 0x20, 0x20, 0x40, 0x00, 0x00,
+  0x00, 0x38, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00, 0x00, 0x30, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x04, 0x08, 0x10, 0x20, 0x44,
+  0x7C, 0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x04, 0x18, 0x04, 0x04, 0x44, 0x38, 0x00, 0x00, 0x00,
+  0x00, 0x0C, 0x14, 0x14, 0x24, 0x44, 0x7E, 0x04, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x20, 0x20,
+  0x38, 0x04, 0x04, 0x44, 0x38, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x20, 0x40, 0x78, 0x44, 0x44, 0x44,
+  0x38, 0x00, 0x00, 0x00, 0x00, 0x7C, 0x44, 0x04, 0x08, 0x08, 0x08, 0x10, 0x10, 0x00, 0x00, 0x00,
+  0x00, 0x38, 0x44, 0x44, 0x38, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x44,
+  0x44, 0x3C, 0x04, 0x08, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0x00, 0x00, 0x30,
+  0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00, 0x18, 0x30, 0x20, 0x00, 0x00,
+  0x00, 0x00, 0x0C, 0x10, 0x60, 0x80, 0x60, 0x10, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x7C, 0x00, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x20, 0x18, 0x04, 0x18, 0x20,
+  0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x18, 0x24, 0x04, 0x08, 0x10, 0x00, 0x30, 0x00, 0x00, 0x00,
+  0x38, 0x44, 0x44, 0x4C, 0x54, 0x54, 0x4C, 0x40, 0x44, 0x38, 0x00, 0x00, 0x00, 0x30, 0x10, 0x28,
+  0x28, 0x28, 0x7C, 0x44, 0xEE, 0x00, 0x00, 0x00, 0x00, 0xF8, 0x44, 0x44, 0x78, 0x44, 0x44, 0x44,
+  0xF8, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x44, 0x40, 0x40, 0x40, 0x40, 0x44, 0x38, 0x00, 0x00, 0x00,
+  0x00, 0xF0, 0x48, 0x44, 0x44, 0x44, 0x44, 0x48, 0xF0, 0x00, 0x00, 0x00, 0x00, 0xFC, 0x44, 0x50,
+  0x70, 0x50, 0x40, 0x44, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x7E, 0x22, 0x28, 0x38, 0x28, 0x20, 0x20,
+  0x70, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x44, 0x40, 0x40, 0x4E, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00,
+  0x00, 0xEE, 0x44, 0x44, 0x7C, 0x44, 0x44, 0x44, 0xEE, 0x00, 0x00, 0x00, 0x00, 0x7C, 0x10, 0x10,
+  0x10, 0x10, 0x10, 0x10, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x08, 0x08, 0x08, 0x48, 0x48, 0x48,
+  0x30, 0x00, 0x00, 0x00, 0x00, 0xEE, 0x44, 0x48, 0x50, 0x70, 0x48, 0x44, 0xE6, 0x00, 0x00, 0x00,
+  0x00, 0x70, 0x20, 0x20, 0x20, 0x20, 0x24, 0x24, 0x7C, 0x00, 0x00, 0x00, 0x00, 0xEE, 0x6C, 0x6C,
+  0x54, 0x54, 0x44, 0x44, 0xEE, 0x00, 0x00, 0x00, 0x00, 0xEE, 0x64, 0x64, 0x54, 0x54, 0x54, 0x4C,
+  0xEC, 0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x44, 0x44, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00,
+  0x00, 0x78, 0x24, 0x24, 0x24, 0x38, 0x20, 0x20, 0x70, 0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x44,
+  0x44, 0x44, 0x44, 0x44, 0x38, 0x1C, 0x00, 0x00, 0x00, 0xF8, 0x44, 0x44, 0x44, 0x78, 0x48, 0x44,
+  0xE2, 0x00, 0x00, 0x00, 0x00, 0x34, 0x4C, 0x40, 0x38, 0x04, 0x04, 0x64, 0x58, 0x00, 0x00, 0x00,
+  0x00, 0xFE, 0x92, 0x10, 0x10, 0x10, 0x10, 0x10, 0x38, 0x00, 0x00, 0x00, 0x00, 0xEE, 0x44, 0x44,
+  0x44, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00, 0x00, 0xEE, 0x44, 0x44, 0x28, 0x28, 0x28, 0x10,
+  0x10, 0x00, 0x00, 0x00, 0x00, 0xEE, 0x44, 0x44, 0x54, 0x54, 0x54, 0x54, 0x28, 0x00, 0x00, 0x00,
+  0x00, 0xC6, 0x44, 0x28, 0x10, 0x10, 0x28, 0x44, 0xC6, 0x00, 0x00, 0x00, 0x00, 0xEE, 0x44, 0x28,
+  0x28, 0x10, 0x10, 0x10, 0x38, 0x00, 0x00, 0x00, 0x00, 0x7C, 0x44, 0x08, 0x10, 0x10, 0x20, 0x44,
+  0x7C, 0x00, 0x00, 0x00, 0x00, 0x38, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x38, 0x00,
+  0x00, 0x40, 0x20, 0x20, 0x20, 0x10, 0x10, 0x08, 0x08, 0x08, 0x00, 0x00, 0x00, 0x38, 0x08, 0x08,
+  0x08, 0x08, 0x08, 0x08, 0x08, 0x08, 0x38, 0x00, 0x00, 0x10, 0x10, 0x28, 0x44, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFE,
+  0x00, 0x10, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38,
+  0x44, 0x3C, 0x44, 0x44, 0x3E, 0x00, 0x00, 0x00, 0x00, 0xC0, 0x40, 0x58, 0x64, 0x44, 0x44, 0x44,
+  0xF8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x44, 0x40, 0x40, 0x44, 0x38, 0x00, 0x00, 0x00,
+  0x00, 0x0C, 0x04, 0x34, 0x4C, 0x44, 0x44, 0x44, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38,
+  0x44, 0x7C, 0x40, 0x40, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x1C, 0x20, 0x7C, 0x20, 0x20, 0x20, 0x20,
+  0x7C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x36, 0x4C, 0x44, 0x44, 0x44, 0x3C, 0x04, 0x38, 0x00,
+  0x00, 0xC0, 0x40, 0x58, 0x64, 0x44, 0x44, 0x44, 0xEE, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x70,
+  0x10, 0x10, 0x10, 0x10, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x78, 0x08, 0x08, 0x08, 0x08,
+  0x08, 0x08, 0x70, 0x00, 0x00, 0xC0, 0x40, 0x5C, 0x48, 0x70, 0x50, 0x48, 0xDC, 0x00, 0x00, 0x00,
+  0x00, 0x30, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xE8,
+  0x54, 0x54, 0x54, 0x54, 0xFE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xD8, 0x64, 0x44, 0x44, 0x44,
+  0xEE, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x44, 0x44, 0x44, 0x44, 0x38, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xD8, 0x64, 0x44, 0x44, 0x44, 0x78, 0x40, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x36,
+  0x4C, 0x44, 0x44, 0x44, 0x3C, 0x04, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x6C, 0x30, 0x20, 0x20, 0x20,
+  0x7C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x3C, 0x44, 0x38, 0x04, 0x44, 0x78, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x20, 0x7C, 0x20, 0x20, 0x20, 0x22, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xCC,
+  0x44, 0x44, 0x44, 0x4C, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xEE, 0x44, 0x44, 0x28, 0x28,
+  0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xEE, 0x44, 0x54, 0x54, 0x54, 0x28, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0xCC, 0x48, 0x30, 0x30, 0x48, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xEE,
+  0x44, 0x24, 0x28, 0x18, 0x10, 0x10, 0x78, 0x00, 0x00, 0x00, 0x00, 0x7C, 0x48, 0x10, 0x20, 0x44,
+  0x7C, 0x00, 0x00, 0x00, 0x00, 0x08, 0x10, 0x10, 0x10, 0x10, 0x20, 0x10, 0x10, 0x10, 0x08, 0x00,
+  0x00, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x00, 0x00, 0x00, 0x20, 0x10, 0x10,
+  0x10, 0x10, 0x08, 0x10, 0x10, 0x10, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x24, 0x58, 0x00,
+  0x00, 0x00, 0x00, 0x00,
+};
+
+sFONT Font12 = {
+  Font12_Table,
+  7, /* Width */
+  12, /* Height */
+  0, /* Packed */
+};
+
+/* raw bitmap, packing would save too little */
+const uint8_t Font8_Table[] =
+{
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x20, 0x20, 0x20, 0x00, 0x20, 0x00, 0x00,
+  0x50, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x28, 0x50, 0xF8, 0x50, 0xF8, 0x50, 0xA0, 0x00,
+  0x20, 0x30, 0x60, 0x30, 0x10, 0x60, 0x20, 0x00, 0x20, 0x20, 0x18, 0x60, 0x10, 0x10, 0x00, 0x00,
+  0x00, 0x38, 0x20, 0x60, 0x50, 0x78, 0x00, 0x00, 0x20, 0x20, 0x20, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x10, 0x20, 0x20, 0x20, 0x20, 0x20, 0x10, 0x00, 0x40, 0x20, 0x20, 0x20, 0x20, 0x20, 0x40, 0x00,
+  0x20, 0x70, 0x20, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x20, 0xF8, 0x20, 0x20, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x10, 0x20, 0x20, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x20, 0x00, 0x00, 0x10, 0x20, 0x20, 0x20, 0x40, 0x40, 0x80, 0x00,
+  0x20, 0x50, 0x50, 0x50, 0x50, 0x20, 0x00, 0x00, 0x60, 0x20, 0x20, 0x20, 0x20, 0xF8, 0x00, 0x00,
+  0x20, 0x50, 0x20, 0x20, 0x40, 0x70, 0x00, 0x00, 0x20, 0x50, 0x10, 0x20, 0x10, 0x60, 0x00, 0x00,
+  0x10, 0x30, 0x50, 0x78, 0x10, 0x38, 0x00, 0x00, 0x70, 0x40, 0x60, 0x10, 0x50, 0x20, 0x00, 0x00,
+  0x30, 0x40, 0x60, 0x50, 0x50, 0x60, 0x00, 0x00, 0x70, 0x50, 0x10, 0x20, 0x20, 0x20, 0x00, 0x00,
+  0x20, 0x50, 0x20, 0x50, 0x50, 0x20, 0x00, 0x00, 0x30, 0x50, 0x50, 0x30, 0x10, 0x60, 0x00, 0x00,
+  0x00, 0x00, 0x20, 0x00, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x10, 0x00, 0x10, 0x20, 0x00, 0x00,
+  0x00, 0x10, 0x20, 0xC0, 0x20, 0x10, 0x00, 0x00, 0x00, 0x70, 0x00, 0x70, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x40, 0x20, 0x18, 0x20, 0x40, 0x00, 0x00, 0x20, 0x50, 0x10, 0x20, 0x00, 0x20, 0x00, 0x00,
+  0x30, 0x48, 0x48, 0x58, 0x48, 0x40, 0x38, 0x00, 0x60, 0x20, 0x50, 0x70, 0x88, 0xD8, 0x00, 0x00,
+  0xF0, 0x48, 0x70, 0x48, 0x48, 0xF0, 0x00, 0x00, 0x70, 0x50, 0x40, 0x40, 0x40, 0x30, 0x00, 0x00,
+  0xF0, 0x48, 0x48, 0x48, 0x48, 0xF0, 0x00, 0x00, 0xF8, 0x48, 0x60, 0x40, 0x48, 0xF8, 0x00, 0x00,
+  0xF8, 0x48, 0x60, 0x40, 0x40, 0xE0, 0x00, 0x00, 0x70, 0x40, 0x40, 0x58, 0x50, 0x30, 0x00, 0x00,
+  0xE8, 0x48, 0x78, 0x48, 0x48, 0xE8, 0x00, 0x00, 0x70, 0x20, 0x20, 0x20, 0x20, 0x70, 0x00, 0x00,
+  0x38, 0x10, 0x10, 0x50, 0x50, 0x20, 0x00, 0x00, 0xD8, 0x50, 0x60, 0x70, 0x50, 0xD8, 0x00, 0x00,
+  0xE0, 0x40, 0x40, 0x40, 0x48, 0xF8, 0x00, 0x00, 0xD8, 0xD8, 0xD8, 0xA8, 0x88, 0xD8, 0x00, 0x00,
+  0xD8, 0x68, 0x68, 0x58, 0x58, 0xE8, 0x00, 0x00, 0x30, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00, 0x00,
+  0xF0, 0x48, 0x48, 0x70, 0x40, 0xE0, 0x00, 0x00, 0x30, 0x48, 0x48, 0x48, 0x48, 0x30, 0x18, 0x00,
+  0xF0, 0x48, 0x48, 0x70, 0x48, 0xE8, 0x00, 0x00, 0x70, 0x50, 0x20, 0x10, 0x50, 0x70, 0x00, 0x00,
+  0xF8, 0xA8, 0x20, 0x20, 0x20, 0x70, 0x00, 0x00, 0xD8, 0x48, 0x48, 0x48, 0x48, 0x30, 0x00, 0x00,
+  0xD8, 0x88, 0x48, 0x50, 0x50, 0x30, 0x00, 0x00, 0xD8, 0x88, 0xA8, 0xA8, 0xA8, 0x50, 0x00, 0x00,
+  0xD8, 0x50, 0x20, 0x20, 0x50, 0xD8, 0x00, 0x00, 0xD8, 0x88, 0x50, 0x20, 0x20, 0x70, 0x00, 0x00,
+  0x78, 0x48, 0x10, 0x20, 0x48, 0x78, 0x00, 0x00, 0x30, 0x20, 0x20, 0x20, 0x20, 0x20, 0x30, 0x00,
+  0x80, 0x40, 0x40, 0x20, 0x20, 0x20, 0x10, 0x00, 0x60, 0x20, 0x20, 0x20, 0x20, 0x20, 0x60, 0x00,
+  0x20, 0x20, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF8,
+  0x20, 0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x30, 0x10, 0x70, 0x78, 0x00, 0x00,
+  0xC0, 0x40, 0x70, 0x48, 0x48, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x70, 0x40, 0x40, 0x70, 0x00, 0x00,
+  0x18, 0x08, 0x38, 0x48, 0x48, 0x38, 0x00, 0x00, 0x00, 0x00, 0x70, 0x70, 0x40, 0x30, 0x00, 0x00,
+  0x10, 0x20, 0x70, 0x20, 0x20, 0x70, 0x00, 0x00, 0x00, 0x00, 0x38, 0x48, 0x48, 0x38, 0x08, 0x30,
+  0xC0, 0x40, 0x70, 0x48, 0x48, 0xE8, 0x00, 0x00, 0x20, 0x00, 0x60, 0x20, 0x20, 0x70, 0x00, 0x00,
+  0x20, 0x00, 0x70, 0x10, 0x10, 0x10, 0x10, 0x70, 0xC0, 0x40, 0x58, 0x70, 0x50, 0xD8, 0x00, 0x00,
+  0x60, 0x20, 0x20, 0x20, 0x20, 0x70, 0x00, 0x00, 0x00, 0x00, 0xD0, 0xA8, 0xA8, 0xA8, 0x00, 0x00,
+  0x00, 0x00, 0xF0, 0x48, 0x48, 0xC8, 0x00, 0x00, 0x00, 0x00, 0x30, 0x48, 0x48, 0x30, 0x00, 0x00,
+  0x00, 0x00, 0xF0, 0x48, 0x48, 0x70, 0x40, 0xE0, 0x00, 0x00, 0x38, 0x48, 0x48, 0x38, 0x08, 0x18,
+  0x00, 0x00, 0x78, 0x20, 0x20, 0x70, 0x00, 0x00, 0x00, 0x00, 0x30, 0x20, 0x10, 0x60, 0x00, 0x00,
+  0x00, 0x40, 0xF0, 0x40, 0x48, 0x30, 0x00, 0x00, 0x00, 0x00, 0xD8, 0x48, 0x48, 0x38, 0x00, 0x00,
+  0x00, 0x00, 0xC8, 0x48, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0xD8, 0xA8, 0xA8, 0x50, 0x00, 0x00,
+  0x00, 0x00, 0x48, 0x30, 0x30, 0x48, 0x00, 0x00, 0x00, 0x00, 0xD8, 0x50, 0x50, 0x20, 0x20, 0x60,
+  0x00, 0x00, 0x78, 0x50, 0x28, 0x78, 0x00, 0x00, 0x10, 0x20, 0x20, 0x60, 0x20, 0x20, 0x10, 0x00,
+  0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x20, 0x00, 0x40, 0x20, 0x20, 0x30, 0x20, 0x20, 0x40, 0x00,
+  0x00, 0x00, 0x00, 0x28, 0x50, 0x00, 0x00, 0x00,
+};
+
+sFONT Font8 = {
+  Font8_Table,
+  5, /* Width */
+  8, /* Height */
+  0, /* Packed */
+};
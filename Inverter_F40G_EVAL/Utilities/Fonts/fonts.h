@@ -52,6 +52,7 @@ typedef struct _tFont
   const uint8_t *table;
   uint16_t Width;
   uint16_t Height;
+  const uint16_t *Packed;  /* Glyph offsets into a run-length packed table, NULL for raw bitmaps */
 } sFONT;
 
 extern sFONT Font24;
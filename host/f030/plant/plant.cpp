@@ -0,0 +1,452 @@
+/**
+ * @file plant.cpp
+ * @brief Power stage model fed by the timer outputs, read back by the ADC.
+ */
+
+#include "plant.h"
+
+#include "stm32f0xx.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+
+namespace host {
+
+namespace {
+
+const double ADC_VREF = 3.3;
+const int    ADC_FULL = 4095;
+
+// Dead time in timer ticks from BDTR.DTG (tDTS = tCK_INT)
+unsigned DeadTicks(uint32_t bdtr)
+{
+    uint32_t dtg = bdtr & TIM_BDTR_DTG;
+    if ((dtg & 0x80u) == 0)
+        return dtg;
+    if ((dtg & 0xC0u) == 0x80u)
+        return (64u + (dtg & 0x3Fu)) * 2u;
+    if ((dtg & 0xE0u) == 0xC0u)
+        return (32u + (dtg & 0x1Fu)) * 8u;
+    return (32u + (dtg & 0x1Fu)) * 16u;
+}
+
+bool Driven(const TimerOut &o)
+{
+    return (o.bdtr & TIM_BDTR_MOE) && (o.ccer & TIM_CCER_CC1E) && (o.ccer & TIM_CCER_CC1NE);
+}
+
+// Gate state of one leg at counter value cnt: 1 high side on, -1 low side
+// on, 0 both off (dead time, or outputs idle). Upcounting PWM mode 1 is
+// high for cnt < CCR, mode 2 the inverse; each switch turns on dt ticks
+// after its edge.
+int Leg(const TimerOut &o, uint32_t cnt, unsigned dt)
+{
+    if (!Driven(o))
+        return 0;
+
+    bool     mode2  = ((o.ccmr1 & TIM_CCMR1_OC1M) >> TIM_CCMR1_OC1M_Pos) == 7;
+    uint32_t period = o.arr + 1;
+    uint32_t ccr    = o.ccr1;
+    if (ccr == 0 || ccr >= period)
+    {
+        bool ref = (ccr >= period) != mode2;
+        return ref ? 1 : -1;            // no edges, no dead time
+    }
+
+    int first = mode2 ? -1 : 1;         // side on in [dt, ccr)
+    if (cnt >= dt && cnt < ccr)
+        return first;
+    if (cnt >= ccr + dt)
+        return -first;
+    return 0;
+}
+
+// Next counter value after cnt at which Leg() can change, or period
+uint32_t NextEdge(const TimerOut &o, uint32_t cnt, unsigned dt)
+{
+    uint32_t period = o.arr + 1;
+    uint32_t next   = period;
+    if (!Driven(o) || o.ccr1 == 0 || o.ccr1 >= period)
+        return next;
+    const uint32_t edges[] = { dt, o.ccr1, o.ccr1 + dt };
+    for (uint32_t e : edges)
+        if (e > cnt && e < next)
+            next = e;
+    return next;
+}
+
+// Ticks from t until the counter of o reaches `count` (NEVER if stopped)
+Tick Until(const TimerOut &o, Tick t, uint32_t cnt, uint32_t count)
+{
+    if (!o.running || count <= cnt)
+        return NEVER;
+    // the prescaler phase: ticks already counted towards the next step
+    Tick done = (t - o.t0) % (o.psc + 1);
+    return (Tick)(count - cnt) * (o.psc + 1) - done;
+}
+
+} // namespace
+
+bool ParseLoad(const std::string &spec, PlantParams &p)
+{
+    std::vector<std::string> parts;
+    std::stringstream ss(spec);
+    for (std::string s; std::getline(ss, s, ':');)
+        parts.push_back(s);
+    if (parts.empty())
+        return false;
+
+    const std::string &kind = parts[0];
+    if (kind != "r" && kind != "rl" && kind != "rect" && kind != "lamp" && kind != "open")
+        return false;
+    p.load = kind;
+    if (parts.size() > 1)
+        p.r_load = atof(parts[1].c_str());
+    if (parts.size() > 2)
+    {
+        double v = atof(parts[2].c_str());
+        if (kind == "rl")
+            p.l_load = v;
+        else if (kind == "lamp")
+            p.lamp_tau = v;
+        else
+            p.c_dc = v;
+    }
+    return true;
+}
+
+Plant::Plant(const PlantParams &params, TimerSource src, unsigned step)
+    : p(params), timer(src), step_ticks(step ? step : 48), t_now(0), wave_every(0), next_wave(0),
+      i_l(0), v_c(0), i_m(0), i_ld(0), v_dc(0), heat(0), i_bat_f(0), e_in(0), e_out(0)
+{
+}
+
+// Leg voltage and whether it connects to the bus; sign = current leaving the node
+void Plant::Node(int state, double v_bus, int sign, double &v, bool &bus) const
+{
+    if (state == 1)
+    {
+        v = v_bus, bus = true;
+    }
+    else if (state == -1)
+    {
+        v = 0.0, bus = false;
+    }
+    else if (sign > 0)
+    {
+        // body diodes: current leaving the node comes up through the low side
+        v = -p.v_diode, bus = false;
+    }
+    else
+    {
+        v = v_bus + p.v_diode, bus = true;
+    }
+}
+
+// Bridge voltage, path resistance and bus connection (+1/0/-1) for gate
+// states a, b; false when nothing conducts
+bool Plant::Bridge(int a, int b, double v_bus, double &v, double &r, int &bus) const
+{
+    r = p.r_l + p.r_on * ((a != 0) + (b != 0));
+
+    auto solve = [&](int sign, double &vab, int &conn) {
+        double va, vb;
+        bool   a_bus, b_bus;
+        Node(a, v_bus, sign, va, a_bus);
+        Node(b, v_bus, -sign, vb, b_bus);
+        vab  = va - vb;
+        conn = (int)a_bus - (int)b_bus;
+    };
+
+    if ((a != 0 && b != 0) || std::fabs(i_l) > 1e-9)
+    {
+        solve(i_l >= 0 ? 1 : -1, v, bus);
+        return true;
+    }
+
+    // a leg is floating and the inductor is empty: conduct only if driven
+    solve(1, v, bus);
+    if (v - v_c > 0)
+        return true;
+    solve(-1, v, bus);
+    if (v - v_c < 0)
+        return true;
+    bus = 0;
+    return false;
+}
+
+// Primary-side load current; advances the load states by h
+double Plant::Load(double t, double h)
+{
+    double v_sec = p.n * v_c;
+    double i_sec = 0.0;
+
+    if (t < p.load_from)
+    {
+        i_sec = 0.0;
+    }
+    else if (p.load == "r")
+    {
+        i_sec = v_sec / p.r_load;
+    }
+    else if (p.load == "rl")
+    {
+        i_ld += h * (v_sec - p.r_load * i_ld) / p.l_load;
+        i_sec = i_ld;
+    }
+    else if (p.load == "rect")
+    {
+        double drive = std::fabs(v_sec) - v_dc - 2.0 * p.v_rect;
+        double i_dc  = drive > 0 ? drive / p.r_rect : 0.0;
+        v_dc += h * (i_dc - v_dc / p.r_load) / p.c_dc;
+        i_sec = std::copysign(i_dc, v_sec);
+    }
+    else if (p.load == "lamp")
+    {
+        double r     = p.r_load * (p.lamp_cold + (1.0 - p.lamp_cold) * heat);
+        i_sec        = v_sec / r;
+        double p_hot = p.lamp_v * p.lamp_v / p.r_load;
+        heat += h * (v_sec * i_sec / p_hot - heat) / p.lamp_tau;
+    }
+
+    e_out += h * v_sec * i_sec;
+    i_m   += h * (v_c - p.r_m * i_m) / p.l_m;
+    return p.n * i_sec + i_m;
+}
+
+// Advances the stage by h seconds (ending at t) with gate states a, b
+void Plant::Step(int a, int b, double t, double h)
+{
+    // battery sag from the previous step's current
+    double v_bus = p.vbat - p.r_bat * i_bat_f;
+
+    double v_ab, r;
+    int    bus;
+    double i_old = i_l;
+    if (!Bridge(a, b, v_bus, v_ab, r, bus))
+    {
+        i_l = 0.0;
+    }
+    else
+    {
+        double i_new = i_l + h * (v_ab - v_c - r * i_l) / p.l_f;
+        // diodes stop conducting at zero, they don't reverse the current
+        if ((a == 0 || b == 0) && i_new * i_l < 0)
+            i_new = 0.0;
+        i_l = i_new;
+    }
+
+    double i_pri = Load(t, h);
+    v_c += h * (i_l - i_pri) / p.c_f;
+
+    // trapezoidal: the ripple within a step is not small
+    double i_bus = bus * 0.5 * (i_old + i_l);
+    e_in    += h * p.vbat * i_bus;
+    i_bat_f += (i_bus - i_bat_f) * (h / (p.i_tau + h));
+}
+
+void Plant::Advance(Tick t)
+{
+    const double tick_s = 1.0 / CLOCK_HZ;
+
+    while (t_now < t)
+    {
+        TimerOut ta = timer(16), tb = timer(17);
+        unsigned da = DeadTicks(ta.bdtr), db = DeadTicks(tb.bdtr);
+        uint32_t ca = ta.Count(t_now), cb = tb.Count(t_now);
+        int      a  = Leg(ta, ca, da), b = Leg(tb, cb, db);
+
+        // on to the next edge of either leg
+        Tick end = t;
+        Tick ua  = Until(ta, t_now, ca, NextEdge(ta, ca, da));
+        Tick ub  = Until(tb, t_now, cb, NextEdge(tb, cb, db));
+        if (ua != NEVER && t_now + ua < end)
+            end = t_now + ua;
+        if (ub != NEVER && t_now + ub < end)
+            end = t_now + ub;
+
+        Tick   len = end - t_now;
+        Tick   n   = (len + step_ticks - 1) / step_ticks;
+        double h   = (double)len / (double)n;
+        for (Tick k = 1; k <= n; k++)
+        {
+            double tk = ((double)t_now + h * (double)k) * tick_s;
+            Step(a, b, tk, h * tick_s);
+            if (wave_every && t_now + (Tick)(h * (double)k) >= next_wave)
+            {
+                wave.push_back({ tk, VOut(), i_l });
+                next_wave += wave_every;
+            }
+        }
+        t_now = end;
+    }
+}
+
+uint16_t Plant::Pin(double v) const
+{
+    long code = lround(v / ADC_VREF * ADC_FULL);
+    return (uint16_t)std::min<long>(std::max<long>(code, 0), ADC_FULL);
+}
+
+uint16_t Plant::Code(int channel)
+{
+    double t = (double)t_now / CLOCK_HZ;
+
+    switch (channel)
+    {
+    case AIN_BAT_V:
+    {
+        double v = p.vbat - p.r_bat * i_bat_f;
+        long   c = lround(v / p.v_full * 4096.0);
+        return (uint16_t)std::min<long>(std::max<long>(c, 0), ADC_FULL);
+    }
+    case AIN_BAT_GND:
+        return 0;
+    case AIN_BAT_TEMP:
+        return p.temp_code;
+    case AIN_U_IN:
+        if (p.mains_peak <= 0)
+            return 2048;
+        return (uint16_t)lround(2048.0 + p.mains_peak * sin(2.0 * M_PI * p.mains_hz * t + p.mains_phase));
+    case AIN_BAT_LOAD:
+        return Pin(p.i_gain * i_bat_f);
+    case AIN_U_OUT:
+    {
+        uint16_t u = Pin(p.u_bias + p.u_gain * VOut() + p.u_offset);
+        uint16_t i = Pin(p.i_gain * i_bat_f);
+        TimerOut ta = timer(16), tb = timer(17);
+        samples.push_back({ t, VOut(), i_l, i_bat_f, u, i, ta.ccr1, tb.ccr1,
+                            (ta.bdtr & TIM_BDTR_MOE) ? 1 : 0, e_in, e_out,
+                            state_hook ? state_hook() : -1 });
+        return u;
+    }
+    default:
+        return 2048;
+    }
+}
+
+Metrics SteadyState(const Plant &plant, double settle_s, double until_s)
+{
+    Metrics m = {};
+    std::vector<const Plant::Sample *> rows;
+    for (const Plant::Sample &s : plant.samples)
+        if (s.t >= settle_s && s.t < until_s)
+            rows.push_back(&s);
+    rows.resize(rows.size() / 100 * 100);
+    if (rows.empty())
+        return m;
+
+    double sq = 0, sum = 0, pk = 0, il = 0, ib = 0;
+    for (const Plant::Sample *s : rows)
+    {
+        sq  += s->v_out * s->v_out;
+        sum += s->v_out;
+        pk   = std::max(pk, std::fabs(s->v_out));
+        il   = std::max(il, std::fabs(s->i_l));
+        ib  += s->i_bat;
+    }
+    double n     = (double)rows.size();
+    double e_in  = rows.back()->e_in - rows.front()->e_in;
+    double e_out = rows.back()->e_out - rows.front()->e_out;
+
+    m.valid     = true;
+    m.v_out_rms = std::sqrt(sq / n);
+    m.v_out_dc  = sum / n;
+    m.v_out_pk  = pk;
+    m.i_l_pk    = il;
+    m.i_bat_avg = ib / n;
+    m.v_dc      = plant.p.load == "rect" ? plant.VDc() : NAN;
+    m.eff       = e_in > 0 ? e_out / e_in : NAN;
+    return m;
+}
+
+bool Replay::Load(const std::string &text, double tail_ms, std::string &err)
+{
+    size_t begin = text.rfind("# pwmlog");
+    size_t stop  = (begin == std::string::npos) ? begin : text.find("# end", begin);
+    if (begin == std::string::npos || stop == std::string::npos)
+    {
+        err = "no pwmlog capture found";
+        return false;
+    }
+
+    std::string header = text.substr(begin, text.find('\n', begin) - begin);
+    unsigned    clock  = 1000000;
+    auto field = [&](const char *key, unsigned &v) {
+        size_t k = header.find(std::string(" ") + key + "=");
+        if (k != std::string::npos)
+            v = (unsigned)strtoul(header.c_str() + k + strlen(key) + 2, nullptr, 10);
+    };
+    field("arr", arr0);
+    field("deadtime", deadtime);
+    field("clock", clock);
+    Tick scale = CLOCK_HZ / clock;      // host/ captures count core clocks
+
+    long long t0 = -1;
+    for (size_t p = text.find('\n', begin) + 1; p < stop; p = text.find('\n', p) + 1)
+    {
+        long long t;
+        char      kind;
+        unsigned  a, b = 0;
+        if (sscanf(text.c_str() + p, "%lld,%c,%u,%u", &t, &kind, &a, &b) < 3)
+            continue;
+        if (t0 < 0)
+            t0 = t;
+        events.push_back({ (Tick)(t - t0) * scale, kind, a, b });
+    }
+
+    Tick last = 0;
+    bool bridge = false;
+    for (const Event &e : events)
+    {
+        last = std::max(last, e.t);
+        bridge |= (e.kind == 'B');
+    }
+    end = last + Ms(tail_ms);
+    if (!bridge || events.front().kind != 'B')
+        events.insert(events.begin(), { 0, 'B', 1, 1 });    // armed with the bridge running
+    return true;
+}
+
+void Replay::Run(Plant &plant)
+{
+    uint32_t ccr[2] = { (arr0 + 1) / 2, (arr0 + 1) / 2 }, arr = arr0, on = 0;
+    size_t   k = 0;
+
+    for (Tick t = 0; t < end;)
+    {
+        for (; k < events.size() && events[k].t <= t; k++)
+        {
+            const Event &e = events[k];
+            if (e.kind == 'C')
+                ccr[0] = e.a, ccr[1] = e.b;
+            else if (e.kind == 'A')
+                arr = e.a;
+            else if (e.kind == 'B')
+                on = e.a;
+        }
+        for (int i = 0; i < 2; i++)
+        {
+            TimerOut &o = cur[i];
+            o.running = true;
+            o.t0      = t;
+            o.cnt0    = 0;
+            o.psc     = 0;
+            o.arr     = arr;
+            o.ccr1    = ccr[i];
+            o.ccmr1   = (i == 0 ? 7u : 6u) << TIM_CCMR1_OC1M_Pos;
+            o.ccer    = TIM_CCER_CC1E | TIM_CCER_CC1NE;
+            o.bdtr    = (on ? TIM_BDTR_MOE : 0) | deadtime;
+        }
+        t += arr + 1;
+        plant.Advance(t);
+        if ((t / (48 * 200)) != ((t - arr - 1) / (48 * 200)))
+            plant.Code(AIN_U_OUT);          // a sample row per 200 us
+    }
+}
+
+} // namespace host
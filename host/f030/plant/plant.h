@@ -0,0 +1,172 @@
+#ifndef HOST_PLANT_H
+#define HOST_PLANT_H
+
+// Power stage behind TIM16/TIM17, as the firmware's ADC sees it.
+//
+// The stage follows the two timers at count level:
+//
+//   TIM16 CH1/CH1N  PWM mode 2   -> leg A (Q3H/Q4L)
+//   TIM17 CH1/CH1N  PWM mode 1   -> leg B (Q1H/Q2L)
+//
+// with the mode, compare value, period and dead time (BDTR.DTG) taken from
+// the timer model, so a preloaded ARR or CCR acts from the update event
+// that latches it. Outputs idle low while MOE = 0; during dead time and with
+// the bridge off each leg node follows its body diodes. Behind the bridge:
+//
+//   battery (Vbat, Rbat) -> H-bridge (Ron) -> L (RL) -> C -> transformer
+//   (ratio n, magnetising Lm) -> load: R, series R-L, a diode bridge into a
+//   smoothed DC load (rectifier), or a filament lamp whose resistance rises
+//   from cold as it heats (inrush)
+//
+// Intervals between switching edges are integrated with steps of at most
+// step_ticks. The ADC channels the firmware reads are fed back from the
+// stage: ADC_U_OUT (output divider), ADC_BAT_LOAD (current sense, filtered),
+// ADC_BAT_V (battery terminal voltage after the sag), plus a fixed NTC code
+// and an optional synthetic mains on ADC_U_IN. The divider and shunt
+// scalings are placeholders until matched to the schematic.
+
+#include "board.h"
+
+#include <cmath>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace host {
+
+struct PlantParams {
+    double vbat      = 12.6;        // V, open-circuit battery voltage
+    double r_bat     = 0.02;        // ohm, battery + wiring
+    double r_on      = 0.01;        // ohm per conducting MOSFET
+    double v_diode   = 0.8;         // V, MOSFET body diode
+    double l_f       = 100e-6;      // H, output filter inductor
+    double r_l       = 0.03;        // ohm, inductor winding
+    double c_f       = 47e-6;       // F, output filter capacitor
+    double n         = 1.0;         // transformer ratio (secondary / primary)
+    double l_m       = 20e-3;       // H, magnetising inductance (primary)
+    double r_m       = 0.05;        // ohm, primary winding (limits DC in Lm)
+    std::string load = "r";         // r | rl | rect | lamp | open
+    double r_load    = 10.0;        // ohm, secondary side
+    double l_load    = 10e-3;       // H, series inductance for "rl"
+    double c_dc      = 470e-6;      // F, rectifier reservoir for "rect"
+    double r_rect    = 0.5;         // ohm, rectifier path resistance
+    double v_rect    = 0.8;         // V per rectifier diode
+    double lamp_cold = 0.1;         // cold / hot filament resistance
+    double lamp_tau  = 0.1;         // s, filament heating time constant
+    double lamp_v    = 8.5;         // V rms at which r_load is the hot resistance
+    double load_from = 0.0;         // s, load disconnected (open) before this
+
+    // ADC front ends (placeholders until matched to the schematic)
+    double u_gain    = 0.05;        // V at the pin per V of output (sign: divider polarity)
+    double u_bias    = 1.65;        // V at the pin for 0 V output
+    double u_offset  = 0.0;         // V, offset error of the output sense
+    double i_gain    = 0.1;         // V at the pin per A of battery current
+    double i_tau     = 100e-6;      // s, current sense filter
+    double v_full    = 20.0;        // V of battery for a full-scale ADC_BAT_V (battery.h)
+    uint16_t temp_code = 2051;      // ADC_BAT_TEMP: 25 degC (thermal.c table)
+
+    // synthetic mains on ADC_U_IN: peak in codes about 2048 (0 = none)
+    double mains_peak  = 0.0;
+    double mains_hz    = 50.0;
+    double mains_phase = 0.0;       // rad at t = 0
+};
+
+// "r:10", "rl:10:0.02", "rect:20[:Cdc]", "lamp:10[:tau]", "open" into p;
+// false for an unknown load
+bool ParseLoad(const std::string &spec, PlantParams &p);
+
+// Gate drive source: the timer outputs at the current time
+typedef std::function<TimerOut(int timer)> TimerSource;
+
+class Plant : public Analog {
+public:
+    // One row per ADC scan (at its ADC_U_OUT conversion); energies so far
+    struct Sample {
+        double   t, v_out, i_l, i_bat;
+        uint16_t adc_u, adc_i;
+        uint32_t ccr16, ccr17;
+        int      bridge;
+        double   e_in, e_out;
+        int      state;             // SineGen_GetState() if a hook is set, else -1
+    };
+    struct WavePoint {
+        double t, v_out, i_l;
+    };
+
+    explicit Plant(const PlantParams &p, TimerSource timer = Timer, unsigned step_ticks = 48);
+
+    void     Advance(Tick t) override;
+    uint16_t Code(int channel) override;
+
+    // Output waveform rows every `ticks` (0: none)
+    void WaveEvery(Tick ticks) { wave_every = ticks; next_wave = 0; }
+    // Firmware state to put in the samples
+    void StateHook(std::function<int()> fn) { state_hook = fn; }
+
+    double VOut() const { return p.n * v_c; }
+    double VDc() const { return v_dc; }
+    double IBat() const { return i_bat_f; }
+
+    std::vector<Sample>    samples;
+    std::vector<WavePoint> wave;
+
+    const PlantParams p;
+
+private:
+    TimerSource timer;
+    unsigned    step_ticks;
+    Tick        t_now;
+    Tick        wave_every, next_wave;
+    std::function<int()> state_hook;
+
+    // stage state
+    double i_l;                     // filter inductor current, leg A -> leg B
+    double v_c;                     // filter capacitor = transformer primary
+    double i_m;                     // magnetising current
+    double i_ld;                    // "rl" load current (secondary)
+    double v_dc;                    // "rect" reservoir voltage
+    double heat;                    // "lamp" filament temperature, 0 cold .. 1 hot at lamp_v
+    double i_bat_f;                 // filtered battery current (current sense)
+    double e_in, e_out;             // accumulated energy, J
+
+    void   Node(int state, double v_bus, int sign, double &v, bool &bus) const;
+    bool   Bridge(int a, int b, double v_bus, double &v, double &r, int &bus) const;
+    double Load(double t, double h);
+    void   Step(int a, int b, double t, double h);
+    uint16_t Pin(double v) const;
+};
+
+// Steady-state figures over whole 50 Hz cycles (100 samples) from settle_s
+// on, up to until_s
+struct Metrics {
+    bool   valid;
+    double v_out_rms, v_out_dc, v_out_pk, i_l_pk, i_bat_avg, v_dc, eff;
+};
+Metrics SteadyState(const Plant &plant, double settle_s, double until_s = HUGE_VAL);
+
+// Gate drive from a pwmlog capture (App/pwmlog.c or Pwmlog()) instead of the
+// firmware: a free-running pair of timers taking the last CCR and ARR values
+// written at each update event, the bridge switched at the period boundaries
+class Replay {
+public:
+    bool     Load(const std::string &text, double tail_ms, std::string &err);
+    TimerOut Timer(int n) const { return n == 16 ? cur[0] : cur[1]; }
+    Tick     End() const { return end; }
+    void     Run(Plant &plant);     // plant built with the Timer() of this
+
+private:
+    struct Event {
+        Tick     t;
+        char     kind;
+        uint32_t a, b;
+    };
+    std::vector<Event> events;
+    uint32_t deadtime = 75;
+    uint32_t arr0     = 2999;
+    Tick     end      = 0;
+    TimerOut cur[2]   = {};
+};
+
+} // namespace host
+
+#endif // HOST_PLANT_H
@@ -0,0 +1,432 @@
+/**
+ * @file board.cpp
+ * @brief Virtual clock, interrupts and run control of the F030 host harness.
+ *
+ * Firmware_Main() is main.c's main() (built with -Dmain=Firmware_Main). It
+ * runs on the host stack; interrupts are plain calls of the handler from
+ * the point where they are taken, the end of the run is a siglongjmp() out
+ * of HAL_GetTick(). HAL_GetTick() and HAL_InitTick() replace the weak HAL
+ * ones: the tick comes from the virtual clock, SysTick is not modelled.
+ */
+
+#include "sim.h"
+
+#include "stm32f0xx_hal.h"
+
+#include <csetjmp>
+#include <cstdio>
+#include <map>
+
+extern "C" int  Firmware_Main(void);
+extern "C" void TIM6_IRQHandler(void);
+
+namespace host {
+namespace sim {
+
+Options  opt;
+Analog  *analog;
+Tick     now;
+bool     in_isr;
+bool     stepping;
+uint32_t isr_now;
+uint32_t primask;
+
+std::vector<Write> writes;
+std::vector<Latch> latches;
+std::vector<Pin>   pins;
+
+namespace {
+
+const unsigned ENTRY_TICKS = 16;    // exception entry and exit (Cortex-M0)
+const unsigned EXIT_TICKS  = 12;
+
+FixedAnalog  fixed;
+sigjmp_buf   finish;
+uint32_t     isr_count;
+bool         in_call;               // running a scheduled call
+std::multimap<Tick, std::function<void()>> calls;
+
+struct Vector {
+    int irqn;
+    void (*handler)(void);
+};
+const Vector vectors[] = {
+    { TIM6_IRQn, TIM6_IRQHandler },
+};
+
+__attribute__((noinline)) void TrapOn()
+{
+    __asm__ volatile("pushfq; orq $0x100, (%%rsp); popfq" ::: "memory", "cc");
+}
+
+__attribute__((noinline)) void TrapOff()
+{
+    __asm__ volatile("pushfq; andq $~0x100, (%%rsp); popfq" ::: "memory", "cc");
+}
+
+void Isr(int irqn)
+{
+    void (*handler)(void) = nullptr;
+    for (const Vector &v : vectors)
+        if (v.irqn == irqn)
+            handler = v.handler;
+    if (!handler)
+        Fatal("no handler for IRQ %d", irqn);
+
+    in_isr  = true;
+    isr_now = ++isr_count;
+    Charge(ENTRY_TICKS);
+    if (opt.step_ticks)
+    {
+        stepping = true;
+        TrapOn();
+        handler();
+        stepping = false;
+        TrapOff();
+    }
+    else
+    {
+        handler();
+    }
+    Charge(EXIT_TICKS);
+    isr_now = 0;
+    in_isr  = false;
+}
+
+// Clock for one main loop pass. A pass that wrote nothing and saw no ISR is
+// waiting for something: go on to the next peripheral event, scheduled call
+// or HAL tick, whichever comes first.
+void Poll()
+{
+    static size_t   last_writes;
+    static uint32_t last_isrs;
+    bool idle = opt.idle_skip && writes.size() == last_writes && isr_count == last_isrs;
+    last_writes = writes.size();
+    last_isrs   = isr_count;
+
+    Tick to = now + opt.poll_ticks;
+    if (idle)
+    {
+        Tick t = (now / (CLOCK_HZ / 1000) + 1) * (CLOCK_HZ / 1000);
+        Tick e = NextEvent();
+        if (e < t)
+            t = e;
+        if (!calls.empty() && calls.begin()->first < t)
+            t = calls.begin()->first;
+        if (opt.end < t)
+            t = opt.end;
+        if (t > to)
+            to = t;
+    }
+    Advance(to);
+}
+
+// Main loop side of HAL_GetTick(): scheduled calls, interrupts, the end
+void MainPoint()
+{
+    Poll();
+    if (primask)
+        return;
+    Dispatch();
+    if (in_call)
+        return;
+
+    while (!calls.empty() && calls.begin()->first <= now)
+    {
+        std::function<void()> fn = calls.begin()->second;
+        calls.erase(calls.begin());
+        in_call = true;
+        fn();
+        in_call = false;
+        Dispatch();
+    }
+    if (now >= opt.end)
+        siglongjmp(finish, 1);
+}
+
+} // namespace
+
+void Advance(Tick to)
+{
+    for (;;)
+    {
+        Tick t = NextEvent();
+        if (t > to)
+            break;
+        if (t > now)
+        {
+            now = t;
+            analog->Advance(now);
+        }
+        FireEvents();
+    }
+    if (to > now)
+        now = to;
+    analog->Advance(now);
+}
+
+void Charge(unsigned ticks)
+{
+    Advance(now + ticks);
+}
+
+void Dispatch()
+{
+    while (!in_isr && !primask)
+    {
+        int irqn = PendingIrq();
+        if (irqn < 0)
+            return;
+        Isr(irqn);
+    }
+}
+
+} // namespace sim
+
+using namespace sim;
+
+FixedAnalog::FixedAnalog()
+{
+    for (uint16_t &c : code)
+        c = 0;
+    code[AIN_BAT_V]    = 2580;      // 12.6 V, 20 V full scale
+    code[AIN_BAT_TEMP] = 2051;      // 25 degC (thermal.c table)
+    code[AIN_U_IN]     = 2048;      // no mains: bias only
+    code[AIN_30V]      = 2048;
+    code[AIN_U_OUT]    = 2048;      // 0 V
+}
+
+void Run(const Options &o)
+{
+    static bool ran;
+    if (ran)
+        Fatal("one Run() per process");
+    ran = true;
+
+    opt    = o;
+    analog = o.analog ? o.analog : &fixed;
+    MapRegisters();
+    Reset();
+
+    if (sigsetjmp(finish, 1) == 0)
+        Firmware_Main();
+    primask = 0;
+    in_call = false;
+}
+
+Tick Now()
+{
+    return now;
+}
+
+void At(Tick t, std::function<void()> fn)
+{
+    calls.emplace(t, std::move(fn));
+}
+
+uint32_t Isr()
+{
+    return isr_now;
+}
+
+uint32_t IsrCount()
+{
+    return isr_count;
+}
+
+const std::vector<Write> &Writes()
+{
+    return writes;
+}
+
+const std::vector<Latch> &Latches()
+{
+    return latches;
+}
+
+const std::vector<Pin> &Pins()
+{
+    return pins;
+}
+
+const std::vector<Byte> &UartOut(int n)
+{
+    return UartBytes(n);
+}
+
+std::string UartText(int n)
+{
+    std::string s;
+    for (const Byte &b : UartBytes(n))
+        s += (char)b.b;
+    return s;
+}
+
+TimerOut Timer(int n)
+{
+    return TimerState(n);
+}
+
+std::string RegName(uint32_t addr)
+{
+    static const struct {
+        uint32_t    base;
+        const char *name;
+    } blocks[] = {
+        { TIM1_BASE, "TIM1" }, { TIM6_BASE, "TIM6" }, { TIM16_BASE, "TIM16" },
+        { TIM17_BASE, "TIM17" }, { ADC1_BASE, "ADC1" }, { USART1_BASE, "USART1" },
+        { USART2_BASE, "USART2" }, { GPIOA_BASE, "GPIOA" }, { GPIOB_BASE, "GPIOB" },
+        { GPIOC_BASE, "GPIOC" }, { GPIOF_BASE, "GPIOF" },
+    };
+    struct Name {
+        uint32_t    off;
+        const char *name;
+    };
+    static const Name tim_regs[] = {
+        { 0x00, "CR1" }, { 0x04, "CR2" }, { 0x0C, "DIER" }, { 0x10, "SR" }, { 0x14, "EGR" },
+        { 0x18, "CCMR1" }, { 0x20, "CCER" }, { 0x24, "CNT" }, { 0x28, "PSC" }, { 0x2C, "ARR" },
+        { 0x30, "RCR" }, { 0x34, "CCR1" }, { 0x44, "BDTR" }, { 0, nullptr },
+    };
+    static const Name adc_regs[] = {
+        { 0x00, "ISR" }, { 0x04, "IER" }, { 0x08, "CR" }, { 0x0C, "CFGR1" }, { 0x14, "SMPR" },
+        { 0x28, "CHSELR" }, { 0x40, "DR" }, { 0, nullptr },
+    };
+    static const Name usart_regs[] = {
+        { 0x00, "CR1" }, { 0x0C, "BRR" }, { 0x1C, "ISR" }, { 0x20, "ICR" }, { 0x28, "TDR" },
+        { 0, nullptr },
+    };
+    static const Name gpio_regs[] = {
+        { 0x14, "ODR" }, { 0x18, "BSRR" }, { 0x28, "BRR" }, { 0, nullptr },
+    };
+    for (const auto &b : blocks)
+    {
+        if ((addr & ~0x3FFu) != b.base)
+            continue;
+        std::string name = b.name;
+        const Name *regs = name.compare(0, 3, "TIM") == 0   ? tim_regs
+                         : name.compare(0, 3, "ADC") == 0   ? adc_regs
+                         : name.compare(0, 5, "USART") == 0 ? usart_regs
+                                                            : gpio_regs;
+        for (const Name *r = regs; r->name; r++)
+            if (r->off == (addr & 0x3FF))
+                return name + "->" + r->name;
+        char off[16];
+        snprintf(off, sizeof(off), "+0x%02X", addr & 0x3FF);
+        return name + off;
+    }
+    return "";
+}
+
+std::string Pwmlog()
+{
+    const uint32_t ccr16 = TIM16_BASE + offsetof(TIM_TypeDef, CCR1);
+    const uint32_t ccr17 = TIM17_BASE + offsetof(TIM_TypeDef, CCR1);
+    const uint32_t arr16 = TIM16_BASE + offsetof(TIM_TypeDef, ARR);
+    const uint32_t arr17 = TIM17_BASE + offsetof(TIM_TypeDef, ARR);
+    const uint32_t bdt16 = TIM16_BASE + offsetof(TIM_TypeDef, BDTR);
+    const uint32_t bdt17 = TIM17_BASE + offsetof(TIM_TypeDef, BDTR);
+    const uint32_t arr6  = TIM6_BASE + offsetof(TIM_TypeDef, ARR);
+
+    uint32_t c16 = 0, c17 = 0, a16 = 0xFFFF, a17 = 0xFFFF, m16 = 0, m17 = 0;
+    uint32_t arr = 0, fs = 0;
+    for (const Write &w : writes)
+    {
+        if (w.addr == arr6 && fs == 0)
+            fs = 1000000u / (w.value + 1);
+        if (w.addr == arr16)
+            a16 = w.value;
+        if (w.addr == bdt16 && (w.value & TIM_BDTR_MOE) && arr == 0)
+            arr = a16;
+    }
+
+    std::string out;
+    char line[96];
+    snprintf(line, sizeof(line), "# pwmlog arr=%u deadtime=%u fs=%u decim=1 clock=%u\n",
+             arr ? arr : a16, (unsigned)(Word(bdt16) & TIM_BDTR_DTG), fs, CLOCK_HZ);
+    out += line;
+
+    a16 = 0xFFFF;
+    for (const Write &w : writes)
+    {
+        unsigned long long t = (unsigned long long)w.t;
+        if (w.addr == ccr16 || w.addr == ccr17)
+        {
+            (w.addr == ccr16 ? c16 : c17) = w.value & 0xFFFF;
+            snprintf(line, sizeof(line), "%llu,C,%u,%u\n", t, c16, c17);
+        }
+        else if (w.addr == arr16 || w.addr == arr17)
+        {
+            (w.addr == arr16 ? a16 : a17) = w.value & 0xFFFF;
+            snprintf(line, sizeof(line), "%llu,A,%u,%u\n", t, a16, a17);
+        }
+        else if (w.addr == bdt16 || w.addr == bdt17)
+        {
+            uint32_t &m = (w.addr == bdt16) ? m16 : m17;
+            uint32_t on = (w.value & TIM_BDTR_MOE) ? 1 : 0;
+            if (on == m)
+                continue;
+            m = on;
+            snprintf(line, sizeof(line), "%llu,B,%u,%u\n", t, m16, m17);
+        }
+        else
+        {
+            continue;
+        }
+        out += line;
+    }
+    out += "# end\n";
+    return out;
+}
+
+} // namespace host
+
+// --- core and HAL hooks (C linkage) -------------------------------------------
+
+using namespace host;
+using namespace host::sim;
+
+extern "C" {
+
+void Host_EnableIrq(void)
+{
+    primask = 0;
+    Dispatch();
+}
+
+void Host_DisableIrq(void)
+{
+    primask = 1;
+}
+
+uint32_t Host_GetPrimask(void)
+{
+    return primask;
+}
+
+void Host_SetPrimask(uint32_t mask)
+{
+    primask = mask & 1;
+    Dispatch();
+}
+
+void Host_Wfi(void)
+{
+    Tick t = NextEvent();
+    Advance(t == NEVER ? now + opt.poll_ticks : t);
+    Dispatch();
+}
+
+uint32_t HAL_GetTick(void)
+{
+    if (!in_isr)
+        MainPoint();
+    return (uint32_t)(now / (CLOCK_HZ / 1000));
+}
+
+HAL_StatusTypeDef HAL_InitTick(uint32_t TickPriority)
+{
+    (void)TickPriority;
+    return HAL_OK;
+}
+
+} // extern "C"
@@ -0,0 +1,164 @@
+#ifndef HOST_BOARD_H
+#define HOST_BOARD_H
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Host run of the F030 firmware: the real Core/Src, App and HAL sources
+// against a register file that stands in for the peripherals.
+//
+// The peripheral address ranges (0x40000000, the GPIO ports at 0x48000000
+// and the core peripherals at 0xE000E000) are mapped at their real
+// addresses without access rights. Every load or store of the firmware
+// traps: the harness advances the virtual clock, brings the register up to
+// date (counter values, flags), lets the one instruction through and then
+// hands the written value to the peripheral model. The models cover what the
+// firmware uses:
+//
+//   - TIM1/6/16/17: counter, prescaler, ARR and CCR1 preload latched at the
+//     update event, UIF and the update interrupt, EGR UG
+//   - ADC1 with DMA1 channel 1: calibration, enable, scans of the CHSELR
+//     channels at the SMPR sampling time, results written to CMAR
+//   - USART1/2: TXE/TC/TEACK/REACK and a byte time from BRR; sent bytes kept
+//   - RCC ready flags and clock switch, GPIO BSRR/BRR, NVIC ISER/ICER
+//   - everything else is plain memory
+//
+// Time is counted in core clock cycles (48 MHz). A trapped access costs
+// bus_ticks, HAL_GetTick() poll_ticks (a main loop pass that neither wrote
+// a register nor saw an ISR goes on to the next peripheral event, scheduled
+// call or millisecond instead); with step_ticks the TIM6 interrupt is
+// single-stepped and every x86 instruction costs step_ticks as well, a proxy
+// for the code time inside the ISR (~1.5 ms of host time per ISR). Interrupts
+// are taken after any trapped access or HAL_GetTick() outside a critical
+// section, and on __enable_irq(); they do not nest.
+//
+// The firmware statics are set up once, so there is one Run() per process.
+
+namespace host {
+
+typedef uint64_t Tick;
+
+const uint32_t CLOCK_HZ = 48000000;
+const Tick     NEVER    = ~(Tick)0;
+
+inline Tick Us(double us) { return (Tick)(us * (CLOCK_HZ / 1000000) + 0.5); }
+inline Tick Ms(double ms) { return (Tick)(ms * (CLOCK_HZ / 1000) + 0.5); }
+inline double ToMs(Tick t) { return (double)t * 1000.0 / CLOCK_HZ; }
+
+// ADC input channel numbers of the board (adcin.h)
+enum AdcPin {
+    AIN_BAT_V    = 0,
+    AIN_BAT_GND  = 1,
+    AIN_BAT_TEMP = 2,
+    AIN_U_IN     = 3,
+    AIN_30V      = 6,
+    AIN_BAT_LOAD = 7,
+    AIN_U_OUT    = 9,
+};
+
+// What the ADC converts. Advance() is called with non-decreasing times
+// before any change of the timer outputs and before each conversion.
+class Analog {
+public:
+    virtual ~Analog() {}
+    virtual void     Advance(Tick t) = 0;
+    virtual uint16_t Code(int channel) = 0;
+};
+
+// Fixed codes per channel; the default front end (12.6 V battery, 25 degC,
+// no mains, no load, 0 V output)
+class FixedAnalog : public Analog {
+public:
+    FixedAnalog();
+    void     Advance(Tick) override {}
+    uint16_t Code(int channel) override { return code[channel & 31]; }
+    uint16_t code[32];
+};
+
+struct Options {
+    Tick     end        = Ms(100);
+    unsigned bus_ticks  = 2;        // per trapped register access
+    unsigned poll_ticks = 24;       // per HAL_GetTick() in the main loop
+    unsigned step_ticks = 0;        // >0: single-step the ISR, per instruction
+    bool     idle_skip  = true;     // main loop waiting: on to the next event
+    Analog  *analog     = nullptr;  // FixedAnalog when null
+};
+
+// One store of the firmware to a peripheral register: the value written (not
+// the register contents after it), the ISR it came from (1, 2 ... ; 0 for
+// the main loop)
+struct Write {
+    Tick     t;
+    uint32_t addr;
+    uint32_t value;
+    uint32_t isr;
+};
+
+// One update event of TIM16 or TIM17: the values taken into the shadow
+// registers and the ISR that wrote each of them (0: main loop)
+struct Latch {
+    Tick     t;
+    int      timer;                 // 16 or 17
+    uint32_t arr, ccr1;
+    uint32_t arr_isr, ccr_isr;
+};
+
+// A change of a GPIO output register
+struct Pin {
+    Tick     t;
+    char     port;                  // 'A' ...
+    uint32_t odr;
+};
+
+// Output stage view of a timer, for the plant
+struct TimerOut {
+    bool     running;
+    Tick     t0;                    // counter was cnt0 at t0
+    uint32_t cnt0;
+    uint32_t psc, arr, ccr1;        // active values
+    uint32_t ccmr1, ccer, bdtr;
+    uint32_t Count(Tick t) const;
+};
+
+// Runs Firmware_Main() (main.c) until opt.end; returns at the first
+// HAL_GetTick() of the main loop at or after it
+void Run(const Options &opt);
+
+Tick Now();
+
+// Calls fn in the main loop (inside HAL_GetTick()) at the first call at or
+// after t; use for the firmware's runtime API (SineGen_Stop() ...)
+void At(Tick t, std::function<void()> fn);
+
+// Called from the TIM6 ISR path: number of the ISR running, 0 outside
+uint32_t Isr();
+uint32_t IsrCount();
+
+const std::vector<Write> &Writes();
+const std::vector<Latch> &Latches();
+const std::vector<Pin>   &Pins();
+
+// Bytes sent on a USART (1 or 2) with the time their stop bit ended
+struct Byte {
+    Tick    t;
+    uint8_t b;
+};
+const std::vector<Byte> &UartOut(int n);
+std::string UartText(int n);
+
+TimerOut Timer(int n);
+
+// Register address names for traces (TIM16->CCR1 ...), empty if unknown
+std::string RegName(uint32_t addr);
+
+// pwmlog CSV (App/pwmlog.h) of the run so far, timestamps in core clock
+// cycles (header field clock=48000000): a C row at every CCR1 write of
+// TIM16 or TIM17 with both preload values after it, an A row at every ARR
+// write with both, a B row at every change of the two MOE bits with both
+std::string Pwmlog();
+
+} // namespace host
+
+#endif // HOST_BOARD_H
@@ -0,0 +1,641 @@
+/**
+ * @file periph.cpp
+ * @brief Peripheral models behind the register file.
+ *
+ * Each model keeps what the registers do not show (timer shadow registers,
+ * the counter start time, the ADC sequence position, the UART shift
+ * register) and a next-event time; the clock fires events in time order.
+ * Register contents the firmware polls are kept current at the events, so
+ * a read only needs the timer counter computed.
+ */
+
+#include "sim.h"
+
+#include "stm32f0xx.h"
+
+#include <cstddef>
+
+namespace host {
+namespace sim {
+
+namespace {
+
+const uint32_t BLOCK = 0x400;
+
+// --- timers ---------------------------------------------------------------
+
+struct Tim {
+    uint32_t base;
+    int      id;
+    int      irqn;
+    bool     on;
+    Tick     t0;
+    uint32_t cnt0;
+    uint32_t psc, arr, ccr1;        // active (shadow) values
+    uint32_t arr_isr, ccr_isr;      // ISR of the latched values
+    uint32_t arr_pre_isr, ccr_pre_isr;
+    Tick     next;
+
+    TIM_TypeDef *R() const { return Reg<TIM_TypeDef>(base); }
+
+    uint32_t Count(Tick t) const
+    {
+        if (!on)
+            return cnt0;
+        return (uint32_t)((cnt0 + (t - t0) / (psc + 1)) & 0xFFFF);
+    }
+
+    // Moves t0 up to now, keeping the prescaler phase
+    void Rebase()
+    {
+        Tick steps = (now - t0) / (psc + 1);
+        cnt0 = (uint32_t)((cnt0 + steps) & 0xFFFF);
+        t0  += steps * (psc + 1);
+    }
+
+    void Schedule()
+    {
+        if (!on)
+        {
+            next = NEVER;
+            return;
+        }
+        // counts up to ARR; from above ARR it runs through 0xFFFF first
+        uint32_t steps = (cnt0 <= arr) ? arr - cnt0 + 1 : 0x10000 - cnt0 + arr + 1;
+        next = t0 + (Tick)steps * (psc + 1);
+    }
+
+    void Load()
+    {
+        TIM_TypeDef *r = R();
+        psc = r->PSC;
+        if (r->CR1 & TIM_CR1_ARPE)
+        {
+            arr     = r->ARR;
+            arr_isr = arr_pre_isr;
+        }
+        if (r->CCMR1 & TIM_CCMR1_OC1PE)
+        {
+            ccr1    = r->CCR1;
+            ccr_isr = ccr_pre_isr;
+        }
+        if (id == 16 || id == 17)
+            latches.push_back({ now, id, arr, ccr1, arr_isr, ccr_isr });
+    }
+
+    void Update(bool flag)
+    {
+        t0   = now;
+        cnt0 = 0;
+        if (!(R()->CR1 & TIM_CR1_UDIS))
+        {
+            Load();
+            if (flag)
+                R()->SR |= TIM_SR_UIF;
+        }
+        Schedule();
+    }
+
+    void Fire()
+    {
+        if (next <= now)
+            Update(true);
+    }
+
+    void Read(uint32_t off)
+    {
+        if (off == offsetof(TIM_TypeDef, CNT))
+            R()->CNT = Count(now);
+    }
+
+    void Write(uint32_t off, uint32_t old, uint32_t v)
+    {
+        TIM_TypeDef *r = R();
+        switch (off)
+        {
+        case offsetof(TIM_TypeDef, CR1):
+            if ((v & TIM_CR1_CEN) && !on)
+            {
+                on = true;
+                t0 = now;
+            }
+            else if (!(v & TIM_CR1_CEN) && on)
+            {
+                Rebase();
+                on = false;
+            }
+            Schedule();
+            break;
+        case offsetof(TIM_TypeDef, CNT):
+            cnt0 = v & 0xFFFF;
+            t0   = now;
+            Schedule();
+            break;
+        case offsetof(TIM_TypeDef, ARR):
+            arr_pre_isr = isr_now;
+            if (!(r->CR1 & TIM_CR1_ARPE))
+            {
+                arr     = v & 0xFFFF;
+                arr_isr = isr_now;
+                if (on)
+                    Rebase();
+                Schedule();
+            }
+            break;
+        case offsetof(TIM_TypeDef, CCR1):
+            ccr_pre_isr = isr_now;
+            if (!(r->CCMR1 & TIM_CCMR1_OC1PE))
+            {
+                ccr1    = v & 0xFFFF;
+                ccr_isr = isr_now;
+            }
+            break;
+        case offsetof(TIM_TypeDef, EGR):
+            r->EGR = 0;
+            if (v & TIM_EGR_UG)
+                Update(!(r->CR1 & TIM_CR1_URS));
+            break;
+        case offsetof(TIM_TypeDef, SR):
+            r->SR = old & v;        // rc_w0
+            break;
+        default:
+            break;
+        }
+    }
+
+    void Reset()
+    {
+        R()->ARR = 0xFFFF;
+        on   = false;
+        cnt0 = 0;
+        psc  = 0;
+        arr  = 0xFFFF;
+        ccr1 = 0;
+        next = NEVER;
+        arr_isr = ccr_isr = arr_pre_isr = ccr_pre_isr = 0;
+    }
+};
+
+Tim tims[] = {
+    { TIM1_BASE,  1,  TIM1_BRK_UP_TRG_COM_IRQn, false, 0, 0, 0, 0, 0, 0, 0, 0, 0, NEVER },
+    { TIM6_BASE,  6,  TIM6_IRQn,                false, 0, 0, 0, 0, 0, 0, 0, 0, 0, NEVER },
+    { TIM16_BASE, 16, TIM16_IRQn,               false, 0, 0, 0, 0, 0, 0, 0, 0, 0, NEVER },
+    { TIM17_BASE, 17, TIM17_IRQn,               false, 0, 0, 0, 0, 0, 0, 0, 0, 0, NEVER },
+};
+
+Tim *FindTim(uint32_t block)
+{
+    for (Tim &t : tims)
+        if (t.base == block)
+            return &t;
+    return nullptr;
+}
+
+// --- DMA1 channel 1 ---------------------------------------------------------
+
+struct Dma {
+    uint32_t reload;
+
+    DMA_Channel_TypeDef *C() const { return Reg<DMA_Channel_TypeDef>(DMA1_Channel1_BASE); }
+
+    void Request(uint16_t v)
+    {
+        DMA_Channel_TypeDef *c = C();
+        if (!(c->CCR & DMA_CCR_EN) || c->CNDTR == 0)
+            return;
+
+        uint32_t size = 1u << ((c->CCR & DMA_CCR_MSIZE) >> DMA_CCR_MSIZE_Pos);
+        uint32_t idx  = (c->CCR & DMA_CCR_MINC) ? reload - c->CNDTR : 0;
+        uintptr_t dst = (uintptr_t)c->CMAR + idx * size;
+        if (dst < 0x1000 || (dst >= 0x40000000u && dst < 0x50000000u))
+            Fatal("DMA1 channel 1 to 0x%lx", (unsigned long)dst);
+        if (size == 1)
+            *(volatile uint8_t *)dst = (uint8_t)v;
+        else if (size == 2)
+            *(volatile uint16_t *)dst = v;
+        else
+            *(volatile uint32_t *)dst = v;
+
+        if (--c->CNDTR == 0)
+        {
+            Reg<DMA_TypeDef>(DMA1_BASE)->ISR |= DMA_ISR_TCIF1 | DMA_ISR_GIF1;
+            if (c->CCR & DMA_CCR_CIRC)
+                c->CNDTR = reload;
+        }
+    }
+
+    void Write(uint32_t addr, uint32_t old, uint32_t v)
+    {
+        if (addr == DMA1_BASE + offsetof(DMA_TypeDef, IFCR))
+        {
+            Reg<DMA_TypeDef>(DMA1_BASE)->ISR &= ~v;
+            Word(addr) = 0;
+        }
+        else if (addr == DMA1_Channel1_BASE + offsetof(DMA_Channel_TypeDef, CNDTR))
+        {
+            if (C()->CCR & DMA_CCR_EN)
+                Word(addr) = old;   // read-only while enabled
+            else
+                reload = v & 0xFFFF;
+        }
+    }
+};
+
+Dma dma;
+
+// --- ADC1 ---------------------------------------------------------------------
+
+struct Adc {
+    Tick cal_at, en_at, dis_at, conv_at;
+    int  seq[19];
+    int  n, pos;
+
+    ADC_TypeDef *R() const { return Reg<ADC_TypeDef>(ADC1_BASE); }
+
+    Tick Next() const
+    {
+        Tick t = cal_at;
+        if (en_at < t)
+            t = en_at;
+        if (dis_at < t)
+            t = dis_at;
+        if (conv_at < t)
+            t = conv_at;
+        return t;
+    }
+
+    // sampling time + 12.5 ADC clocks (14 MHz HSI14)
+    Tick ConvTicks() const
+    {
+        static const unsigned half_cycles[] = { 3, 15, 27, 57, 83, 111, 143, 479 };
+        unsigned hc = half_cycles[R()->SMPR & ADC_SMPR_SMP] + 25;
+        return ((Tick)hc * CLOCK_HZ + 14000000) / 28000000;
+    }
+
+    void Start()
+    {
+        ADC_TypeDef *r = R();
+        n = 0;
+        for (int ch = 0; ch <= 18; ch++)
+            if (r->CHSELR & (1u << ch))
+                seq[n++] = ch;
+        if (r->CFGR1 & ADC_CFGR1_SCANDIR)
+            for (int i = 0; i < n / 2; i++)
+            {
+                int t = seq[i];
+                seq[i] = seq[n - 1 - i];
+                seq[n - 1 - i] = t;
+            }
+        pos = 0;
+        conv_at = n ? now + ConvTicks() : NEVER;
+        if (!n)
+            r->CR &= ~ADC_CR_ADSTART;
+    }
+
+    void Fire()
+    {
+        ADC_TypeDef *r = R();
+        if (cal_at <= now)
+        {
+            r->CR &= ~ADC_CR_ADCAL;
+            r->DR  = 0x40;          // calibration factor
+            cal_at = NEVER;
+        }
+        if (en_at <= now)
+        {
+            r->ISR |= ADC_ISR_ADRDY;
+            en_at = NEVER;
+        }
+        if (dis_at <= now)
+        {
+            r->CR &= ~(ADC_CR_ADEN | ADC_CR_ADDIS | ADC_CR_ADSTART);
+            conv_at = NEVER;
+            dis_at  = NEVER;
+        }
+        if (conv_at <= now)
+        {
+            uint16_t code = analog->Code(seq[pos]);
+            if (code > 4095)
+                code = 4095;
+            r->DR   = code;
+            r->ISR |= ADC_ISR_EOC;
+            if (r->CFGR1 & ADC_CFGR1_DMAEN)
+                dma.Request(code);
+            if (++pos >= n)
+            {
+                r->ISR |= ADC_ISR_EOS;
+                r->CR  &= ~ADC_CR_ADSTART;
+                conv_at = NEVER;
+            }
+            else
+            {
+                conv_at += ConvTicks();
+            }
+        }
+    }
+
+    void Write(uint32_t off, uint32_t old, uint32_t v)
+    {
+        ADC_TypeDef *r = R();
+        if (off == offsetof(ADC_TypeDef, ISR))
+        {
+            r->ISR = old & ~v;      // rc_w1
+        }
+        else if (off == offsetof(ADC_TypeDef, CR))
+        {
+            // set by software, cleared by hardware
+            const uint32_t bits = ADC_CR_ADCAL | ADC_CR_ADSTP | ADC_CR_ADSTART | ADC_CR_ADDIS | ADC_CR_ADEN;
+            uint32_t set = v & ~old & bits;
+            r->CR = old | set;
+            if ((set & ADC_CR_ADCAL) && !(old & ADC_CR_ADEN))
+                cal_at = now + Us(83.0 / 14.0);
+            if (set & ADC_CR_ADEN)
+                en_at = now + Us(1);
+            if (set & ADC_CR_ADDIS)
+                dis_at = now + Us(1);
+            if ((set & ADC_CR_ADSTART) && (old & ADC_CR_ADEN) && (r->ISR & ADC_ISR_ADRDY))
+                Start();
+            else if (set & ADC_CR_ADSTART)
+                r->CR &= ~ADC_CR_ADSTART;
+            if (set & ADC_CR_ADSTP)
+            {
+                conv_at = NEVER;
+                r->CR &= ~(ADC_CR_ADSTP | ADC_CR_ADSTART);
+            }
+        }
+    }
+
+    void Reset()
+    {
+        cal_at = en_at = dis_at = conv_at = NEVER;
+        n = pos = 0;
+    }
+};
+
+Adc adc;
+
+// --- USART1/2 -----------------------------------------------------------------
+
+struct Uart {
+    uint32_t base;
+    bool     busy;
+    bool     full;
+    uint8_t  shift, tdr;
+    Tick     next;
+    std::vector<Byte> out;
+
+    USART_TypeDef *R() const { return Reg<USART_TypeDef>(base); }
+
+    Tick ByteTicks() const
+    {
+        uint32_t brr = R()->BRR & 0xFFFF;
+        return 10 * (Tick)(brr ? brr : 417);
+    }
+
+    void Fire()
+    {
+        if (next > now)
+            return;
+        out.push_back({ now, shift });
+        if (full)
+        {
+            shift = tdr;
+            full  = false;
+            R()->ISR |= USART_ISR_TXE;
+            next += ByteTicks();
+        }
+        else
+        {
+            busy = false;
+            R()->ISR |= USART_ISR_TC;
+            next = NEVER;
+        }
+    }
+
+    void Write(uint32_t off, uint32_t old, uint32_t v)
+    {
+        USART_TypeDef *r = R();
+        switch (off)
+        {
+        case offsetof(USART_TypeDef, CR1):
+        {
+            uint32_t isr = r->ISR & ~(USART_ISR_TEACK | USART_ISR_REACK);
+            if ((v & USART_CR1_UE) && (v & USART_CR1_TE))
+                isr |= USART_ISR_TEACK;
+            if ((v & USART_CR1_UE) && (v & USART_CR1_RE))
+                isr |= USART_ISR_REACK;
+            r->ISR = isr;
+            break;
+        }
+        case offsetof(USART_TypeDef, ICR):
+            r->ISR &= ~(v & (USART_ICR_TCCF | USART_ICR_ORECF | USART_ICR_FECF | USART_ICR_NCF | USART_ICR_PECF));
+            r->ICR = 0;
+            break;
+        case offsetof(USART_TypeDef, TDR):
+            if (!(r->CR1 & USART_CR1_UE) || !(r->CR1 & USART_CR1_TE))
+                break;
+            if (!busy)
+            {
+                busy  = true;
+                shift = (uint8_t)v;
+                next  = now + ByteTicks();
+                r->ISR &= ~USART_ISR_TC;
+            }
+            else
+            {
+                tdr  = (uint8_t)v;
+                full = true;
+                r->ISR &= ~USART_ISR_TXE;
+            }
+            break;
+        default:
+            (void)old;
+            break;
+        }
+    }
+
+    void Reset()
+    {
+        R()->ISR = USART_ISR_TXE | USART_ISR_TC;
+        busy = full = false;
+        next = NEVER;
+        out.clear();
+    }
+};
+
+Uart uarts[] = {
+    { USART1_BASE, false, false, 0, 0, NEVER, {} },
+    { USART2_BASE, false, false, 0, 0, NEVER, {} },
+};
+
+// --- RCC, GPIO, NVIC ----------------------------------------------------------
+
+void RccWrite(uint32_t off, uint32_t v)
+{
+    RCC_TypeDef *r = Reg<RCC_TypeDef>(RCC_BASE);
+    switch (off)
+    {
+    case offsetof(RCC_TypeDef, CR):
+        // oscillators are ready at once
+        r->CR = (v & ~(RCC_CR_HSIRDY | RCC_CR_HSERDY | RCC_CR_PLLRDY)) |
+                ((v & RCC_CR_HSION) ? RCC_CR_HSIRDY : 0) |
+                ((v & RCC_CR_HSEON) ? RCC_CR_HSERDY : 0) |
+                ((v & RCC_CR_PLLON) ? RCC_CR_PLLRDY : 0);
+        break;
+    case offsetof(RCC_TypeDef, CR2):
+        r->CR2 = (v & ~RCC_CR2_HSI14RDY) | ((v & RCC_CR2_HSI14ON) ? RCC_CR2_HSI14RDY : 0);
+        break;
+    case offsetof(RCC_TypeDef, CSR):
+        r->CSR = (v & ~RCC_CSR_LSIRDY) | ((v & RCC_CSR_LSION) ? RCC_CSR_LSIRDY : 0);
+        break;
+    case offsetof(RCC_TypeDef, BDCR):
+        r->BDCR = (v & ~RCC_BDCR_LSERDY) | ((v & RCC_BDCR_LSEON) ? RCC_BDCR_LSERDY : 0);
+        break;
+    case offsetof(RCC_TypeDef, CFGR):
+        r->CFGR = (v & ~RCC_CFGR_SWS) | ((v & RCC_CFGR_SW) << 2);
+        break;
+    default:
+        break;
+    }
+}
+
+void GpioWrite(uint32_t block, uint32_t off, uint32_t old, uint32_t v)
+{
+    GPIO_TypeDef *g   = Reg<GPIO_TypeDef>(block);
+    uint32_t      odr = g->ODR;
+    switch (off)
+    {
+    case offsetof(GPIO_TypeDef, BSRR):
+        g->ODR  = (odr | (v & 0xFFFF)) & ~(v >> 16 & ~v & 0xFFFF);
+        g->BSRR = 0;
+        break;
+    case offsetof(GPIO_TypeDef, BRR):
+        g->ODR = odr & ~(v & 0xFFFF);
+        g->BRR = 0;
+        break;
+    case offsetof(GPIO_TypeDef, ODR):
+        odr = old;
+        break;
+    default:
+        return;
+    }
+    g->IDR = g->ODR;
+    if (g->ODR != odr)
+        pins.push_back({ now, (char)('A' + (block - GPIOA_BASE) / BLOCK), g->ODR });
+}
+
+uint32_t nvic_enabled;
+
+void NvicWrite(uint32_t addr, uint32_t v)
+{
+    if (addr == NVIC_BASE + offsetof(NVIC_Type, ISER))
+        nvic_enabled |= v;
+    else if (addr == NVIC_BASE + offsetof(NVIC_Type, ICER))
+        nvic_enabled &= ~v;
+    else
+        return;
+    Word(NVIC_BASE + offsetof(NVIC_Type, ISER)) = nvic_enabled;
+    Word(NVIC_BASE + offsetof(NVIC_Type, ICER)) = nvic_enabled;
+}
+
+} // namespace
+
+void Reset()
+{
+    for (Tim &t : tims)
+        t.Reset();
+    adc.Reset();
+    for (Uart &u : uarts)
+        u.Reset();
+    dma.reload = 0;
+    nvic_enabled = 0;
+    Reg<RCC_TypeDef>(RCC_BASE)->CR = RCC_CR_HSION | RCC_CR_HSIRDY | (16u << RCC_CR_HSITRIM_Pos);
+}
+
+Tick NextEvent()
+{
+    Tick t = adc.Next();
+    for (const Tim &m : tims)
+        if (m.next < t)
+            t = m.next;
+    for (const Uart &u : uarts)
+        if (u.next < t)
+            t = u.next;
+    return t;
+}
+
+void FireEvents()
+{
+    for (Tim &t : tims)
+        t.Fire();
+    adc.Fire();
+    for (Uart &u : uarts)
+        u.Fire();
+}
+
+void OnRead(uint32_t addr)
+{
+    if (Tim *t = FindTim(addr & ~(BLOCK - 1)))
+        t->Read(addr & (BLOCK - 1));
+}
+
+void OnWrite(uint32_t addr, uint32_t old, uint32_t v)
+{
+    writes.push_back({ now, addr, v, isr_now });
+
+    uint32_t block = addr & ~(BLOCK - 1), off = addr & (BLOCK - 1);
+    if (Tim *t = FindTim(block))
+        t->Write(off, old, v);
+    else if (block == ADC1_BASE)
+        adc.Write(off, old, v);
+    else if (block == DMA1_BASE)
+        dma.Write(addr, old, v);
+    else if (block == USART1_BASE)
+        uarts[0].Write(off, old, v);
+    else if (block == USART2_BASE)
+        uarts[1].Write(off, old, v);
+    else if (block == RCC_BASE)
+        RccWrite(off, v);
+    else if (block >= GPIOA_BASE && block <= GPIOF_BASE)
+        GpioWrite(block, off, old, v);
+    else if (block == (NVIC_BASE & ~(BLOCK - 1)))
+        NvicWrite(addr, v);
+}
+
+int PendingIrq()
+{
+    for (const Tim &t : tims)
+    {
+        TIM_TypeDef *r = t.R();
+        if ((r->SR & TIM_SR_UIF) && (r->DIER & TIM_DIER_UIE) && (nvic_enabled & (1u << t.irqn)))
+            return t.irqn;
+    }
+    return -1;
+}
+
+const std::vector<Byte> &UartBytes(int n)
+{
+    return uarts[n == 2 ? 1 : 0].out;
+}
+
+TimerOut TimerState(int n)
+{
+    for (const Tim &t : tims)
+        if (t.id == n)
+        {
+            TIM_TypeDef *r = t.R();
+            return { t.on, t.t0, t.cnt0, t.psc, t.arr, t.ccr1, r->CCMR1, r->CCER, r->BDTR };
+        }
+    Fatal("no TIM%d", n);
+}
+
+} // namespace sim
+
+uint32_t TimerOut::Count(Tick t) const
+{
+    if (!running)
+        return cnt0;
+    return (uint32_t)((cnt0 + (t - t0) / (psc + 1)) & 0xFFFF);
+}
+
+} // namespace host
@@ -0,0 +1,179 @@
+/**
+ * @file regs.cpp
+ * @brief Peripheral register file at the real addresses, with every access
+ *        trapped.
+ *
+ * One memfd holds all registers and is mapped twice: at the peripheral
+ * addresses without access rights, which is what the firmware sees, and
+ * read-write anywhere for the harness. The build is not position
+ * independent, so the firmware's 32-bit casts of RAM addresses (DMA CMAR)
+ * hold as well.
+ *
+ * An access of the firmware faults (SIGSEGV): the clock advances by
+ * bus_ticks, the register is brought up to date, its page is opened and the
+ * trap flag set. After the one instruction the single-step trap (SIGTRAP)
+ * closes the page again and hands a store to the models; a load-modify-store
+ * instruction counts as a store. Both handlers run with SA_NODEFER, so the
+ * ISR taken from the trap handler traps in its turn.
+ */
+
+#include "sim.h"
+
+#include <csignal>
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <sys/mman.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+namespace host {
+namespace sim {
+
+namespace {
+
+struct Region {
+    uint32_t base;
+    uint32_t size;
+    uint32_t off;                   // in the memfd
+};
+
+const Region regions[] = {
+    { 0x40000000u, 0x24000u, 0x00000u },    // APB, AHB1 (DMA, RCC, FLASH, CRC)
+    { 0x48000000u, 0x02000u, 0x24000u },    // GPIO ports
+    { 0xE000E000u, 0x01000u, 0x26000u },    // SysTick, NVIC, SCB
+};
+const uint32_t FILE_SIZE = 0x27000u;
+const uint32_t PAGE      = 0x1000u;
+const long     EFL_TF    = 0x100;
+const long     PF_WRITE  = 0x2;
+
+uint8_t *raw;
+
+struct Pending {
+    bool     active;
+    bool     store;
+    uint32_t word;
+    uint32_t old;
+};
+Pending pend;
+
+const Region *Find(uintptr_t addr)
+{
+    for (const Region &r : regions)
+        if (addr >= r.base && addr < (uintptr_t)r.base + r.size)
+            return &r;
+    return nullptr;
+}
+
+void Protect(uint32_t addr, int prot)
+{
+    if (mprotect((void *)(uintptr_t)(addr & ~(PAGE - 1)), PAGE, prot) != 0)
+        Fatal("mprotect 0x%08x: %s", addr, strerror(errno));
+}
+
+void OnFault(int, siginfo_t *si, void *ctx)
+{
+    ucontext_t *uc   = (ucontext_t *)ctx;
+    uintptr_t   addr = (uintptr_t)si->si_addr;
+    greg_t      pc   = uc->uc_mcontext.gregs[REG_RIP];
+
+    if (!Find(addr))
+        Fatal("access to 0x%lx outside the register file (pc 0x%llx)",
+              (unsigned long)addr, (unsigned long long)pc);
+    if (pend.active)
+        Fatal("second register access by one instruction at 0x%lx (pc 0x%llx)",
+              (unsigned long)addr, (unsigned long long)pc);
+
+    Charge(opt.bus_ticks);
+
+    uint32_t word = (uint32_t)addr & ~3u;
+    OnRead(word);
+    pend.active = true;
+    pend.store  = (uc->uc_mcontext.gregs[REG_ERR] & PF_WRITE) != 0;
+    pend.word   = word;
+    pend.old    = Word(word);
+
+    Protect(word, PROT_READ | PROT_WRITE);
+    uc->uc_mcontext.gregs[REG_EFL] |= EFL_TF;
+}
+
+void OnStep(int, siginfo_t *, void *ctx)
+{
+    ucontext_t *uc = (ucontext_t *)ctx;
+
+    if (pend.active)
+    {
+        Protect(pend.word, PROT_NONE);
+        pend.active = false;
+        uint32_t v = Word(pend.word);
+        if (pend.store || v != pend.old)
+            OnWrite(pend.word, pend.old, v);
+    }
+
+    if (stepping)
+    {
+        Charge(opt.step_ticks);
+        uc->uc_mcontext.gregs[REG_EFL] |= EFL_TF;
+        return;
+    }
+    uc->uc_mcontext.gregs[REG_EFL] &= ~EFL_TF;
+
+    // an interrupt due now preempts the code that made the access
+    Dispatch();
+}
+
+} // namespace
+
+void Fatal(const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    fputs("host: ", stderr);
+    vfprintf(stderr, fmt, ap);
+    fputc('\n', stderr);
+    va_end(ap);
+    signal(SIGABRT, SIG_DFL);
+    abort();
+}
+
+uint8_t *Raw(uint32_t addr)
+{
+    const Region *r = Find(addr);
+    if (!r)
+        Fatal("no register at 0x%08x", addr);
+    return raw + r->off + (addr - r->base);
+}
+
+void MapRegisters()
+{
+    int fd = memfd_create("f030-regs", 0);
+    if (fd < 0 || ftruncate(fd, FILE_SIZE) != 0)
+        Fatal("memfd: %s", strerror(errno));
+
+    raw = (uint8_t *)mmap(nullptr, FILE_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (raw == MAP_FAILED)
+        Fatal("mmap: %s", strerror(errno));
+
+    for (const Region &r : regions)
+    {
+        void *p = mmap((void *)(uintptr_t)r.base, r.size, PROT_NONE,
+                       MAP_SHARED | MAP_FIXED_NOREPLACE, fd, r.off);
+        if (p != (void *)(uintptr_t)r.base)
+            Fatal("cannot map the register file at 0x%08x: %s (x86-64 Linux, -no-pie build)",
+                  r.base, p == MAP_FAILED ? strerror(errno) : "address taken");
+    }
+    close(fd);
+
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_flags     = SA_SIGINFO | SA_NODEFER;
+    sa.sa_sigaction = OnFault;
+    sigaction(SIGSEGV, &sa, nullptr);
+    sa.sa_sigaction = OnStep;
+    sigaction(SIGTRAP, &sa, nullptr);
+}
+
+} // namespace sim
+} // namespace host
@@ -0,0 +1,54 @@
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+// Harness internals shared by board.cpp (clock, interrupts, run control),
+// regs.cpp (register file and access traps) and periph.cpp (models).
+
+#include "board.h"
+
+#include <cstdint>
+
+namespace host {
+namespace sim {
+
+extern Options  opt;
+extern Analog  *analog;
+extern Tick     now;
+extern bool     in_isr;
+extern bool     stepping;
+extern uint32_t isr_now;            // number of the ISR running, 0 outside
+extern uint32_t primask;
+
+extern std::vector<Write> writes;
+extern std::vector<Latch> latches;
+extern std::vector<Pin>   pins;
+
+[[noreturn]] void Fatal(const char *fmt, ...);
+
+// Clock: process peripheral events up to `to`, bring the analog side along
+void Advance(Tick to);
+void Charge(unsigned ticks);
+
+// Take pending interrupts while unmasked and not in an ISR
+void Dispatch();
+
+// Register file (regs.cpp): harness-side view of a register
+void     MapRegisters();
+uint8_t *Raw(uint32_t addr);
+template <class T> T *Reg(uint32_t addr) { return (T *)Raw(addr); }
+inline uint32_t &Word(uint32_t addr) { return *(uint32_t *)Raw(addr); }
+
+// Peripheral models (periph.cpp)
+void Reset();
+Tick NextEvent();
+void FireEvents();
+void OnRead(uint32_t addr);
+void OnWrite(uint32_t addr, uint32_t old, uint32_t v);
+int  PendingIrq();                  // IRQn with its line up and enabled, or -1
+const std::vector<Byte> &UartBytes(int n);
+TimerOut TimerState(int n);
+
+} // namespace sim
+} // namespace host
+
+#endif // HOST_SIM_H
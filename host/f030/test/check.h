@@ -0,0 +1,30 @@
+#ifndef HOST_CHECK_H
+#define HOST_CHECK_H
+
+// Minimal checks for the host tests: report every failure, exit status at
+// the end (return Check_Result() from main)
+
+#include <cstdio>
+
+static int check_failed;
+
+#define CHECK(cond, ...)                                                  \
+    do {                                                                  \
+        if (!(cond)) {                                                    \
+            std::printf("%s:%d: FAILED %s: ", __FILE__, __LINE__, #cond); \
+            std::printf(__VA_ARGS__);                                     \
+            std::printf("\n");                                            \
+            check_failed++;                                               \
+        }                                                                 \
+    } while (0)
+
+static inline int Check_Result()
+{
+    if (check_failed)
+        std::printf("%d check(s) failed\n", check_failed);
+    else
+        std::printf("ok\n");
+    return check_failed ? 1 : 0;
+}
+
+#endif // HOST_CHECK_H
@@ -0,0 +1,184 @@
+// Battery supervisor (App/battery.c) on a modelled battery: open-circuit
+// voltage set by the test, 30 mOhm internal resistance, a load of 2 or 20 A
+// drawn while the modulator runs (no current while it ramps or is off).
+// Load steps first, for the internal resistance estimate; then the open-
+// circuit voltage is moved across the thresholds at 20 A: a terminal
+// voltage below BATTERY_WARN_MV alone does not warn, the warning and its
+// hysteresis, the lockout on the compensated voltage (start refused until
+// BATTERY_RESTART_MV) and the immediate one on the terminal voltage. The
+// events are taken from the telemetry frames on USART1, parsed as the
+// display board does.
+
+#include "board.h"
+#include "check.h"
+
+#include "battery.h"
+#include "overload.h"
+#include "sinegen.h"
+#include "telemetry.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace host;
+
+namespace {
+
+const double R_BAT = 0.030;         // ohm
+
+const Tick STEPS_FROM = Ms(500);    // load 2 / 20 A, toggled every STEP_EVERY
+const Tick STEP_EVERY = Ms(300);
+const Tick STEPS_TO   = Ms(5000);   // then 20 A
+const Tick VOC_FROM   = Ms(5500);   // open-circuit voltage changes from here
+const Tick END        = Ms(10800);
+
+double voc = 12.6;                  // V, open circuit
+double i_load = 2.0;                // A while SINEGEN_RUN
+
+class Battery : public FixedAnalog {
+public:
+    uint16_t Code(int channel) override
+    {
+        double i = SineGen_GetState() == SINEGEN_RUN ? i_load : 0.0;
+        if (channel == AIN_BAT_V)
+            return Adc((voc - i * R_BAT) / (BATTERY_MV_FULL / 1000.0));
+        if (channel == AIN_BAT_LOAD)
+            return Adc(i / (BATTERY_MA_FULL / 1000.0));
+        return FixedAnalog::Code(channel);
+    }
+
+private:
+    static uint16_t Adc(double full) { return (uint16_t)std::lround(std::min(std::max(full, 0.0), 1.0) * 4095); }
+};
+
+struct Event {
+    Tick     t;
+    uint8_t  ev;
+    uint16_t v_mv, vc_mv, time_left;
+};
+
+// TELEMETRY_BATTERY_EVENT frames on USART1, by the display board's parser
+// (Inverter_F40G_EVAL App/comms.c: slide one byte until a checksum matches)
+std::vector<Event> Events(uint16_t *r_status)
+{
+    std::vector<Event> ev;
+    const std::vector<Byte> &out = UartOut(1);
+    size_t i = 0;
+    while (i + TELEMETRY_FRAME <= out.size())
+    {
+        uint8_t cs = 0x55;
+        for (size_t k = 0; k < TELEMETRY_FRAME - 1; k++)
+            cs ^= out[i + k].b;
+        if (cs != out[i + TELEMETRY_FRAME - 1].b)
+        {
+            i++;
+            continue;
+        }
+        const Byte *p = &out[i + 1];
+        if (out[i].b == TELEMETRY_BATTERY_EVENT)
+            ev.push_back({ out[i + TELEMETRY_FRAME - 1].t, p[0].b, (uint16_t)(p[2].b | p[3].b << 8),
+                           (uint16_t)(p[4].b | p[5].b << 8), (uint16_t)(p[6].b | p[7].b << 8) });
+        else if (out[i].b == TELEMETRY_BATTERY && out[i].t > STEPS_TO && out[i].t < VOC_FROM)
+            *r_status = (uint16_t)(p[4].b | p[5].b << 8);
+        i += TELEMETRY_FRAME;
+    }
+    return ev;
+}
+
+const char *Name(uint8_t ev)
+{
+    static const char *names[] = { "clear", "warn", "uvlo", "cutoff" };
+    return ev < 4 ? names[ev] : "?";
+}
+
+BatteryState_t state_at_5900, state_at_6900, state_at_8500;
+uint16_t       r_at_steps_end;
+
+} // namespace
+
+int main()
+{
+    Battery bat;
+
+    // the bridge current is well above the placeholder rating of overload.c;
+    // 300 ms ramps instead of SOFT_MS, for the timeline below
+    At(0, [] { SineGen_SetRamp(RAMP_DEFAULT_CURVE, 300, RAMP_I_LIMIT); });
+    At(Ms(50), [] { Overload_SetCurve(4095, OVERLOAD_TAU_S); });
+    for (Tick t = STEPS_FROM; t < STEPS_TO; t += STEP_EVERY)
+        At(t, [] { i_load = i_load < 10 ? 20.0 : 2.0; });
+    At(STEPS_TO, [] { r_at_steps_end = Battery_GetResistance(); });
+    At(VOC_FROM, [] { voc = 11.3; });   // 10.7 V at the terminals
+    At(Ms(5900), [] { state_at_5900 = Battery_GetState(); });
+    At(Ms(6000), [] { voc = 11.1; });   // warn
+    At(Ms(6500), [] { voc = 11.35; });  // inside the hysteresis
+    At(Ms(6900), [] { state_at_6900 = Battery_GetState(); });
+    At(Ms(7000), [] { voc = 11.5; });   // clear
+    At(Ms(7500), [] { voc = 10.45; });  // warn, lockout
+    At(Ms(8400), [] {
+        voc = 12.0;                     // recovered, not recharged
+        SineGen_Start();
+    });
+    At(Ms(8500), [] { state_at_8500 = Battery_GetState(); });
+    At(Ms(8600), [] { CHECK(SineGen_GetState() == SINEGEN_IDLE, "started in lockout"); });
+    At(Ms(9000), [] { voc = 12.3; });   // clear
+    At(Ms(9300), [] {
+        SineGen_Start();
+        CHECK(SineGen_GetState() == SINEGEN_RAMP_UP, "start refused after the clear");
+    });
+    At(Ms(10300), [] { voc = 9.9; });   // 9.3 V at the terminals: cutoff
+
+    Options o;
+    o.end    = END;
+    o.analog = &bat;
+    Run(o);
+
+    // internal resistance from the load steps
+    uint16_t r_status = 0;
+    std::vector<Event> ev = Events(&r_status);
+    CHECK(std::abs((int)r_at_steps_end - (int)lround(R_BAT * 10000)) <= 3, "R estimate %.1f mOhm",
+          r_at_steps_end / 10.0);
+    CHECK(r_status == r_at_steps_end, "status frame R %.1f mOhm", r_status / 10.0);
+
+    // 10.7 V at the terminals, 11.3 V compensated: no warning
+    CHECK(state_at_5900 == BATTERY_OK, "state %d at 20 A with 11.3 V open circuit", state_at_5900);
+    CHECK(state_at_6900 == BATTERY_WARN, "warning cleared inside the hysteresis");
+    CHECK(state_at_8500 == BATTERY_LOCKOUT, "lockout released at 12.0 V");
+
+    // warn, clear, warn, uvlo, clear; warn at the first trend point (10 s
+    // after Battery_Init()): the rest voltage fell 0.6 V in 10 s, so the
+    // lockout is predicted within BATTERY_WARN_S; cutoff. Each within the
+    // polls it takes.
+    struct Want {
+        uint8_t ev;
+        Tick    after, within;
+    };
+    const Want want[] = {
+        { BATTERY_EV_WARN, Ms(6000), Ms(250) },
+        { BATTERY_EV_CLEAR, Ms(7000), Ms(250) },
+        { BATTERY_EV_WARN, Ms(7500), Ms(250) },
+        { BATTERY_EV_UVLO, Ms(7500), Ms(250) + BATTERY_UVLO_POLLS * Ms(BATTERY_PERIOD_MS) },
+        { BATTERY_EV_CLEAR, Ms(9000), Ms(250) },
+        { BATTERY_EV_WARN, Ms(BATTERY_TREND_S * 1000 - 100), Ms(250) },
+        { BATTERY_EV_CUTOFF, Ms(10300), Ms(250) },
+    };
+    const size_t n = sizeof want / sizeof want[0];
+    CHECK(ev.size() == n, "%zu battery events, expected %zu", ev.size(), n);
+    for (size_t k = 0; k < ev.size() && k < n; k++)
+    {
+        CHECK(ev[k].ev == want[k].ev, "event %zu: %s, expected %s", k, Name(ev[k].ev), Name(want[k].ev));
+        CHECK(ev[k].t > want[k].after && ev[k].t < want[k].after + want[k].within, "%s at %.0f ms",
+              Name(ev[k].ev), ToMs(ev[k].t));
+        printf("%-6s at %5.0f ms: %5u mV, %5u mV compensated, %u s left\n", Name(ev[k].ev), ToMs(ev[k].t),
+               ev[k].v_mv, ev[k].vc_mv, ev[k].time_left);
+    }
+    if (ev.size() == n)
+    {
+        CHECK(ev[5].vc_mv >= BATTERY_WARN_MV && ev[5].time_left < BATTERY_WARN_S, "trend warning: %u mV, %u s",
+              ev[5].vc_mv, ev[5].time_left);
+    }
+    CHECK(SineGen_GetState() == SINEGEN_IDLE || SineGen_GetState() == SINEGEN_RAMP_DOWN,
+          "bridge still on after the cutoff");
+
+    printf("R estimate %.1f mOhm (battery %.1f)\n", r_at_steps_end / 10.0, R_BAT * 1000);
+    return Check_Result();
+}
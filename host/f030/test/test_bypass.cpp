@@ -0,0 +1,180 @@
+// Mains sync and bypass transfer against the plant, with a synthetic mains on
+// ADC_U_IN (PlantParams::mains_peak, off-nominal frequency and phase). Checks
+// that the PLL locks onto the frequency with the modulator's index 0 on the
+// mains zero crossing, that the relay contacts move at zero crossings in
+// both directions, that the bridge hands over and takes back the load at
+// those times (at full amplitude, no ramp), and that the DC trim goes on
+// with the zero it had before the bypass.
+
+#include "board.h"
+#include "check.h"
+#include "plant.h"
+
+#include "stm32f0xx.h"
+#include "main.h"
+#include "pll.h"
+#include "sinegen.h"
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+using namespace host;
+
+namespace {
+
+const uint32_t CCR16 = TIM16_BASE + offsetof(TIM_TypeDef, CCR1);
+const uint32_t BDTR16 = TIM16_BASE + offsetof(TIM_TypeDef, BDTR);
+
+const double MAINS_HZ    = 50.4;
+const double MAINS_PHASE = 1.0;     // rad at t = 0
+const double SAMPLE_MS   = 1000.0 / UPDATE_FREQ_HZ;
+
+const Tick CLOSE_AT = Ms(1500);
+const Tick OPEN_AT  = Ms(2200);
+const Tick END      = Ms(3000);
+
+uint8_t locked_at_close;
+uint16_t freq_at_close;
+std::vector<int32_t> trims;         // SineGen_GetDcTrim() every period after the hand-back
+
+// Distance from t to the nearest mains zero crossing (either direction), ms
+double FromZero(Tick t)
+{
+    double half  = 500.0 / MAINS_HZ;
+    double first = (M_PI - MAINS_PHASE) / (2.0 * M_PI * MAINS_HZ) * 1000.0;  // a crossing
+    double d     = fmod(ToMs(t) - first, half);
+    if (d < 0)
+        d += half;
+    return std::min(d, half - d);
+}
+
+// Offset of t after the last positive-going mains crossing, ms, -T/2..T/2
+double FromRising(Tick t)
+{
+    double period = 1000.0 / MAINS_HZ;
+    double rise   = -MAINS_PHASE / (2.0 * M_PI * MAINS_HZ) * 1000.0;
+    double d      = fmod(ToMs(t) - rise, period);
+    if (d < 0)
+        d += period;
+    return d > period / 2 ? d - period : d;
+}
+
+} // namespace
+
+int main()
+{
+    PlantParams pp;
+    pp.mains_peak  = 1000;
+    pp.mains_hz    = MAINS_HZ;
+    pp.mains_phase = MAINS_PHASE;
+    Plant plant(pp, Timer, 48);
+    plant.StateHook([] { return (int)SineGen_GetState(); });
+
+    At(Ms(1), [] { CHECK(SineGen_SetSync(1) == 0, "sync refused"); });
+    At(CLOSE_AT, [] {
+        locked_at_close = SineGen_SyncLocked();
+        freq_at_close   = Pll_GetFreq();
+        CHECK(SineGen_Bypass(1) == 0, "bypass refused");
+    });
+    At(OPEN_AT, [] { CHECK(SineGen_Bypass(0) == 0, "bypass off refused"); });
+    for (double ms = 100; ms < ToMs(END - OPEN_AT); ms += 20)
+        At(OPEN_AT + Ms(ms), [] { trims.push_back(SineGen_GetDcTrim()); });
+
+    Options o;
+    o.end    = END;
+    o.analog = &plant;
+    Run(o);
+
+    // locked on frequency before the transfer
+    CHECK(locked_at_close, "not locked at %.0f ms", ToMs(CLOSE_AT));
+    // (TIM6 periods of whole microseconds: 198 us is 50.51 Hz, 199 us 50.25 Hz)
+    CHECK(abs((int)freq_at_close - (int)lround(MAINS_HZ * 100)) <= 10, "tracking %.2f Hz, mains %.2f Hz",
+          freq_at_close / 100.0, MAINS_HZ);
+
+    // index 0: the reference rises through 50% at the mains rising crossing,
+    // one sample early at most (CCRs latch at the next carrier period)
+    uint32_t half = (Timer(16).arr + 1) / 2;
+    uint32_t prev = half;
+    double   worst = 0;
+    unsigned rises = 0;
+    for (const Write &w : Writes())
+    {
+        if (w.addr != CCR16 || !w.isr || w.t < Ms(1000) || w.t >= CLOSE_AT)
+            continue;
+        if (prev < half && w.value >= half)
+        {
+            double d = FromRising(w.t);
+            if (fabs(d) > fabs(worst))
+                worst = d;
+            rises++;
+        }
+        prev = w.value;
+    }
+    CHECK(rises >= 24, "%u rising crossings of the reference", rises);
+    CHECK(fabs(worst) < 1.5 * SAMPLE_MS, "reference crosses %.3f ms off the mains", worst);
+
+    // relay: contacts at zero crossings, the bridge off after the overlap and
+    // back on where the contacts open
+    Tick set = NEVER, reset = NEVER;
+    for (const Pin &p : Pins())
+    {
+        if (p.port != 'B')
+            continue;
+        bool on = p.odr & BYPASS_ENABLE_Pin;
+        if (on && set == NEVER)
+            set = p.t;
+        else if (!on && set != NEVER && reset == NEVER)
+            reset = p.t;
+    }
+    CHECK(set != NEVER && reset != NEVER, "relay never switched");
+    Tick moe_off = NEVER, moe_on = NEVER;
+    for (const Write &w : Writes())
+    {
+        if (w.addr != BDTR16)
+            continue;
+        if (!(w.value & TIM_BDTR_MOE) && w.t > set && moe_off == NEVER)
+            moe_off = w.t;
+        if ((w.value & TIM_BDTR_MOE) && w.t > reset && moe_on == NEVER)
+            moe_on = w.t;
+    }
+    double closed = FromZero(set + Us(BYPASS_CLOSE_US)), opened = FromZero(reset + Us(BYPASS_OPEN_US));
+    CHECK(closed < 1.5 * SAMPLE_MS, "contacts closed %.3f ms from a zero crossing", closed);
+    CHECK(opened < 1.5 * SAMPLE_MS, "contacts opened %.3f ms from a zero crossing", opened);
+    double off_ms = ToMs(moe_off - set) - (BYPASS_CLOSE_US + BYPASS_OVERLAP_US) / 1000.0;
+    double on_ms  = ToMs(moe_on - reset) - BYPASS_OPEN_US / 1000.0;
+    CHECK(moe_off != NEVER && fabs(off_ms) < 1.5 * SAMPLE_MS, "bridge off %.3f ms after the overlap", off_ms);
+    CHECK(moe_on != NEVER && fabs(on_ms) < 1.5 * SAMPLE_MS, "bridge on %.3f ms from the contacts opening",
+          on_ms);
+
+    // taken back at full amplitude: the first half period already swings as
+    // far as the last one before the transfer
+    uint32_t swing_before = 0, swing_after = 0;
+    for (const Write &w : Writes())
+    {
+        if (w.addr != CCR16 || !w.isr)
+            continue;
+        uint32_t d = w.value > half ? w.value - half : half - w.value;
+        if (w.t > set - Ms(20) && w.t < set)
+            swing_before = std::max(swing_before, d);
+        if (w.t > moe_on && w.t < moe_on + Ms(10))
+            swing_after = std::max(swing_after, d);
+    }
+    CHECK(swing_after > swing_before * 9 / 10, "swing %u after the hand-back, %u before", swing_after,
+          swing_before);
+
+    // the DC trim runs on with its old zero (a new one needs zero output)
+    unsigned changes = 0;
+    for (size_t i = 1; i < trims.size(); i++)
+        if (trims[i] != trims[i - 1])
+            changes++;
+    CHECK(changes > 0, "DC trim frozen at %ld after the hand-back",
+          (long)(trims.empty() ? 0 : trims.back()));
+    Metrics m = SteadyState(plant, ToMs(END) / 1000.0 - 0.2);
+    CHECK(m.valid && fabs(m.v_out_dc) < 0.05, "output DC %.3f V after the hand-back", m.v_out_dc);
+
+    printf("locked at %.2f Hz, reference %+.3f ms off the mains, contacts %.3f / %.3f ms from zero, "
+           "trim changed %u times\n",
+           freq_at_close / 100.0, worst, closed, opened, changes);
+    return Check_Result();
+}
@@ -0,0 +1,73 @@
+// DC trim against the plant: the zero reference comes from a period at zero
+// amplitude (no CCR leaves 50% duty before it), the trim settles inside its
+// range and holds the output DC down. With "flipped" the output divider is
+// inverted (DCTRIM_UOUT_POLARITY wrong for the board): the trim has to find
+// out it diverges, switch itself off and leave the output without DC.
+
+#include "board.h"
+#include "check.h"
+#include "plant.h"
+
+#include "stm32f0xx.h"
+#include "sinegen.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+
+using namespace host;
+
+namespace {
+
+const uint32_t CCR16 = TIM16_BASE + offsetof(TIM_TypeDef, CCR1);
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    bool        flipped = argc > 1 && strcmp(argv[1], "flipped") == 0;
+    PlantParams pp;
+    if (flipped)
+        pp.u_gain = -pp.u_gain;
+    Plant plant(pp, Timer, 48);
+    plant.StateHook([] { return (int)SineGen_GetState(); });
+
+    Options o;
+    o.end    = Ms(2000);
+    o.analog = &plant;
+    Run(o);
+
+    // CCR writes from the TIM6 ISR: a whole period at 50% duty first
+    uint32_t half = (Timer(16).arr + 1) / 2;
+    unsigned at_zero = 0;
+    for (const Write &w : Writes())
+    {
+        if (w.addr != CCR16 || !w.isr)
+            continue;
+        if (w.value < half - 1 || w.value > half + 1)
+            break;
+        at_zero++;
+    }
+    CHECK(at_zero >= SINE_SAMPLES, "output on after %u samples at zero", at_zero);
+
+    Metrics m = SteadyState(plant, 1.8);
+    CHECK(m.valid, "no steady state");
+    CHECK(fabs(m.v_out_dc) < 0.02, "output DC %.3f V", m.v_out_dc);
+    CHECK(m.v_out_rms > 8.0, "output %.2f V rms", m.v_out_rms);
+
+    int32_t trim = SineGen_GetDcTrim();
+    if (flipped)
+    {
+        CHECK(SineGen_DcTrimFailed(), "trim still on at %ld", (long)trim);
+        CHECK(trim == 0, "trim %ld after switching off", (long)trim);
+    }
+    else
+    {
+        CHECK(!SineGen_DcTrimFailed(), "correct trim switched off");
+        CHECK(trim > -DCTRIM_MAX && trim < DCTRIM_MAX, "trim at the limit: %ld", (long)trim);
+    }
+    printf("%s: %u samples at zero, trim %ld, output DC %.3f V\n", flipped ? "flipped" : "normal", at_zero,
+           (long)trim, m.v_out_dc);
+
+    return Check_Result();
+}
@@ -0,0 +1,132 @@
+// Output metering (App/meter.c) against the plant. The load is the
+// argument (ParseLoad(): r:10, rl:10:0.02, rect:10, lamp:5 ...). After the
+// start has settled, Meter_Get() is read once per period for 300 ms and set
+// against the plant over the same time: U_rms against the output voltage,
+// P against the power the bridge takes from the battery (meter.c works on
+// the battery side, bridge and filter losses included), and the energy
+// count against the battery energy over the window. The plain mean of
+// ADC_BAT_LOAD times the battery voltage is printed as well: the error the
+// clipping correction takes out.
+
+#include "board.h"
+#include "check.h"
+#include "plant.h"
+
+#include "stm32f0xx.h"
+#include "meter.h"
+#include "sinegen.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+using namespace host;
+
+namespace {
+
+const Tick FROM = Ms(700);          // ramp done, DC trim and RC settled
+const Tick TO   = Ms(1000);
+const Tick END  = Ms(1020);
+
+// P tolerance per load kind, relative: the model in meter.h takes the
+// output current as a sine; R-L and rectifier loads are not
+struct Tolerance {
+    const char *kind;
+    double      p;
+};
+const Tolerance TOL[] = {
+    { "r", 0.03 },
+    { "lamp", 0.03 },
+    { "rl", 0.15 },
+    { "rect", 0.15 },
+};
+
+std::vector<Meter_t> reads;
+uint64_t energy_from, energy_to;    // mJ
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    const char *spec = argc > 1 ? argv[1] : "r:10";
+    PlantParams pp;
+    CHECK(ParseLoad(spec, pp), "unknown load %s", spec);
+    double tol = 0;
+    for (const Tolerance &t : TOL)
+        if (pp.load == t.kind)
+            tol = t.p;
+    CHECK(tol > 0, "no tolerance for %s", pp.load.c_str());
+    if (check_failed)
+        return Check_Result();
+
+    Plant plant(pp, Timer, 48);
+    plant.StateHook([] { return (int)SineGen_GetState(); });
+
+    // a 300 ms start instead of SOFT_MS keeps the run short
+    At(0, [] { SineGen_SetRamp(RAMP_DEFAULT_CURVE, 300, RAMP_I_LIMIT); });
+    At(FROM, [] { energy_from = Meter_GetEnergyMj(); });
+    for (Tick t = FROM + Ms(10); t < TO; t += Ms(20))
+        At(t, [] {
+            Meter_t m;
+            Meter_Get(&m);
+            reads.push_back(m);
+        });
+    At(TO, [] { energy_to = Meter_GetEnergyMj(); });
+
+    Options o;
+    o.end    = END;
+    o.analog = &plant;
+    Run(o);
+
+    // the plant over the window
+    double from_s = ToMs(FROM) / 1000.0, to_s = ToMs(TO) / 1000.0;
+    Metrics m = SteadyState(plant, from_s, to_s);
+    CHECK(m.valid, "no steady state");
+    const Plant::Sample *first = nullptr, *last = nullptr;
+    double i_sum = 0, v_sum = 0;
+    unsigned n = 0;
+    for (const Plant::Sample &s : plant.samples)
+    {
+        if (s.t < from_s || s.t >= to_s)
+            continue;
+        if (!first)
+            first = &s;
+        last = &s;
+        i_sum += s.adc_i;
+        v_sum += pp.vbat - pp.r_bat * s.i_bat;
+        n++;
+    }
+    CHECK(first && last && last->t > first->t, "no plant samples");
+    if (check_failed)
+        return Check_Result();
+    double p_in  = (last->e_in - first->e_in) / (last->t - first->t);
+    double p_out = (last->e_out - first->e_out) / (last->t - first->t);
+    double e_in  = p_in * (to_s - from_s);
+    // what meter.c would give without the clipping correction
+    double p_mean = v_sum / n * (i_sum / n / 4096.0 * 3.3 / pp.i_gain);
+
+    double u = 0, p = 0, s = 0, pf = 0;
+    for (const Meter_t &r : reads)
+    {
+        u  += r.u_rms / 100.0;
+        p  += r.p / 1000.0;
+        s  += r.s / 1000.0;
+        pf += r.pf / 32768.0;
+    }
+    double k = reads.empty() ? 1 : 1.0 / reads.size();
+    u *= k, p *= k, s *= k, pf *= k;
+    double e = (double)(energy_to - energy_from) / 1000.0;
+
+    CHECK(reads.size() == 15, "%zu readings", reads.size());
+    CHECK(fabs(u / m.v_out_rms - 1) < 0.01, "U_rms %.3f V, plant %.3f V", u, m.v_out_rms);
+    CHECK(fabs(p / p_in - 1) < tol, "P %.2f W, from the battery %.2f W (%+.1f %%)", p, p_in,
+          100 * (p / p_in - 1));
+    CHECK(fabs(e / e_in - 1) < tol, "energy %.3f J, from the battery %.3f J", e, e_in);
+    CHECK(s >= p && pf > 0 && pf <= 1, "S %.2f VA, PF %.3f", s, pf);
+
+    printf("%s: U %.3f/%.3f V, P %.2f/%.2f W (%+.1f %%, plain mean %+.1f %%), out %.2f W, S %.2f VA, "
+           "PF %.3f, energy %.3f/%.3f J\n",
+           spec, u, m.v_out_rms, p, p_in, 100 * (p / p_in - 1), 100 * (p_mean / p_in - 1), p_out, s, pf, e,
+           e_in);
+    return Check_Result();
+}
@@ -0,0 +1,96 @@
+// App/pwmlog.c against the harness trace: the capture printed on USART1 by
+// PwmLog_Poll() must hold the CCR values and the bridge-on event the
+// firmware wrote, at the times they were written (TIM6 microseconds).
+
+#include "board.h"
+#include "check.h"
+
+#include "stm32f0xx.h"
+#include "pwmlog.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace host;
+
+namespace {
+
+const uint32_t CCR17 = TIM17_BASE + offsetof(TIM_TypeDef, CCR1);
+
+struct Row {
+    long     t;
+    char     kind;
+    unsigned a, b;
+};
+
+} // namespace
+
+int main()
+{
+    Options o;
+    o.end = Ms(1500);                   // 160 rows at 115200 baud: ~0.25 s
+    Run(o);
+
+    std::string text = UartText(1);
+    size_t begin = text.find("# pwmlog");
+    size_t end   = text.find("# end", begin);
+    CHECK(begin != std::string::npos && end != std::string::npos, "no capture on USART1");
+    if (check_failed)
+        return Check_Result();
+
+    unsigned arr = 0, deadtime = 0, fs = 0;
+    CHECK(sscanf(text.c_str() + begin, "# pwmlog arr=%u deadtime=%u fs=%u", &arr, &deadtime, &fs) == 3,
+          "header");
+    CHECK(arr == 2999 && deadtime == 75 && fs == 5000, "arr=%u deadtime=%u fs=%u", arr, deadtime, fs);
+
+    std::vector<Row> rows;
+    for (size_t p = text.find('\n', begin) + 1; p < end; p = text.find('\n', p) + 1)
+    {
+        Row r = { 0, 0, 0, 0 };
+        if (sscanf(text.c_str() + p, "%ld,%c,%u,%u", &r.t, &r.kind, &r.a, &r.b) >= 3)
+            rows.push_back(r);
+    }
+    CHECK(rows.size() == PWMLOG_DEPTH, "%zu rows", rows.size());
+    CHECK(!rows.empty() && rows[0].kind == 'B' && rows[0].a == 1, "first row is not the bridge-on");
+
+    // the CCR pairs written by the ISR, in order
+    std::vector<Write> ccr;
+    for (const Write &w : Writes())
+        if (w.addr == CCR17 && w.isr)
+            ccr.push_back(w);
+
+    size_t   k = 0;
+    unsigned bad_value = 0, bad_time = 0;
+    long     t0 = -1;
+    Tick     w0 = 0;
+    for (const Row &r : rows)
+    {
+        if (r.kind != 'C')
+            continue;
+        if (k >= ccr.size())
+        {
+            bad_value++;
+            continue;
+        }
+        const Write &w = ccr[k++];
+        if (r.a != w.value || r.b != w.value)
+            bad_value++;
+        if (t0 < 0)
+        {
+            t0 = r.t;
+            w0 = w.t;
+        }
+        // logged time vs write time, relative to the first sample
+        double d = (double)(r.t - t0) - (double)(w.t - w0) / 48.0;
+        if (d < -2.0 || d > 2.0)
+            bad_time++;
+    }
+    CHECK(k == PWMLOG_DEPTH - 1, "%zu C rows", k);
+    CHECK(bad_value == 0, "%u rows differ from the CCR writes", bad_value);
+    CHECK(bad_time == 0, "%u rows more than 2 us off the write time", bad_time);
+
+    return Check_Result();
+}
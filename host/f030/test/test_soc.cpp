@@ -0,0 +1,286 @@
+// State of charge (App/soc.c) against synthetic discharges. soc.c is built
+// on its own; HAL_GetTick(), the battery voltage (battery.c), the NTC
+// temperature (thermal.c) and Telemetry_Send() are mocked here. Once a
+// simulated second the test feeds Soc_Sample() the 5000 ADC_BAT_LOAD codes
+// of that second (quantised, with noise, gain error and offset), sets the
+// terminal voltage as battery.c reports it and calls Soc_Poll().
+//
+// The battery it runs against is not the estimator's own model:
+//
+//   - Peukert: high currents take more charge than they deliver
+//   - polarisation: the terminal voltage recovers towards the open-circuit
+//     voltage over pol_tau after the load goes, so a rest correction taken
+//     too early reads low
+//   - capacity error, true inverter consumption and temperature per case
+//
+// A run ends when the usable charge is gone or battery.c would lock out
+// (terminal voltage plus I * r_bat below BATTERY_UVLO_MV, or the terminal
+// voltage below BATTERY_CUTOFF_MV). Reported per case: the largest error of
+// the usable charge (% of nominal) and the predicted runtime against the
+// time that was in fact left, at 25, 50 and 75 % of the run and the worst
+// ratio of the two over the run.
+//
+//   test_soc                       the cases below, with checks
+//   test_soc 8:7200,0:3600,20:1800 one profile (amps:seconds, repeated)
+
+#include "check.h"
+
+#include "battery.h"
+#include "soc.h"
+#include "telemetry.h"
+#include "thermal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+// the firmware's surroundings
+namespace {
+uint32_t tick;
+uint16_t v_mv;
+int16_t  temp;
+} // namespace
+
+extern "C" {
+void     Host_EnableIrq(void) {}
+void     Host_DisableIrq(void) {}
+uint32_t HAL_GetTick(void) { return tick; }
+uint16_t Battery_GetVoltage(void) { return v_mv; }
+int16_t  Thermal_GetTemp(void) { return temp; }
+uint8_t  Thermal_SensorFault(void) { return 0; }
+int      Telemetry_Send(uint8_t, const uint8_t *) { return 0; }
+}
+
+namespace {
+
+const uint16_t OCV[]         = { SOC_OCV_TABLE };
+const uint16_t TEMP_FACTOR[] = { SOC_TEMP_FACTOR };
+const int      OCV_N         = sizeof OCV / sizeof OCV[0];
+const int      TF_N          = sizeof TEMP_FACTOR / sizeof TEMP_FACTOR[0];
+const double   CAP_AS        = SOC_CAPACITY_MAH * 3.6;
+const unsigned SAMPLES       = 5000;    // UPDATE_FREQ_HZ
+
+struct Params {
+    double temp       = 25.0;       // degC
+    double soc0       = 100.0;      // true starting charge, %
+    double cap_err    = 0.0;        // true capacity error, relative
+    double peukert    = 1.1;        // exponent
+    double quiescent  = 60.0;       // true own consumption, mA
+    double r_bat      = 0.02;       // ohmic resistance, ohm
+    double r_pol      = 0.015;      // polarisation resistance, ohm
+    double pol_tau    = 900.0;      // polarisation time constant, s
+    double i_offset   = 0.0;        // current sense offset, codes
+    double i_gain_err = 0.0;        // current sense gain error, relative
+    double noise      = 2.0;        // ADC noise, codes rms
+};
+
+// Usable fraction at t degC, as the temperature table (the truth here)
+double TempFactor(double t)
+{
+    double x = std::min(std::max((t + 20.0) / 10.0, 0.0), (double)(TF_N - 1));
+    int    i = std::min((int)x, TF_N - 2);
+    return (TEMP_FACTOR[i] + (TEMP_FACTOR[i + 1] - TEMP_FACTOR[i]) * (x - i)) / 32768.0;
+}
+
+// Lead-acid string with Peukert loss and polarisation
+struct Battery {
+    const Params &a;
+    double cap, q, f, v_pol = 0.0;
+
+    explicit Battery(const Params &p)
+        : a(p), cap(CAP_AS * (1.0 + p.cap_err)), q(cap * p.soc0 / 100.0), f(TempFactor(p.temp))
+    {
+    }
+
+    double Ocv() const
+    {
+        double x = std::min(std::max(q / cap, 0.0), 1.0) * (OCV_N - 1);
+        int    i = std::min((int)x, OCV_N - 2);
+        return (OCV[i] + (OCV[i + 1] - OCV[i]) * (x - i)) / 1000.0;
+    }
+
+    double Usable() const { return q - cap * (1.0 - f); }
+
+    // Terminal voltage after dt s at i_bridge A
+    double Step(double i_bridge, double dt)
+    {
+        double i   = i_bridge + a.quiescent / 1000.0;
+        double i20 = cap / 3600.0 / 20.0;
+        q -= (i > i20 ? i * pow(i / i20, a.peukert - 1.0) : i) * dt;
+        v_pol += (i * a.r_pol - v_pol) * (1.0 - exp(-dt / a.pol_tau));
+        return Ocv() - i * a.r_bat - v_pol;
+    }
+};
+
+struct Phase {
+    double amps;
+    int    secs;
+};
+
+std::vector<Phase> ParseProfile(const std::string &spec)
+{
+    std::vector<Phase> out;
+    size_t p = 0;
+    while (p < spec.size())
+    {
+        size_t comma = spec.find(',', p);
+        std::string part = spec.substr(p, comma == std::string::npos ? std::string::npos : comma - p);
+        size_t colon = part.find(':');
+        if (colon == std::string::npos)
+            return {};
+        out.push_back({ atof(part.c_str()), atoi(part.c_str() + colon + 1) });
+        p = comma == std::string::npos ? spec.size() : comma + 1;
+    }
+    return out;
+}
+
+struct Point {
+    int      t;
+    double   err;                   // usable charge, % of nominal
+    uint16_t runtime;               // min
+};
+
+struct Result {
+    int    end;                     // s
+    double worst;                   // largest |err|
+    double ratio_lo, ratio_hi;      // predicted / actual runtime over the run
+    std::vector<Point> trace;
+};
+
+Result RunProfile(const std::vector<Phase> &profile, const Params &a)
+{
+    std::mt19937 rng(1);
+    std::normal_distribution<double> gauss(0.0, sqrt(SAMPLES * (a.noise * a.noise + 1.0 / 12)));
+    Battery bat(a);
+
+    // Battery_Init() took the voltage before the first load
+    tick = 0;
+    v_mv = (uint16_t)lround(bat.Ocv() * 1000);
+    temp = (int16_t)lround(a.temp * 10);
+    Soc_Init();
+
+    Result r = { 0, 0.0, HUGE_VAL, 0.0, {} };
+    size_t k    = 0;
+    int    left = profile[0].secs;
+    for (;;)
+    {
+        double amps = profile[k].amps;
+        double v    = bat.Step(amps, 1.0);
+        double v_c  = v + (amps + a.quiescent / 1000.0) * a.r_bat;
+        if (bat.Usable() <= 0 || v_c * 1000 < BATTERY_UVLO_MV || v * 1000 < BATTERY_CUTOFF_MV)
+            break;
+
+        // one second of ADC_BAT_LOAD codes, the sum spread over the samples
+        double x   = std::max(0.0, amps * (1.0 + a.i_gain_err) / (BATTERY_MA_FULL / 1000.0) * 4096 + a.i_offset);
+        long   acc = a.noise > 0 ? lround(SAMPLES * x + gauss(rng)) : (long)SAMPLES * lround(x);
+        acc        = std::max(acc, 0l);
+        for (unsigned s = 0; s < SAMPLES; s++)
+            Soc_Sample((uint16_t)(acc / SAMPLES + (s < acc % SAMPLES)));
+
+        // terminal voltage as battery.c reports it (mean code << 4 to mV)
+        uint32_t v_q4 = (uint32_t)(std::max(0.0, v) / (BATTERY_MV_FULL / 1000.0) * 4096 * 16);
+        v_mv = (uint16_t)((v_q4 * BATTERY_MV_FULL) >> 16);
+        tick += SOC_PERIOD_MS;
+        Soc_Poll();
+
+        double err = 100.0 * (Soc_GetAvailable() * 3.6 - std::max(bat.Usable(), 0.0)) / CAP_AS;
+        r.worst    = std::max(r.worst, fabs(err));
+        r.trace.push_back({ r.end, err, Soc_GetRuntime() });
+
+        r.end++;
+        if (--left <= 0)
+        {
+            k    = (k + 1) % profile.size();
+            left = profile[k].secs;
+        }
+    }
+
+    // predicted / actual from the first tenth of the run to the last tenth
+    for (const Point &p : r.trace)
+    {
+        double actual = (r.end - p.t) / 60.0;
+        if (p.t < r.end / 10 || p.t > r.end - r.end / 10)
+            continue;
+        double ratio = p.runtime == SOC_RUNTIME_MAX ? HUGE_VAL : p.runtime / actual;
+        r.ratio_lo   = std::min(r.ratio_lo, ratio);
+        r.ratio_hi   = std::max(r.ratio_hi, ratio);
+    }
+    return r;
+}
+
+Result Report(const char *name, const std::vector<Phase> &profile, const Params &a)
+{
+    Result r = RunProfile(profile, a);
+    printf("%-24s %5.2f h %6.2f %%", name, r.end / 3600.0, r.worst);
+    for (double frac : { 0.25, 0.5, 0.75 })
+    {
+        size_t i = (size_t)(r.end * frac);
+        if (i >= r.trace.size())
+        {
+            printf("        -   ");
+            continue;
+        }
+        double actual = (r.end - r.trace[i].t) / 60.0;
+        if (r.trace[i].runtime == SOC_RUNTIME_MAX)
+            printf("     -/%-5.0f", actual);
+        else
+            printf("  %5u/%-5.0f", r.trace[i].runtime, actual);
+    }
+    printf("  %.2f..%.2f\n", r.ratio_lo, r.ratio_hi);
+    return r;
+}
+
+struct Case {
+    const char *name;
+    const char *profile;
+    Params      p;
+    double      max_err;            // % of nominal
+    double      ratio_lo, ratio_hi; // predicted / actual runtime
+};
+
+Params With(void (*set)(Params &))
+{
+    Params p;
+    set(p);
+    return p;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    printf("%-24s %7s %8s   runtime predicted/actual (min) at 25 / 50 / 75 %%, range\n", "case", "end",
+           "max err");
+
+    if (argc > 1)
+    {
+        std::vector<Phase> profile = ParseProfile(argv[1]);
+        CHECK(!profile.empty(), "profile: amps:seconds,...");
+        if (!profile.empty())
+            Report(argv[1], profile, Params());
+        return Check_Result();
+    }
+
+    const Case cases[] = {
+        { "10 A, 25 C", "10:60", Params(), 1.0, 0.9, 1.1 },
+        { "30 A (Peukert)", "30:60", Params(), 1.0, 0.9, 1.1 },
+        { "2 / 20 A every 60 s", "2:60,20:60", Params(), 1.0, 0.8, 1.2 },
+        { "evening with rests", "6:7200,0:2400,15:3600", Params(), 2.5, 0.3, 2.0 },
+        { "10 A, -10 C", "10:60", With([](Params &p) { p.temp = -10.0; }), 1.0, 0.9, 1.1 },
+        { "10 A, offset +3 codes", "10:60", With([](Params &p) { p.i_offset = 3.0; }), 1.0, 0.9, 1.1 },
+        { "10 A, gain +2 %", "10:60", With([](Params &p) { p.i_gain_err = 0.02; }), 2.5, 0.7, 1.1 },
+        { "10 A, capacity -10 %", "10:60", With([](Params &p) { p.cap_err = -0.1; }), 11.0, 1.0, 2.5 },
+        { "10 A, from 60 %", "10:60", With([](Params &p) { p.soc0 = 60.0; }), 1.0, 0.9, 1.1 },
+    };
+    for (const Case &c : cases)
+    {
+        Result r = Report(c.name, ParseProfile(c.profile), c.p);
+        CHECK(r.worst <= c.max_err, "%s: usable charge off by %.2f %%", c.name, r.worst);
+        CHECK(r.ratio_lo >= c.ratio_lo && r.ratio_hi <= c.ratio_hi, "%s: runtime %.2f..%.2f of the actual",
+              c.name, r.ratio_lo, r.ratio_hi);
+    }
+    return Check_Result();
+}
@@ -0,0 +1,185 @@
+// Bridge_SoftStart()/Bridge_SoftStop() on the host timers: the modulator is
+// stopped first, then a full ramp up, a pause at 50% and a full ramp down,
+// then a ramp up stopped half way. Checks the duty steps (one CCR pair from
+// the main loop every SOFTSTART_TIME_MS / SOFTSTART_STEPS), the completion
+// callbacks on time, MOE on and off, and that the main loop and the TIM6 ISR
+// kept running throughout.
+
+#include "board.h"
+#include "check.h"
+
+#include "stm32f0xx.h"
+#include "sinegen.h"
+
+#include <cstddef>
+#include <initializer_list>
+#include <vector>
+
+using namespace host;
+
+namespace {
+
+const uint32_t CCR16 = TIM16_BASE + offsetof(TIM_TypeDef, CCR1);
+const uint32_t CCR17 = TIM17_BASE + offsetof(TIM_TypeDef, CCR1);
+
+const unsigned STEPS   = 100;       // SOFTSTART_STEPS, SOFTSTART_TIME_MS (sinegen.c)
+const double   RAMP_MS = 1000;
+const double   STEP_MS = RAMP_MS / STEPS;
+
+const Tick UP_AT    = Ms(500);      // full ramp up
+const Tick DOWN_AT  = Ms(1800);     // full ramp down
+const Tick UP2_AT   = Ms(3000);     // ramp up ...
+const Tick DOWN2_AT = Ms(3400);     // ... reversed after 40 steps
+const Tick END      = Ms(4400);
+
+Tick up_done = NEVER, down_done = NEVER, up2_done = NEVER, down2_done = NEVER;
+int  calls_up, calls_down;
+std::vector<Tick> polls;            // main-loop calls during the ramps: delay
+
+// CCR1 writes of TIM16 from the main loop in [from, to), TIM17 alongside
+struct Steps {
+    std::vector<Tick>     t;
+    std::vector<uint32_t> ccr;
+    unsigned              unpaired = 0;
+};
+
+Steps MainWrites(Tick from, Tick to)
+{
+    Steps s;
+    const Write *last16 = nullptr;
+    for (const Write &w : Writes())
+    {
+        if (w.t < from || w.t >= to || w.isr)
+            continue;
+        if (w.addr == CCR16)
+        {
+            if (last16)
+                s.unpaired++;
+            last16 = &w;
+        }
+        else if (w.addr == CCR17)
+        {
+            if (!last16 || last16->value != w.value)
+            {
+                s.unpaired++;
+                continue;
+            }
+            s.t.push_back(w.t);
+            s.ccr.push_back(w.value);
+            last16 = nullptr;
+        }
+    }
+    return s;
+}
+
+// One ramp: n steps of (ARR + 1) / 2 / STEPS from first, STEP_MS apart
+void CheckRamp(const char *name, const Steps &s, unsigned first, int dir, unsigned n, uint32_t half)
+{
+    CHECK(s.unpaired == 0, "%s: %u CCR writes without the other leg", name, s.unpaired);
+    CHECK(s.t.size() == n, "%s: %zu steps, expected %u", name, s.t.size(), n);
+    unsigned off_grid = 0, wrong = 0;
+    for (size_t i = 0; i < s.t.size(); i++)
+    {
+        unsigned k = first + dir * (int)i;
+        if (s.ccr[i] != half * k / STEPS)
+            wrong++;
+        if (i > 0)
+        {
+            double dt = ToMs(s.t[i] - s.t[i - 1]);
+            if (dt < STEP_MS - 0.01 || dt > STEP_MS + 1.01)
+                off_grid++;
+        }
+    }
+    CHECK(wrong == 0, "%s: %u steps at the wrong duty", name, wrong);
+    CHECK(off_grid == 0, "%s: %u steps off the %.0f ms grid", name, off_grid, STEP_MS);
+}
+
+bool Moe()
+{
+    return Timer(16).bdtr & TIM_BDTR_MOE && Timer(17).bdtr & TIM_BDTR_MOE;
+}
+
+} // namespace
+
+int main()
+{
+    // the sine generator starts from main(); the debug ramp needs it idle.
+    // Mains tracking keeps TIM6 running meanwhile, to show the ramp does not
+    // hold it up.
+    At(Ms(10), [] {
+        SineGen_Stop();
+        CHECK(SineGen_SetSync(1) == 0, "sync refused");
+    });
+
+    At(UP_AT, [] {
+        CHECK(SineGen_GetState() == SINEGEN_IDLE, "modulator still running");
+        CHECK(Bridge_SoftStop(nullptr) == -1, "stop accepted before a start");
+        CHECK(Bridge_SoftStart([] {
+                  up_done = Now();
+                  calls_up++;
+              }) == 0,
+              "start refused");
+        CHECK(Bridge_SoftStart(nullptr) == -1, "second start accepted");
+        CHECK(Moe(), "outputs off after the start");
+    });
+    for (double ms = 50; ms < RAMP_MS; ms += 100)
+        for (Tick at : { UP_AT + Ms(ms), DOWN_AT + Ms(ms) })
+            At(at, [at] { polls.push_back(Now() - at); });
+    At(DOWN_AT, [] {
+        CHECK(Moe(), "outputs off at 50%%");
+        CHECK(Bridge_SoftStop([] {
+                  down_done = Now();
+                  calls_down++;
+              }) == 0,
+              "stop refused");
+    });
+    At(UP2_AT, [] {
+        CHECK(!Moe(), "outputs still on after the ramp down");
+        CHECK(Bridge_SoftStart([] { up2_done = Now(); }) == 0, "second start refused");
+    });
+    At(DOWN2_AT, [] { CHECK(Bridge_SoftStop([] { down2_done = Now(); }) == 0, "stop in the ramp refused"); });
+
+    Options o;
+    o.end = END;
+    Run(o);
+
+    uint32_t half = (Timer(16).arr + 1) / 2;
+
+    // full ramps: done one ramp time after the call (1 ms HAL tick); the
+    // ramp down holds 0% for a step before switching the bridge off
+    CHECK(calls_up == 1 && calls_down == 1, "callbacks: %d up, %d down", calls_up, calls_down);
+    double up_ms = ToMs(up_done - UP_AT), down_ms = ToMs(down_done - DOWN_AT);
+    CHECK(up_ms >= RAMP_MS && up_ms < RAMP_MS + 2, "ramp up done after %.2f ms", up_ms);
+    CHECK(down_ms >= RAMP_MS + STEP_MS && down_ms < RAMP_MS + STEP_MS + 2, "ramp down done after %.2f ms",
+          down_ms);
+    CheckRamp("up", MainWrites(UP_AT + Ms(1), up_done + 1), 1, 1, STEPS, half);
+    CheckRamp("down", MainWrites(DOWN_AT, down_done + 1), STEPS - 1, -1, STEPS, half);
+
+    // reversed half way: back down from where it was, never at 50%
+    unsigned reached = (unsigned)(ToMs(DOWN2_AT - UP2_AT) / STEP_MS);
+    CHECK(up2_done == NEVER, "stopped ramp reported done at %.2f ms", ToMs(up2_done));
+    Steps up2 = MainWrites(UP2_AT + Ms(1), DOWN2_AT);
+    CHECK(up2.t.size() + 1 >= reached && up2.t.size() <= reached, "%zu steps before the stop, ~%u expected",
+          up2.t.size(), reached);
+    double down2_ms = ToMs(down2_done - DOWN2_AT), down2_want = (up2.t.size() + 1) * STEP_MS;
+    CHECK(down2_done != NEVER && down2_ms >= down2_want && down2_ms < down2_want + 2,
+          "stopped ramp down after %.2f ms, %zu steps", down2_ms, up2.t.size());
+    CheckRamp("down after stop", MainWrites(DOWN2_AT, down2_done + 1), (unsigned)up2.t.size() - 1, -1,
+              (unsigned)up2.t.size(), half);
+
+    // MOE: on for the ramps, off at the end of each ramp down
+    TimerOut t16 = Timer(16);
+    CHECK(!t16.running && !(t16.bdtr & TIM_BDTR_MOE), "bridge still on at the end");
+
+    // nothing blocked: every scheduled main-loop call on time, TIM6 throughout
+    unsigned late = 0;
+    for (Tick d : polls)
+        if (d > Ms(1))
+            late++;
+    CHECK(polls.size() == 20 && late == 0, "%zu main-loop calls during the ramps, %u late", polls.size(), late);
+    CHECK(IsrCount() > 0.95 * ToMs(END) * 5, "%u TIM6 ISRs in %.0f ms", IsrCount(), ToMs(END));
+
+    printf("up %.2f ms, down %.2f ms, stopped after %zu steps and back in %.2f ms\n", up_ms, down_ms,
+           up2.t.size(), down2_ms);
+    return Check_Result();
+}
@@ -0,0 +1,178 @@
+// Start, run and stop of the modulator on the host: SineGen_Init/Start from
+// main(), SineGen_Update from the TIM6 ISR, SineGen_Stop at 200 ms, with the
+// main-loop polls running all along. Checks the register trace: a CCR pair
+// per TIM6 period, both legs updating together, MOE on at the start and off
+// once the ramp-down has ended, the idle callback from the main loop right
+// after. With "dither": at the lowest carrier with
+// the widest dither, ARR and CCRs of every update event come from the same
+// ISR on both timers, and no ISR's period is overwritten before it latched;
+// switched to the highest carrier, the dither shrinks to 1/8 of its period.
+
+#include "board.h"
+#include "check.h"
+
+#include "stm32f0xx.h"
+#include "sinegen.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+
+using namespace host;
+
+namespace {
+
+const uint32_t CCR16 = TIM16_BASE + offsetof(TIM_TypeDef, CCR1);
+const uint32_t CCR17 = TIM17_BASE + offsetof(TIM_TypeDef, CCR1);
+const uint32_t BDTR16 = TIM16_BASE + offsetof(TIM_TypeDef, BDTR);
+const uint32_t BDTR17 = TIM17_BASE + offsetof(TIM_TypeDef, BDTR);
+
+const Tick STOP_AT   = Ms(200);
+const Tick FAST_AT   = Ms(120);     // "dither": to CARRIER_MAX_HZ
+const Tick SAMPLE    = 48 * 200;    // TIM6: PSC 47, ARR 199
+
+Tick     idle_at = NEVER;
+int      idle_calls;
+uint32_t idle_isr;
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    bool dither = argc > 1 && strcmp(argv[1], "dither") == 0;
+    bool verbose = argc > 1 && strcmp(argv[argc - 1], "-v") == 0;
+
+    Options o;
+    o.end = Ms(600);
+    if (dither)
+        At(Ms(5), [] {
+            Bridge_SetCarrier(CARRIER_MIN_HZ);
+            Bridge_SetDither(0xFFFF);
+        });
+    if (dither)
+        At(FAST_AT, [] { Bridge_SetCarrier(CARRIER_MAX_HZ); });
+    At(Ms(1), [] {
+        SineGen_SetCallbacks(nullptr, [] {
+            idle_at = Now();
+            idle_isr = Isr();
+            idle_calls++;
+        });
+    });
+    At(STOP_AT, [] { SineGen_Stop(); });
+    Run(o);
+
+    if (verbose)
+        for (const Write &w : Writes())
+            printf("%12llu %-14s 0x%08x isr %u\n", (unsigned long long)w.t,
+                   RegName(w.addr).c_str(), w.value, w.isr);
+
+    // MOE: set once on both timers at the start, cleared once after the stop
+    Tick moe_on = NEVER, moe_off = NEVER;
+    int  moe_changes = 0;
+    uint32_t moe16 = 0, moe17 = 0;
+    for (const Write &w : Writes())
+    {
+        if (w.addr != BDTR16 && w.addr != BDTR17)
+            continue;
+        uint32_t &m = (w.addr == BDTR16) ? moe16 : moe17;
+        uint32_t  on = w.value & TIM_BDTR_MOE;
+        if (on == m)
+            continue;
+        m = on;
+        moe_changes++;
+        if (on && moe_on == NEVER)
+            moe_on = w.t;
+        if (!on && moe_off == NEVER)
+            moe_off = w.t;
+    }
+    CHECK(moe_changes == 4, "%d MOE changes", moe_changes);
+    CHECK(moe_on < Ms(5), "bridge on at %.3f ms", ToMs(moe_on));
+    CHECK(moe_off > STOP_AT && moe_off < STOP_AT + Ms(SOFT_MS + 20),
+          "bridge off at %.3f ms", ToMs(moe_off));
+    CHECK(idle_calls == 1 && idle_isr == 0 && idle_at >= moe_off && idle_at < moe_off + Ms(1),
+          "idle callback %d times, last at %.3f ms, ISR %u", idle_calls, ToMs(idle_at), idle_isr);
+
+    // CCR writes: TIM16 then TIM17 from the same ISR, one pair per sample
+    Tick     last = 0;
+    unsigned pairs = 0, late = 0;
+    uint32_t isr16 = 0;
+    for (const Write &w : Writes())
+    {
+        if (w.addr == CCR16 && w.isr)
+        {
+            isr16 = w.isr;
+            if (last && (w.t - last < SAMPLE - 480 || w.t - last > SAMPLE + 480))
+                late++;
+            last = w.t;
+        }
+        else if (w.addr == CCR17 && w.isr)
+        {
+            CHECK(w.isr == isr16, "TIM17 CCR1 from ISR %u, TIM16 from %u", w.isr, isr16);
+            pairs++;
+        }
+    }
+    double expect = ToMs(moe_off - moe_on) * 5.0;
+    CHECK(pairs > expect - 2 && pairs < expect + 2, "%u CCR pairs, %.0f samples", pairs, expect);
+    CHECK(late == 0, "%u CCR pairs off the 200 us grid", late);
+
+    // the legs stay aligned: every TIM17 update follows one of TIM16 within
+    // the few ticks between the two CEN writes
+    const Latch *l16 = nullptr;
+    unsigned apart = 0, latches = 0;
+    for (const Latch &l : Latches())
+    {
+        if (l.t <= moe_on || l.t >= moe_off)
+            continue;
+        if (l.timer == 16)
+        {
+            l16 = &l;
+            continue;
+        }
+        latches++;
+        if (!l16 || l.t - l16->t > 8 || l.arr != l16->arr)
+            apart++;
+    }
+    CHECK(latches > 1000, "%u TIM17 updates", latches);
+    CHECK(apart == 0, "%u TIM17 updates apart from TIM16", apart);
+
+    if (dither)
+    {
+        // every sample writes ARR and CCRs in one block; all of them latch
+        // together, each ISR's block at an update event of its own
+        const Latch *p16 = nullptr;
+        unsigned torn = 0, split = 0, lost = 0, last_isr = 0, wide = 0;
+        int      fast = (int)((48000000 + CARRIER_MAX_HZ / 2) / CARRIER_MAX_HZ) - 1;
+        for (const Latch &l : Latches())
+        {
+            if (l.t <= moe_on + Ms(10) || l.t >= STOP_AT)
+                continue;
+            if (l.arr_isr != l.ccr_isr)
+                torn++;
+            if (l.timer == 16)
+            {
+                if (last_isr && l.arr_isr > last_isr + 1)
+                    lost += l.arr_isr - last_isr - 1;
+                if (l.arr_isr != last_isr)
+                    last_isr = l.arr_isr;
+                if (l.t > FAST_AT + Ms(1) && abs((int)l.arr - fast) > (fast + 1) / 16)
+                    wide++;
+                p16 = &l;
+            }
+            else if (p16 && (l.arr_isr != p16->arr_isr || l.ccr1 != p16->ccr1))
+                split++;
+        }
+        CHECK(torn == 0, "%u updates with ARR and CCR from different ISRs", torn);
+        CHECK(split == 0, "%u TIM17 updates with another ISR's values than TIM16", split);
+        CHECK(lost == 0, "%u ISR periods overwritten before they latched", lost);
+        CHECK(wide == 0, "%u periods dithered past 1/8 of the %d Hz carrier", wide, CARRIER_MAX_HZ);
+    }
+
+    // stopped: counters off, outputs disabled, TIM6 off with the bridge (no
+    // mains tracking after reset, SYNC_DEFAULT_ON)
+    TimerOut t16 = Timer(16);
+    CHECK(!t16.running && !(t16.bdtr & TIM_BDTR_MOE), "TIM16 still running");
+    CHECK(!Timer(6).running, "TIM6 still running");
+    CHECK(IsrCount() < expect + 2, "%u TIM6 ISRs, %.0f samples", IsrCount(), expect);
+
+    return Check_Result();
+}
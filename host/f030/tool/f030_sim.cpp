@@ -0,0 +1,289 @@
+// Runs the F030 firmware on the host against the power stage model.
+//
+//   f030_sim [options]
+//
+// The modulation is the firmware's own (main() as shipped, SineGen in the
+// TIM6 ISR, the main-loop polls); the plant feeds ADC_U_OUT, ADC_BAT_LOAD
+// and ADC_BAT_V back, so the DC trim, repetitive controller, ramp current
+// limit, load search and dead-time compensation all run closed loop.
+// With --replay the plant is driven from a pwmlog capture instead.
+//
+// Prints the steady-state figures of the last 100 ms and the SineGen state
+// changes. Tools/plant_sim.py is the front end; see --help.
+
+#include "board.h"
+#include "plant.h"
+
+#include "stm32f0xx.h"
+#include "sinegen.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace host;
+
+namespace {
+
+const char *const STATE_NAMES[] = { "idle", "up", "run", "down", "search", "probe" };
+
+const double REPLAY_TAIL_MS = 20.0;     // run on after the last capture event
+
+void Usage()
+{
+    fputs("usage: f030_sim [options]\n"
+          "  run:      --ms N  --stop-ms N  --step N (plant step, ticks)  --isr-step N\n"
+          "  firmware: --curve linear|s|s5  --ramp-ms N  --i-limit N  --dtcomp 0|1  --rc 0|1\n"
+          "            --search IDLE_MS:EVERY_MS  --carrier HZ  --dither SPAN\n"
+          "  plant:    --load SPEC  --vbat V  --n RATIO  --load-from MS  --u-gain V/V\n"
+          "            --u-offset V  --mains PEAK_CODES[:HZ]\n"
+          "  output:   --adc FILE  --wave FILE  --wave-us US  --pwmlog FILE  --trace FILE\n"
+          "  instead of the firmware: --replay CAPTURE\n",
+          stderr);
+    exit(2);
+}
+
+bool Save(const char *path, const std::string &text)
+{
+    FILE *f = fopen(path, "w");
+    if (!f)
+    {
+        perror(path);
+        return false;
+    }
+    fputs(text.c_str(), f);
+    fclose(f);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options     o;
+    PlantParams pp;
+    unsigned    step = 48;
+    double      stop_ms = -1, wave_us = 5.0;
+    int         curve = -1, dtcomp = -1, rc = -1;
+    double      ramp_ms = SOFT_MS, i_limit = RAMP_I_LIMIT;
+    long        search_idle = -1, search_every = 0, carrier = 0, dither = 0;
+    const char *adc_path = nullptr, *wave_path = nullptr, *pwmlog_path = nullptr;
+    const char *trace_path = nullptr, *replay_path = nullptr;
+    std::string load = "r:10";
+
+    o.end = Ms(1500);
+    for (int i = 1; i < argc; i++)
+    {
+        std::string a = argv[i];
+        if (a == "--help" || i + 1 >= argc)
+            Usage();
+        const char *v = argv[++i];
+        if (a == "--ms")
+            o.end = Ms(atof(v));
+        else if (a == "--stop-ms")
+            stop_ms = atof(v);
+        else if (a == "--step")
+            step = (unsigned)atoi(v);
+        else if (a == "--isr-step")
+            o.step_ticks = (unsigned)atoi(v);
+        else if (a == "--curve")
+            curve = !strcmp(v, "linear") ? SINE_RAMP_LINEAR
+                  : !strcmp(v, "s5")     ? SINE_RAMP_SCURVE5
+                                         : SINE_RAMP_SCURVE;
+        else if (a == "--ramp-ms")
+            ramp_ms = atof(v);
+        else if (a == "--i-limit")
+            i_limit = atof(v);
+        else if (a == "--dtcomp")
+            dtcomp = atoi(v);
+        else if (a == "--rc")
+            rc = atoi(v);
+        else if (a == "--search")
+        {
+            if (sscanf(v, "%ld:%ld", &search_idle, &search_every) != 2)
+                Usage();
+        }
+        else if (a == "--carrier")
+            carrier = atol(v);
+        else if (a == "--dither")
+            dither = atol(v);
+        else if (a == "--load")
+            load = v;
+        else if (a == "--vbat")
+            pp.vbat = atof(v);
+        else if (a == "--n")
+            pp.n = atof(v);
+        else if (a == "--load-from")
+            pp.load_from = atof(v) / 1000.0;
+        else if (a == "--u-gain")
+            pp.u_gain = atof(v);
+        else if (a == "--u-offset")
+            pp.u_offset = atof(v);
+        else if (a == "--mains")
+        {
+            if (sscanf(v, "%lf:%lf", &pp.mains_peak, &pp.mains_hz) < 1)
+                Usage();
+        }
+        else if (a == "--adc")
+            adc_path = v;
+        else if (a == "--wave")
+            wave_path = v;
+        else if (a == "--wave-us")
+            wave_us = atof(v);
+        else if (a == "--pwmlog")
+            pwmlog_path = v;
+        else if (a == "--trace")
+            trace_path = v;
+        else if (a == "--replay")
+            replay_path = v;
+        else
+            Usage();
+    }
+    if (!ParseLoad(load, pp))
+    {
+        fprintf(stderr, "unknown load '%s' (r, rl, rect, lamp, open)\n", load.c_str());
+        return 2;
+    }
+
+    Replay replay;
+    Plant  plant(pp, replay_path ? TimerSource([&](int n) { return replay.Timer(n); }) : TimerSource(Timer),
+                 step);
+    if (wave_path)
+        plant.WaveEvery(Us(wave_us));
+
+    Tick end, tail = 0;
+    if (replay_path)
+    {
+        std::ifstream     f(replay_path);
+        std::stringstream ss;
+        ss << f.rdbuf();
+        std::string err;
+        if (!f || !replay.Load(ss.str(), REPLAY_TAIL_MS, err))
+        {
+            fprintf(stderr, "%s: %s\n", replay_path, f ? err.c_str() : strerror(errno));
+            return 1;
+        }
+        replay.Run(plant);
+        end  = replay.End();
+        tail = Ms(REPLAY_TAIL_MS);
+    }
+    else
+    {
+        plant.StateHook([] { return (int)SineGen_GetState(); });
+        o.analog = &plant;
+
+        // ramp and controller settings hold from the start (SineGen_Start()
+        // runs ~3 ms in); the carrier is set on the running bridge
+        At(0, [=] {
+            if (curve >= 0 || ramp_ms != SOFT_MS || i_limit != RAMP_I_LIMIT)
+                SineGen_SetRamp((SineRamp_t)(curve >= 0 ? curve : RAMP_DEFAULT_CURVE), (uint16_t)ramp_ms,
+                                (uint16_t)i_limit);
+            if (dtcomp >= 0)
+                SineGen_SetDtComp((uint8_t)dtcomp);
+            if (rc >= 0)
+                SineGen_SetRepetitive((uint8_t)rc);
+            if (search_idle >= 0)
+                SineGen_SetSearch((uint32_t)search_idle, (uint32_t)search_every);
+        });
+        if (carrier || dither)
+            At(Ms(5), [=] {
+                if (carrier && Bridge_SetCarrier((uint32_t)carrier) != 0)
+                    fprintf(stderr, "carrier %ld Hz out of range\n", carrier);
+                if (dither)
+                    Bridge_SetDither((uint16_t)dither);
+            });
+        if (stop_ms >= 0)
+            At(Ms(stop_ms), [] { SineGen_Stop(); });
+        Run(o);
+        end = Now();
+    }
+
+    if (adc_path)
+    {
+        std::string out = "t_s,v_out,i_l,i_bat,adc_u_out,adc_bat_load,ccr16,ccr17,bridge,state\n";
+        char line[160];
+        for (const Plant::Sample &s : plant.samples)
+        {
+            snprintf(line, sizeof(line), "%.6f,%.3f,%.3f,%.3f,%u,%u,%u,%u,%d,%d\n", s.t, s.v_out, s.i_l,
+                     s.i_bat, s.adc_u, s.adc_i, s.ccr16, s.ccr17, s.bridge, s.state);
+            out += line;
+        }
+        if (!Save(adc_path, out))
+            return 1;
+    }
+    if (wave_path)
+    {
+        std::string out = "t_s,v_out,i_l\n";
+        char line[80];
+        for (const Plant::WavePoint &w : plant.wave)
+        {
+            snprintf(line, sizeof(line), "%.7f,%.3f,%.3f\n", w.t, w.v_out, w.i_l);
+            out += line;
+        }
+        if (!Save(wave_path, out))
+            return 1;
+    }
+    if (pwmlog_path && !replay_path && !Save(pwmlog_path, Pwmlog()))
+        return 1;
+    if (trace_path && !replay_path)
+    {
+        std::string out;
+        char line[96];
+        for (const Write &w : Writes())
+        {
+            std::string name = RegName(w.addr);
+            snprintf(line, sizeof(line), "%llu,%s,0x%08x,%u\n", (unsigned long long)w.t,
+                     name.empty() ? "?" : name.c_str(), w.value, w.isr);
+            out += line;
+        }
+        if (!Save(trace_path, out))
+            return 1;
+    }
+
+    // last 100 ms (or whatever ran) as the steady-state window, up to the end
+    // of the capture when replaying one
+    double  t_end = ToMs(end - tail) / 1000.0;
+    Metrics m     = SteadyState(plant, std::max(0.0, t_end - 0.1), t_end);
+    printf("%zu samples, %.1f ms simulated, load %s, Vbat %.2f V\n", plant.samples.size(), ToMs(end),
+           load.c_str(), pp.vbat);
+    if (m.valid)
+    {
+        printf("  %-10s %.3f\n", "v_out_rms", m.v_out_rms);
+        printf("  %-10s %.3f\n", "v_out_dc", m.v_out_dc);
+        printf("  %-10s %.3f\n", "v_out_pk", m.v_out_pk);
+        printf("  %-10s %.3f\n", "i_l_pk", m.i_l_pk);
+        printf("  %-10s %.3f\n", "i_bat_avg", m.i_bat_avg);
+        printf("  %-10s %.3f\n", "v_dc", m.v_dc);
+        printf("  %-10s %.3f\n", "eff", m.eff);
+    }
+    if (!plant.samples.empty())
+    {
+        printf("  %-10s %.3f\n", "e_in", plant.samples.back().e_in);
+        printf("  %-10s %.3f\n", "e_out", plant.samples.back().e_out);
+    }
+    if (!replay_path)
+    {
+        printf("  %-10s %ld\n", "dc_trim", (long)SineGen_GetDcTrim());
+        printf("  %-10s %u\n", "dc_trim_off", SineGen_DcTrimFailed());
+    }
+
+    // SineGen state changes, at the ADC scans
+    int         last = -2;
+    std::string states;
+    char        item[32];
+    for (const Plant::Sample &s : plant.samples)
+    {
+        if (s.state == last || s.state < 0 || s.state > 5)
+            continue;
+        last = s.state;
+        snprintf(item, sizeof(item), "%s%.4f %s", states.empty() ? "" : ", ", s.t, STATE_NAMES[s.state]);
+        states += item;
+    }
+    if (!states.empty())
+        printf("  states: %s\n", states.c_str());
+    return 0;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file core_cm4.h
+ * @brief Host stand-in for the Cortex-M4 core header.
+ *
+ * Found ahead of Drivers/CMSIS/Include on the host include path. As for the
+ * F030 (host/f030/shim/core_cm0.h) the Arm intrinsics of cmsis_gcc.h are
+ * skipped and the compiler macros supplied instead. The F40G tests run
+ * single driver functions without interrupts, so the interrupt mask is a
+ * plain variable here.
+ */
+
+#ifndef HOST_CORE_CM4_H
+#define HOST_CORE_CM4_H
+
+#include <stdint.h>
+
+#define __CMSIS_GCC_H
+
+#define __ASM                       __asm
+#define __INLINE                    inline
+#define __STATIC_INLINE             static inline
+#define __STATIC_FORCEINLINE        __attribute__((always_inline)) static inline
+#define __NO_RETURN                 __attribute__((__noreturn__))
+#define __USED                      __attribute__((used))
+#define __WEAK                      __attribute__((weak))
+#define __PACKED                    __attribute__((packed, aligned(1)))
+#define __PACKED_STRUCT             struct __attribute__((packed, aligned(1)))
+#define __PACKED_UNION              union __attribute__((packed, aligned(1)))
+#define __ALIGNED(x)                __attribute__((aligned(x)))
+#define __RESTRICT                  __restrict
+#define __COMPILER_BARRIER()        __asm volatile("" ::: "memory")
+
+#define __UNALIGNED_UINT16_READ(addr)       (*(const uint16_t *)(const void *)(addr))
+#define __UNALIGNED_UINT16_WRITE(addr, val) (void)(*(uint16_t *)(void *)(addr) = (val))
+#define __UNALIGNED_UINT32_READ(addr)       (*(const uint32_t *)(const void *)(addr))
+#define __UNALIGNED_UINT32_WRITE(addr, val) (void)(*(uint32_t *)(void *)(addr) = (val))
+
+static uint32_t host_primask;
+
+__STATIC_FORCEINLINE void __enable_irq(void)            { host_primask = 0; }
+__STATIC_FORCEINLINE void __disable_irq(void)           { host_primask = 1; }
+__STATIC_FORCEINLINE uint32_t __get_PRIMASK(void)       { return host_primask; }
+__STATIC_FORCEINLINE void __set_PRIMASK(uint32_t mask)  { host_primask = mask & 1; }
+
+#define __NOP()                     __COMPILER_BARRIER()
+#define __WFI()                     __COMPILER_BARRIER()
+#define __WFE()                     __COMPILER_BARRIER()
+#define __SEV()                     ((void)0)
+#define __ISB()                     __COMPILER_BARRIER()
+#define __DSB()                     __COMPILER_BARRIER()
+#define __DMB()                     __COMPILER_BARRIER()
+#define __BKPT(value)               __builtin_trap()
+#define __REV(x)                    __builtin_bswap32(x)
+#define __REV16(x)                  ((uint32_t)(((x) & 0xFF00FF00u) >> 8 | ((x) & 0x00FF00FFu) << 8))
+#define __REVSH(x)                  ((int16_t)__builtin_bswap16((uint16_t)(x)))
+#define __CLZ(x)                    ((uint8_t)((x) ? __builtin_clz(x) : 32))
+
+#include_next <core_cm4.h>
+
+#endif // HOST_CORE_CM4_H
@@ -0,0 +1,251 @@
+// DrawChar of the eval LCD driver on a mocked FSMC bus. The LCD_IO layer
+// (stm324xg_eval.c) is replaced by a bus that counts every FSMC write and
+// feeds an ILI9325 model: index register, GRAM address counter with the
+// entry mode and window of R03h/R50h..R53h, 240x320 GRAM. Checks, per font:
+// the windowed path draws the glyph exactly (against the raw font tables),
+// touches nothing outside its cell, restores the full-screen window and
+// takes 21 + width * height writes instead of 6 per pixel; glyphs crossing
+// the right or bottom edge fall back to the per-pixel path.
+
+#include "check.h"
+
+#include "stm324xg_eval_lcd.h"
+
+#include <cstring>
+#include <initializer_list>
+
+// reference bitmaps: the raw tables fontpack.py packs (no Packed member)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmissing-field-initializers"
+namespace raw {
+#include "font24.c"
+#include "font20.c"
+#include "font16.c"
+#include "font12.c"
+#include "font8.c"
+} // namespace raw
+#pragma GCC diagnostic pop
+
+namespace {
+
+const int      W = ILI9325_LCD_PIXEL_WIDTH;     // 320, screen X (GRAM vertical address)
+const int      H = ILI9325_LCD_PIXEL_HEIGHT;    // 240, screen Y (GRAM horizontal address)
+const uint16_t BLANK = 0x1234;
+const uint16_t FG = LCD_COLOR_RED, BG = LCD_COLOR_BLUE;
+
+struct Ili9325 {
+    uint16_t reg[256];
+    uint16_t gram[H][W];
+    uint8_t  index;
+    int      h, v;                  // GRAM address counter
+    unsigned offscreen;             // GRAM writes to an address past the panel
+
+    void Data(uint16_t d)
+    {
+        if (index != LCD_REG_34)
+        {
+            reg[index] = d;
+            if (index == LCD_REG_32)
+                h = d;
+            else if (index == LCD_REG_33)
+                v = d;
+            return;
+        }
+        if (h >= 0 && h < H && v >= 0 && v < W)
+            gram[h][v] = d;
+        else
+            offscreen++;
+        Step();
+    }
+
+    // Address update after a GRAM write (R03h AM, I/D), wrapping in the window
+    void Step()
+    {
+        uint16_t em = reg[LCD_REG_3];
+        bool     am = em & 0x08, id0 = em & 0x10, id1 = em & 0x20;
+        int      hs = reg[LCD_REG_80], he = reg[LCD_REG_81];
+        int      vs = reg[LCD_REG_82], ve = reg[LCD_REG_83];
+        if (am)
+        {
+            v += id1 ? 1 : -1;
+            if (v < vs || v > ve)
+            {
+                v = id1 ? vs : ve;
+                h += id0 ? 1 : -1;
+                if (h < hs || h > he)
+                    h = id0 ? hs : he;
+            }
+        }
+        else
+        {
+            h += id0 ? 1 : -1;
+            if (h < hs || h > he)
+            {
+                h = id0 ? hs : he;
+                v += id1 ? 1 : -1;
+                if (v < vs || v > ve)
+                    v = id1 ? vs : ve;
+            }
+        }
+    }
+
+    uint16_t Pixel(int x, int y) const { return gram[y][W - 1 - x]; }
+};
+
+Ili9325  lcd;
+unsigned bus_writes;                // FSMC write cycles, register index and data
+
+void Clear()
+{
+    for (auto &row : lcd.gram)
+        for (uint16_t &p : row)
+            p = BLANK;
+    lcd.offscreen = 0;
+    bus_writes    = 0;
+}
+
+bool FullWindow()
+{
+    return lcd.reg[LCD_REG_80] == 0 && lcd.reg[LCD_REG_81] == H - 1 && lcd.reg[LCD_REG_82] == 0 &&
+           lcd.reg[LCD_REG_83] == W - 1;
+}
+
+// Pixel (col, row) of a glyph in a raw font
+bool RawBit(const sFONT &f, char ch, int col, int row)
+{
+    int bytes = (f.Width + 7) / 8;
+    const uint8_t *p = f.table + ((ch - ' ') * f.Height + row) * bytes;
+    return p[col / 8] & (0x80 >> (col % 8));
+}
+
+// Draws ch at (x, y) and compares the panel with the raw glyph; returns the
+// number of pixels that differ, inside the cell and on the screen, plus
+// the pixels changed outside the cell
+int Draw(sFONT &font, const sFONT &ref, char ch, int x, int y)
+{
+    Clear();
+    BSP_LCD_SetFont(&font);
+    BSP_LCD_DisplayChar(x, y, ch);
+
+    int bad = 0;
+    for (int py = 0; py < H; py++)
+        for (int px = 0; px < W; px++)
+        {
+            int  col = px - x, row = py - y;
+            bool in  = col >= 0 && col < ref.Width && row >= 0 && row < ref.Height;
+            uint16_t want = !in ? BLANK : RawBit(ref, ch, col, row) ? FG : BG;
+            if (lcd.Pixel(px, py) != want)
+                bad++;
+        }
+    return bad;
+}
+
+} // namespace
+
+// --- LCD_IO on the mocked FSMC bus (stm324xg_eval.c on the board) ------------
+
+extern "C" {
+
+void LCD_IO_Init(void)
+{
+}
+
+void LCD_IO_WriteReg(uint8_t Reg)
+{
+    bus_writes++;
+    lcd.index = Reg;
+}
+
+void LCD_IO_WriteMultipleData(uint8_t *pData, uint32_t Size)
+{
+    uint16_t word;
+    for (uint32_t i = 0; i + 1 < Size; i += 2)
+    {
+        memcpy(&word, pData + i, 2);
+        bus_writes++;
+        lcd.Data(word);
+    }
+}
+
+void LCD_IO_FillData(uint16_t Data, uint32_t Count)
+{
+    while (Count--)
+    {
+        bus_writes++;
+        lcd.Data(Data);
+    }
+}
+
+uint16_t LCD_IO_ReadData(uint16_t Reg)
+{
+    bus_writes++;
+    lcd.index = (uint8_t)Reg;
+    if (Reg == 0x00)
+        return ILI9325_ID;
+    if (Reg == LCD_REG_34)
+        return lcd.gram[lcd.h][lcd.v];
+    return lcd.reg[Reg & 0xFF];
+}
+
+void LCD_Delay(uint32_t delay)
+{
+    (void)delay;
+}
+
+} // extern "C"
+
+int main()
+{
+    CHECK(BSP_LCD_Init() == LCD_OK, "ILI9325 not found");
+    BSP_LCD_SetTextColor(FG);
+    BSP_LCD_SetBackColor(BG);
+
+    struct {
+        sFONT      *font;
+        const sFONT *ref;
+        const char *name;
+    } fonts[] = {
+        { &Font24, &raw::Font24, "Font24" }, { &Font20, &raw::Font20, "Font20" },
+        { &Font16, &raw::Font16, "Font16" }, { &Font12, &raw::Font12, "Font12" },
+        { &Font8, &raw::Font8, "Font8" },
+    };
+
+    for (const auto &f : fonts)
+    {
+        unsigned pixels = f.ref->Width * f.ref->Height;
+        CHECK(f.font->Width == f.ref->Width && f.font->Height == f.ref->Height, "%s: cell size", f.name);
+
+        // windowed path: one window, cursor and GRAM index, then the cell
+        for (char ch : { 'A', 'g', '@', '~', ' ' })
+        {
+            int bad = Draw(*f.font, *f.ref, ch, 100, 50);
+            CHECK(bad == 0, "%s '%c': %d pixel(s) wrong", f.name, ch, bad);
+            CHECK(bus_writes == 21 + pixels, "%s '%c': %u bus writes, expected %u", f.name, ch, bus_writes,
+                  21 + pixels);
+            CHECK(FullWindow(), "%s '%c': window not restored", f.name, ch);
+        }
+        printf("%-7s %2ux%-2u  %4u per-pixel -> %3u windowed writes\n", f.name, f.ref->Width, f.ref->Height,
+               6 * pixels, bus_writes);
+
+        // last whole cell on the screen still takes the windowed path
+        int bad = Draw(*f.font, *f.ref, 'M', W - f.ref->Width, H - f.ref->Height);
+        CHECK(bad == 0 && bus_writes == 21 + pixels, "%s corner: %d wrong, %u writes", f.name, bad,
+              bus_writes);
+
+        // crossing the right edge, then the bottom edge: per-pixel fallback,
+        // the visible part drawn, the window left alone
+        struct {
+            int x, y;
+        } clipped[] = { { W - f.ref->Width / 2, 20 }, { 40, H - f.ref->Height / 2 } };
+        for (const auto &c : clipped)
+        {
+            int bad = Draw(*f.font, *f.ref, 'W', c.x, c.y);
+            CHECK(bad == 0, "%s clipped at (%d,%d): %d pixel(s) wrong", f.name, c.x, c.y, bad);
+            CHECK(bus_writes == 6 * pixels, "%s clipped at (%d,%d): %u bus writes, expected %u", f.name, c.x,
+                  c.y, bus_writes, 6 * pixels);
+            CHECK(lcd.offscreen > 0, "%s clipped at (%d,%d): nothing past the edge", f.name, c.x, c.y);
+            CHECK(FullWindow(), "%s clipped at (%d,%d): window changed", f.name, c.x, c.y);
+        }
+    }
+    return Check_Result();
+}